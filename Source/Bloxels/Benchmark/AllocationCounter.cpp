@@ -0,0 +1,108 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#include "AllocationCounter.h"
+
+#include "HAL/MemoryBase.h"
+
+namespace
+{
+	thread_local bool bCounting = false;
+	thread_local int64 ThreadAllocations = 0;
+
+	class FCountingMalloc final : public FMalloc
+	{
+	public:
+		explicit FCountingMalloc(FMalloc* InInner)
+			: Inner(InInner)
+		{
+		}
+
+		FMalloc* GetInner() const { return Inner; }
+
+		virtual void* Malloc(const SIZE_T Count, const uint32 Alignment) override
+		{
+			CountAllocation();
+			return Inner->Malloc(Count, Alignment);
+		}
+
+		virtual void* TryMalloc(const SIZE_T Count, const uint32 Alignment) override
+		{
+			CountAllocation();
+			return Inner->TryMalloc(Count, Alignment);
+		}
+
+		virtual void* Realloc(void* Original, const SIZE_T Count, const uint32 Alignment) override
+		{
+			CountAllocation();
+			return Inner->Realloc(Original, Count, Alignment);
+		}
+
+		virtual void* TryRealloc(void* Original, const SIZE_T Count, const uint32 Alignment) override
+		{
+			CountAllocation();
+			return Inner->TryRealloc(Original, Count, Alignment);
+		}
+
+		virtual void Free(void* Original) override { Inner->Free(Original); }
+		virtual SIZE_T QuantizeSize(const SIZE_T Count, const uint32 Alignment) override { return Inner->QuantizeSize(Count, Alignment); }
+		virtual bool GetAllocationSize(void* Original, SIZE_T& SizeOut) override { return Inner->GetAllocationSize(Original, SizeOut); }
+		virtual void Trim(const bool bTrimThreadCaches) override { Inner->Trim(bTrimThreadCaches); }
+		virtual void SetupTLSCachesOnCurrentThread() override { Inner->SetupTLSCachesOnCurrentThread(); }
+		virtual void ClearAndDisableTLSCachesOnCurrentThread() override { Inner->ClearAndDisableTLSCachesOnCurrentThread(); }
+		virtual bool IsInternallyThreadSafe() const override { return Inner->IsInternallyThreadSafe(); }
+		virtual bool ValidateHeap() override { return Inner->ValidateHeap(); }
+		virtual void UpdateStats() override { Inner->UpdateStats(); }
+		virtual void GetAllocatorStats(FGenericMemoryStats& OutStats) override { Inner->GetAllocatorStats(OutStats); }
+		virtual void DumpAllocatorStats(FOutputDevice& Ar) override { Inner->DumpAllocatorStats(Ar); }
+		virtual const TCHAR* GetDescriptiveName() override { return Inner->GetDescriptiveName(); }
+
+	private:
+		FMalloc* Inner;
+
+		static void CountAllocation()
+		{
+			if (bCounting) ++ThreadAllocations;
+		}
+	};
+
+	FCountingMalloc* Installed = nullptr;
+}
+
+namespace AllocationCounter
+{
+	void Install()
+	{
+		if (Installed) return;
+
+		// FMalloc allocates itself from the system heap, so the proxy never recurses into GMalloc
+		Installed = new FCountingMalloc(GMalloc);
+		GMalloc = Installed;
+	}
+
+	void Uninstall()
+	{
+		if (!Installed) return;
+
+		// Blocks handed out through the proxy belong to the inner allocator, so they stay valid. The proxy itself
+		// is leaked: another thread may have read GMalloc just before the swap and still be inside it.
+		GMalloc = Installed->GetInner();
+		Installed = nullptr;
+	}
+
+	bool IsInstalled()
+	{
+		return Installed != nullptr;
+	}
+
+	void Begin()
+	{
+		ThreadAllocations = 0;
+		bCounting = true;
+	}
+
+	int64 End()
+	{
+		bCounting = false;
+		return Installed ? ThreadAllocations : 0;
+	}
+}
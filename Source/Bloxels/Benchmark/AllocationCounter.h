@@ -0,0 +1,20 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Counts heap allocations made on one thread between Begin and End. Install puts a forwarding allocator in
+ * front of GMalloc until Uninstall; it is meant for benchmark commandlets, not for a running game.
+ */
+namespace AllocationCounter
+{
+	BLOXELS_API void Install();
+	BLOXELS_API void Uninstall();
+	BLOXELS_API bool IsInstalled();
+
+	// Calling thread only. End returns the allocations since Begin, or 0 when the counter isn't installed.
+	BLOXELS_API void Begin();
+	BLOXELS_API int64 End();
+}
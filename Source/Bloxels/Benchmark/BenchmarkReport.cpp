@@ -0,0 +1,51 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#include "BenchmarkReport.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace BenchmarkReport
+{
+	FString GetOutputPath(const FString& Params, const TCHAR* Name)
+	{
+		FString Output = FPaths::ProjectSavedDir() / TEXT("Benchmarks") / Name;
+		FParse::Value(*Params, TEXT("Output="), Output);
+		return Output;
+	}
+
+	bool SaveFile(const FString& Path, const FString& Contents)
+	{
+		IFileManager::Get().MakeDirectory(*FPaths::GetPath(Path), true);
+		return FFileHelper::SaveStringToFile(Contents, *Path);
+	}
+
+	double Percentile(TArray<double>& Samples, const double P)
+	{
+		if (Samples.Num() == 0) return 0.0;
+
+		Samples.Sort();
+		const int32 Rank = FMath::Clamp(FMath::CeilToInt32(P * Samples.Num()) - 1, 0, Samples.Num() - 1);
+		return Samples[Rank];
+	}
+
+	TArray<int32> ParseIntList(const FString& Params, const TCHAR* Match, const TArray<int32>& Default)
+	{
+		FString List;
+		if (!FParse::Value(*Params, Match, List, false)) return Default;
+
+		TArray<FString> Parts;
+		List.ParseIntoArray(Parts, TEXT(","));
+
+		TArray<int32> Values;
+		for (const FString& Part : Parts)
+		{
+			if (Part.IsNumeric())
+			{
+				Values.Add(FCString::Atoi(*Part));
+			}
+		}
+		return Values.Num() > 0 ? Values : Default;
+	}
+}
@@ -0,0 +1,21 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Output helpers shared by the benchmark commandlets. */
+namespace BenchmarkReport
+{
+	// <Saved>/Benchmarks/<Name>, without an extension; -Output= overrides it
+	BLOXELS_API FString GetOutputPath(const FString& Params, const TCHAR* Name);
+
+	// Creates the directory first
+	BLOXELS_API bool SaveFile(const FString& Path, const FString& Contents);
+
+	// Nearest-rank percentile of P in [0, 1]. Sorts Samples; 0 when empty.
+	BLOXELS_API double Percentile(TArray<double>& Samples, double P);
+
+	// Comma separated integers, for -Threads=1,2,4 style options
+	BLOXELS_API TArray<int32> ParseIntList(const FString& Params, const TCHAR* Match, const TArray<int32>& Default);
+}
@@ -0,0 +1,191 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#include "BloxelsGenBenchCommandlet.h"
+
+#include <atomic>
+
+#include "BenchmarkReport.h"
+#include "HeadlessVoxelWorld.h"
+#include "Bloxels/Voxel/Chunk/VoxelChunkAsync.h"
+#include "Bloxels/Voxel/World/WorldGenerationConfig.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/Thread.h"
+
+namespace
+{
+	constexpr double BytesPerMB = 1024.0 * 1024.0;
+
+	struct FGenRun
+	{
+		int32 Threads = 0;
+		double WallSeconds = 0.0;
+		TArray<double> ChunkMs;
+		FVoxelGenStageTimes Stages;
+		int64 PeakUsedDelta = 0;  // Highest working set seen during the run, over the working set before it
+	};
+
+	FGenRun RunGeneration(const FHeadlessVoxelWorld& World, const TArray<FIntVector>& Coords, const int32 Threads)
+	{
+		FGenRun Run;
+		Run.Threads = Threads;
+		Run.ChunkMs.SetNumZeroed(Coords.Num());
+
+		std::atomic<int32> Next{ 0 };
+		std::atomic<int32> Finished{ 0 };
+		TArray<FVoxelGenStageTimes> WorkerStages;
+		WorkerStages.SetNum(Threads);
+
+		// The process peak never comes down, so it would carry one run's memory into the next; sample this run instead
+		const int64 UsedBefore = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical);
+		int64 UsedPeak = UsedBefore;
+
+		const double StartTime = FPlatformTime::Seconds();
+
+		TArray<FThread> Workers;
+		Workers.Reserve(Threads);
+		for (int32 Worker = 0; Worker < Threads; ++Worker)
+		{
+			Workers.Emplace(TEXT("GenBenchWorker"), [&World, &Coords, &Next, &Finished, &Run, &WorkerStages, Worker]()
+			{
+				// Reused across chunks, like a pool worker would
+				TArray<uint16> VoxelData;
+				TArray<int32> SkyStart;
+				for (int32 Index = Next++; Index < Coords.Num(); Index = Next++)
+				{
+					const uint64 ChunkStart = FPlatformTime::Cycles64();
+					World.GenerateChunk(Coords[Index], VoxelData, SkyStart, &WorkerStages[Worker]);
+					Run.ChunkMs[Index] = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - ChunkStart);
+				}
+				++Finished;
+			});
+		}
+
+		while (Finished.load() < Threads)
+		{
+			UsedPeak = FMath::Max(UsedPeak, static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical));
+			FPlatformProcess::Sleep(0.005f);
+		}
+
+		for (FThread& Worker : Workers)
+		{
+			Worker.Join();
+		}
+
+		Run.WallSeconds = FPlatformTime::Seconds() - StartTime;
+		UsedPeak = FMath::Max(UsedPeak, static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical));
+		Run.PeakUsedDelta = UsedPeak - UsedBefore;
+
+		for (const FVoxelGenStageTimes& Stages : WorkerStages)
+		{
+			Run.Stages.Biome += Stages.Biome;
+			Run.Stages.Height += Stages.Height;
+			Run.Stages.Caves += Stages.Caves;
+			Run.Stages.IDs += Stages.IDs;
+		}
+		return Run;
+	}
+}
+
+UBloxelsGenBenchCommandlet::UBloxelsGenBenchCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UBloxelsGenBenchCommandlet::Main(const FString& Params)
+{
+	FHeadlessVoxelWorld World;
+	if (!World.InitializeFromCommandLine(Params)) return 1;
+
+	const UWorldGenerationConfig* Config = World.GetConfig();
+	const int32 ChunkSize = World.GetChunkSize();
+
+	int32 OriginX = 0;
+	int32 OriginY = 0;
+	int32 Radius = 4;
+	int32 MinZ = 0;
+	int32 MaxZ = FMath::DivideAndRoundUp(Config->SurfaceMaxHeight + 1, ChunkSize) - 1;
+	int32 Count = 0;
+	FParse::Value(*Params, TEXT("OriginX="), OriginX);
+	FParse::Value(*Params, TEXT("OriginY="), OriginY);
+	FParse::Value(*Params, TEXT("Radius="), Radius);
+	FParse::Value(*Params, TEXT("MinZ="), MinZ);
+	FParse::Value(*Params, TEXT("MaxZ="), MaxZ);
+	FParse::Value(*Params, TEXT("Count="), Count);
+	Radius = FMath::Max(0, Radius);
+
+	const TArray<int32> ThreadCounts = BenchmarkReport::ParseIntList(Params, TEXT("Threads="),
+		{ 1, 2, 4, FPlatformMisc::NumberOfCoresIncludingHyperthreads() });
+
+	// Nearest columns first, so -Count keeps a compact patch around the origin
+	TArray<FIntVector> Coords;
+	for (int32 Z = MinZ; Z <= MaxZ; ++Z)
+	{
+		for (int32 Y = OriginY - Radius; Y <= OriginY + Radius; ++Y)
+		{
+			for (int32 X = OriginX - Radius; X <= OriginX + Radius; ++X)
+			{
+				Coords.Add(FIntVector(X, Y, Z));
+			}
+		}
+	}
+	const FIntVector Origin(OriginX, OriginY, 0);
+	Coords.StableSort([&Origin](const FIntVector& A, const FIntVector& B)
+	{
+		const FIntVector DA = A - Origin;
+		const FIntVector DB = B - Origin;
+		return DA.X * DA.X + DA.Y * DA.Y < DB.X * DB.X + DB.Y * DB.Y;
+	});
+	if (Count > 0 && Count < Coords.Num())
+	{
+		Coords.SetNum(Count);
+	}
+
+	if (Coords.Num() == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("GenBench: Region is empty."));
+		return 1;
+	}
+
+	const uint64 BaselineUsed = FPlatformMemory::GetStats().UsedPhysical;
+	UE_LOG(LogTemp, Display, TEXT("GenBench: %d chunks of %d^3 around (%d, %d), layers %d..%d, %.1f MB in use before generating."),
+		Coords.Num(), ChunkSize, OriginX, OriginY, MinZ, MaxZ, BaselineUsed / BytesPerMB);
+
+	// Untimed pass so lazily built noise and data table state doesn't land on the first run
+	RunGeneration(World, TArray<FIntVector>(Coords.GetData(), FMath::Min(Coords.Num(), 8)), 1);
+
+	FString Csv = TEXT("threads,chunks,seconds,chunks_per_sec,p50_ms,p99_ms,biome_s,height_s,caves_s,ids_s,peak_delta_mb\n");
+	for (const int32 Threads : ThreadCounts)
+	{
+		if (Threads < 1) continue;
+
+		FGenRun Run = RunGeneration(World, Coords, Threads);
+
+		const double ChunksPerSecond = Run.WallSeconds > 0.0 ? Coords.Num() / Run.WallSeconds : 0.0;
+		const double P50 = BenchmarkReport::Percentile(Run.ChunkMs, 0.5);
+		const double P99 = BenchmarkReport::Percentile(Run.ChunkMs, 0.99);
+		const FVoxelGenStageTimes& Stages = Run.Stages;
+		const double StageTotal = FMath::Max(Stages.Biome + Stages.Height + Stages.Caves + Stages.IDs, UE_DOUBLE_SMALL_NUMBER);
+
+		UE_LOG(LogTemp, Display, TEXT("GenBench: %2d threads, %.2f s, %.1f chunks/s, p50 %.2f ms, p99 %.2f ms | biome %.0f%%, height %.0f%%, caves %.0f%%, ids %.0f%% | peak +%.1f MB"),
+			Threads, Run.WallSeconds, ChunksPerSecond, P50, P99,
+			100.0 * Stages.Biome / StageTotal, 100.0 * Stages.Height / StageTotal, 100.0 * Stages.Caves / StageTotal, 100.0 * Stages.IDs / StageTotal,
+			Run.PeakUsedDelta / BytesPerMB);
+
+		Csv += FString::Printf(TEXT("%d,%d,%.4f,%.2f,%.4f,%.4f,%.4f,%.4f,%.4f,%.4f,%.1f\n"),
+			Threads, Coords.Num(), Run.WallSeconds, ChunksPerSecond, P50, P99,
+			Stages.Biome, Stages.Height, Stages.Caves, Stages.IDs, Run.PeakUsedDelta / BytesPerMB);
+	}
+
+	const FString CsvPath = BenchmarkReport::GetOutputPath(Params, TEXT("GenBench")) + TEXT(".csv");
+	if (!BenchmarkReport::SaveFile(CsvPath, Csv))
+	{
+		UE_LOG(LogTemp, Error, TEXT("GenBench: Could not write %s."), *CsvPath);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("GenBench: Results written to %s."), *CsvPath);
+	return 0;
+}
@@ -0,0 +1,28 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "BloxelsGenBenchCommandlet.generated.h"
+
+/**
+ * World generation throughput with no map and nothing rendered:
+ *
+ *   UnrealEditor-Cmd Bloxels -run=BloxelsGenBench -nullrhi [-Config=<asset>] [-Seed=N] [-OriginX=0] [-OriginY=0]
+ *       [-Radius=4] [-MinZ=0] [-MaxZ=<top of the surface>] [-Count=N] [-Threads=1,2,4,8] [-Output=<path>]
+ *
+ * Generates the same chunks once per thread count, each worker pulling the next chunk from a shared counter.
+ * Reports chunks/sec, p50/p99 per-chunk time, time per generation stage and peak memory, and writes one CSV
+ * row per thread count.
+ */
+UCLASS()
+class BLOXELS_API UBloxelsGenBenchCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UBloxelsGenBenchCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
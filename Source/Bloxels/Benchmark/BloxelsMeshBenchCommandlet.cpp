@@ -0,0 +1,162 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#include "BloxelsMeshBenchCommandlet.h"
+
+#include "AllocationCounter.h"
+#include "BenchmarkReport.h"
+#include "HeadlessVoxelWorld.h"
+#include "MeshCorpus.h"
+#include "Bloxels/Voxel/Lighting/VoxelLightEngine.h"
+
+namespace
+{
+	struct FMeshRow
+	{
+		FString Name;
+		int32 Quads = 0;
+		int32 Vertices = 0;
+		double MinMs = 0.0;
+		double AvgMs = 0.0;
+		int64 Allocations = 0;  // Last iteration
+		uint64 Hash = 0;
+		FString Golden;  // "match", "mismatch", "missing" or "recorded"
+	};
+}
+
+UBloxelsMeshBenchCommandlet::UBloxelsMeshBenchCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UBloxelsMeshBenchCommandlet::Main(const FString& Params)
+{
+	FHeadlessVoxelWorld World;
+	if (!World.InitializeFromCommandLine(Params)) return 1;
+
+	int32 Iterations = 5;
+	FString GoldenPath = MeshCorpus::GetDefaultGoldenPath();
+	FParse::Value(*Params, TEXT("Iterations="), Iterations);
+	FParse::Value(*Params, TEXT("Golden="), GoldenPath);
+	const bool bUpdateGolden = FParse::Param(*Params, TEXT("UpdateGolden"));
+	Iterations = FMath::Max(1, Iterations);
+
+	const int32 ChunkSize = World.GetChunkSize();
+	const int32 SectionSize = MeshCorpus::GetSectionSize(World);
+	const FVoxelMeshContext Context = MeshCorpus::MakeContext(World);
+
+	TArray<MeshCorpus::FMeshCase> Cases;
+	MeshCorpus::BuildCorpus(World, Cases);
+
+	TArray<uint8> LightData;
+	LightData.Init(VoxelLight::UnloadedLight, ChunkSize * ChunkSize * ChunkSize);
+
+	TMap<FString, uint64> Golden;
+	if (!bUpdateGolden && !MeshCorpus::LoadGolden(GoldenPath, Golden))
+	{
+		UE_LOG(LogTemp, Error, TEXT("MeshBench: Could not read golden hashes from %s, run with -UpdateGolden to record them."), *GoldenPath);
+		return 1;
+	}
+
+	AllocationCounter::Install();
+
+	TArray<FMeshRow> Rows;
+	TArray<FSectionMeshData> Sections;
+	int32 Mismatches = 0;
+	int32 Missing = 0;
+	for (const MeshCorpus::FMeshCase& Case : Cases)
+	{
+		FMeshRow& Row = Rows.AddDefaulted_GetRef();
+		Row.Name = Case.Name;
+
+		double SumMs = 0.0;
+		Row.MinMs = TNumericLimits<double>::Max();
+		for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+		{
+			const uint64 StartCycles = FPlatformTime::Cycles64();
+			AllocationCounter::Begin();
+			MeshCorpus::MeshChunk(Context, Case.VoxelData, LightData, SectionSize, Sections);
+			Row.Allocations = AllocationCounter::End();
+			const double Ms = FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles);
+
+			SumMs += Ms;
+			Row.MinMs = FMath::Min(Row.MinMs, Ms);
+		}
+		Row.AvgMs = SumMs / Iterations;
+
+		for (const FSectionMeshData& Section : Sections)
+		{
+			for (const TPair<FMeshSectionKey, FMeshData>& Pair : Section.MeshSections)
+			{
+				Row.Vertices += Pair.Value.Vertices.Num();
+			}
+		}
+		Row.Quads = Row.Vertices / 4;
+		Row.Hash = MeshCorpus::HashSections(Sections);
+
+		if (const uint64* Expected = Golden.Find(Row.Name))
+		{
+			Row.Golden = *Expected == Row.Hash ? TEXT("match") : TEXT("mismatch");
+			if (*Expected != Row.Hash)
+			{
+				++Mismatches;
+				UE_LOG(LogTemp, Error, TEXT("MeshBench: %s hashes to %016llx, golden is %016llx."), *Row.Name, Row.Hash, *Expected);
+			}
+		}
+		else if (bUpdateGolden)
+		{
+			Row.Golden = TEXT("recorded");
+		}
+		else
+		{
+			Row.Golden = TEXT("missing");
+			++Missing;
+			UE_LOG(LogTemp, Error, TEXT("MeshBench: %s has no golden hash."), *Row.Name);
+		}
+
+		UE_LOG(LogTemp, Display, TEXT("MeshBench: %-24s %6d quads, %7d vertices, min %.3f ms, avg %.3f ms, %lld allocations, %016llx %s"),
+			*Row.Name, Row.Quads, Row.Vertices, Row.MinMs, Row.AvgMs, Row.Allocations, Row.Hash, *Row.Golden);
+	}
+
+	AllocationCounter::Uninstall();
+
+	FString Csv = TEXT("case,quads,vertices,min_ms,avg_ms,allocations,hash,golden\n");
+	for (const FMeshRow& Row : Rows)
+	{
+		Csv += FString::Printf(TEXT("%s,%d,%d,%.4f,%.4f,%lld,%016llx,%s\n"),
+			*Row.Name, Row.Quads, Row.Vertices, Row.MinMs, Row.AvgMs, Row.Allocations, Row.Hash, *Row.Golden);
+	}
+
+	const FString CsvPath = BenchmarkReport::GetOutputPath(Params, TEXT("MeshBench")) + TEXT(".csv");
+	if (!BenchmarkReport::SaveFile(CsvPath, Csv))
+	{
+		UE_LOG(LogTemp, Error, TEXT("MeshBench: Could not write %s."), *CsvPath);
+		return 1;
+	}
+	UE_LOG(LogTemp, Display, TEXT("MeshBench: Results written to %s."), *CsvPath);
+
+	if (bUpdateGolden)
+	{
+		FString GoldenCsv = TEXT("# Mesh hashes from -run=BloxelsMeshBench -UpdateGolden, default config and seed\n");
+		for (const FMeshRow& Row : Rows)
+		{
+			GoldenCsv += FString::Printf(TEXT("%s,%016llx\n"), *Row.Name, Row.Hash);
+		}
+		if (!BenchmarkReport::SaveFile(GoldenPath, GoldenCsv))
+		{
+			UE_LOG(LogTemp, Error, TEXT("MeshBench: Could not write %s."), *GoldenPath);
+			return 1;
+		}
+		UE_LOG(LogTemp, Display, TEXT("MeshBench: Golden hashes written to %s."), *GoldenPath);
+		return 0;
+	}
+
+	if (Mismatches > 0 || Missing > 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("MeshBench: %d of %d meshes differ from the golden hashes, %d have none."), Mismatches, Rows.Num(), Missing);
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,29 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "BloxelsMeshBenchCommandlet.generated.h"
+
+/**
+ * Meshing benchmark and regression check, with no map and nothing rendered:
+ *
+ *   UnrealEditor-Cmd Bloxels -run=BloxelsMeshBench -nullrhi [-Config=<asset>] [-Seed=N] [-Iterations=5]
+ *       [-Golden=<path>] [-UpdateGolden] [-Output=<path>]
+ *
+ * Meshes the MeshCorpus chunks and reports time, quads, vertices and heap allocations per chunk, and hashes each
+ * chunk's mesh. The hashes are compared against the golden file (Benchmarks/MeshGolden.csv by default), which
+ * -UpdateGolden rewrites; a missing golden file, a case without a golden hash or any mismatch makes the
+ * commandlet return 1.
+ */
+UCLASS()
+class BLOXELS_API UBloxelsMeshBenchCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UBloxelsMeshBenchCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,462 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#include "BloxelsPathBenchCommandlet.h"
+
+#include "AllocationCounter.h"
+#include "BenchmarkReport.h"
+#include "HeadlessVoxelWorld.h"
+#include "Async/ParallelFor.h"
+#include "Bloxels/Voxel/PathFinding/PathfindingManager.h"
+#include "Bloxels/Voxel/PathFinding/VoxelNavGrid.h"
+#include "Bloxels/Voxel/PathFinding/VoxelNavHierarchy.h"
+#include "Bloxels/Voxel/World/VoxelWorld.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+	// Fixed so the corpus only changes when the world does
+	constexpr int32 CorpusSeed = 0x5EED;
+	constexpr int32 MaxCaveGoalDistance = 48;
+
+	enum class ETerrainCategory : uint8
+	{
+		Plains,
+		Mountains,
+		Caves,
+	};
+
+	const TCHAR* ToString(const ETerrainCategory Category)
+	{
+		switch (Category)
+		{
+		case ETerrainCategory::Plains: return TEXT("plains");
+		case ETerrainCategory::Mountains: return TEXT("mountains");
+		case ETerrainCategory::Caves: return TEXT("caves");
+		}
+		return TEXT("unknown");
+	}
+
+	struct FBenchPair
+	{
+		ETerrainCategory Category = ETerrainCategory::Plains;
+		FIntVector Start = FIntVector::ZeroValue;
+		FIntVector Goal = FIntVector::ZeroValue;
+	};
+
+	struct FBenchRow
+	{
+		FString Mode;
+		int32 PairIndex = 0;
+		FBenchPair Pair;
+		const TCHAR* Result = TEXT("");
+		int32 PathPoints = 0;
+		float PathCost = 0.f;
+		int32 NodesExpanded = 0;
+		int32 NodesGenerated = 0;
+		double MinMs = 0.0;
+		double AvgMs = 0.0;
+		int64 Allocations = 0;  // Last iteration, once the search context has grown to fit
+	};
+
+	struct FBenchRegion
+	{
+		int32 ChunkSize = 0;
+		FIntPoint Min = FIntPoint::ZeroValue;
+		int32 Width = 0;  // In columns, along both X and Y
+		TArray<int32> Heights;
+		FVoxelNavChunkMap Chunks;
+		FVoxelNavGraphMap Graphs;
+
+		int32 GetHeight(const int32 X, const int32 Y) const { return Heights[(Y - Min.Y) * Width + (X - Min.X)]; }
+	};
+
+	void GenerateRegion(const FHeadlessVoxelWorld& World, const int32 Radius, FBenchRegion& Region)
+	{
+		const int32 ChunkSize = World.GetChunkSize();
+		Region.ChunkSize = ChunkSize;
+		Region.Width = (Radius * 2 + 1) * ChunkSize;
+		Region.Min = FIntPoint(-Radius * ChunkSize);
+		Region.Heights.SetNum(Region.Width * Region.Width);
+
+		ParallelFor(Region.Width, [&World, &Region](const int32 Row)
+		{
+			for (int32 Column = 0; Column < Region.Width; ++Column)
+			{
+				Region.Heights[Row * Region.Width + Column] = World.GetTerrainHeight(Region.Min.X + Column, Region.Min.Y + Row);
+			}
+		});
+
+		// Room above the highest column to stand and to test a step up
+		const int32 MaxHeight = FMath::Max(Region.Heights);
+		const int32 MaxChunkZ = AVoxelWorld::GetChunkCoord(FIntVector(0, 0, MaxHeight + 2), ChunkSize).Z;
+
+		TArray<FIntVector> Coords;
+		for (int32 Z = 0; Z <= MaxChunkZ; ++Z)
+		{
+			for (int32 Y = -Radius; Y <= Radius; ++Y)
+			{
+				for (int32 X = -Radius; X <= Radius; ++X)
+				{
+					Coords.Add(FIntVector(X, Y, Z));
+				}
+			}
+		}
+
+		FVoxelNavGrid NavBuilder;
+		NavBuilder.Initialize(ChunkSize, World.GetRegistry());
+
+		TArray<TSharedPtr<const FVoxelNavChunk>> NavChunks;
+		NavChunks.SetNum(Coords.Num());
+		ParallelFor(Coords.Num(), [&](const int32 Index)
+		{
+			TArray<uint16> VoxelData;
+			TArray<int32> SkyStart;
+			World.GenerateChunk(Coords[Index], VoxelData, SkyStart);
+			NavChunks[Index] = NavBuilder.BuildChunk(VoxelData);
+		});
+
+		for (int32 Index = 0; Index < Coords.Num(); ++Index)
+		{
+			Region.Chunks.Add(Coords[Index], NavChunks[Index]);
+		}
+
+		// Portal graphs as the game would have published them, so hierarchical queries don't build their own
+		TArray<TSharedPtr<const FVoxelNavChunkGraph>> Graphs;
+		Graphs.SetNum(Coords.Num());
+		ParallelFor(Coords.Num(), [&](const int32 Index)
+		{
+			const FVoxelNavQuery Nav(Region.Chunks, ChunkSize);
+			Graphs[Index] = VoxelNavHierarchy::BuildChunkGraph(Nav, Coords[Index]);
+		});
+
+		for (int32 Index = 0; Index < Coords.Num(); ++Index)
+		{
+			Region.Graphs.Add(Coords[Index], Graphs[Index]);
+		}
+
+		UE_LOG(LogTemp, Display, TEXT("PathBench: Generated %d chunks, %d columns square, heights up to %d."),
+			Coords.Num(), Region.Width, MaxHeight);
+	}
+
+	bool FindSurface(const FVoxelNavQuery& Nav, const FBenchRegion& Region, const FIntPoint& Column, FIntVector& OutCoord)
+	{
+		const int32 Height = Region.GetHeight(Column.X, Column.Y);
+		for (int32 Z = Height + 2; Z >= Height - 2; --Z)
+		{
+			if (Nav.IsWalkable(FIntVector(Column.X, Column.Y, Z)))
+			{
+				OutCoord = FIntVector(Column.X, Column.Y, Z);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void BuildCorpus(const FVoxelNavQuery& Nav, const FBenchRegion& Region, const int32 PairsPerCategory, TArray<FBenchPair>& OutPairs)
+	{
+		FRandomStream Random(CorpusSeed);
+		const int32 ChunkSize = Region.ChunkSize;
+		const int32 TilesPerAxis = Region.Width / ChunkSize;
+
+		// Chunk columns ranked by relief: the flattest third count as plains, the steepest third as mountains
+		TArray<int32> Relief;
+		TArray<int32> Tiles;
+		for (int32 Tile = 0; Tile < TilesPerAxis * TilesPerAxis; ++Tile)
+		{
+			const int32 MinX = Region.Min.X + (Tile % TilesPerAxis) * ChunkSize;
+			const int32 MinY = Region.Min.Y + (Tile / TilesPerAxis) * ChunkSize;
+
+			int32 Lowest = MAX_int32;
+			int32 Highest = MIN_int32;
+			for (int32 Y = MinY; Y < MinY + ChunkSize; ++Y)
+			{
+				for (int32 X = MinX; X < MinX + ChunkSize; ++X)
+				{
+					Lowest = FMath::Min(Lowest, Region.GetHeight(X, Y));
+					Highest = FMath::Max(Highest, Region.GetHeight(X, Y));
+				}
+			}
+			Relief.Add(Highest - Lowest);
+			Tiles.Add(Tile);
+		}
+		Tiles.Sort([&Relief](const int32 A, const int32 B) { return Relief[A] < Relief[B] || (Relief[A] == Relief[B] && A < B); });
+
+		const int32 Third = FMath::Max(1, Tiles.Num() / 3);
+		const TArray<int32> PlainsTiles(Tiles.GetData(), Third);
+		const TArray<int32> MountainTiles(Tiles.GetData() + Tiles.Num() - Third, Third);
+
+		auto RandomColumn = [&](const TArray<int32>& Candidates)
+		{
+			// One draw per statement: argument evaluation order would make the corpus depend on the compiler
+			const int32 Tile = Candidates[Random.RandRange(0, Candidates.Num() - 1)];
+			const int32 X = Region.Min.X + (Tile % TilesPerAxis) * ChunkSize + Random.RandRange(0, ChunkSize - 1);
+			const int32 Y = Region.Min.Y + (Tile / TilesPerAxis) * ChunkSize + Random.RandRange(0, ChunkSize - 1);
+			return FIntPoint(X, Y);
+		};
+
+		auto AddSurfacePairs = [&](const ETerrainCategory Category, const TArray<int32>& CategoryTiles)
+		{
+			int32 Added = 0;
+			for (int32 Attempt = 0; Attempt < PairsPerCategory * 32 && Added < PairsPerCategory; ++Attempt)
+			{
+				const FIntPoint StartColumn = RandomColumn(CategoryTiles);
+				const FIntPoint GoalColumn = RandomColumn(CategoryTiles);
+
+				FIntVector Start, Goal;
+				if (StartColumn == GoalColumn || !FindSurface(Nav, Region, StartColumn, Start) || !FindSurface(Nav, Region, GoalColumn, Goal))
+				{
+					continue;
+				}
+
+				OutPairs.Add(FBenchPair{ Category, Start, Goal });
+				Added++;
+			}
+
+			if (Added < PairsPerCategory)
+			{
+				UE_LOG(LogTemp, Warning, TEXT("PathBench: Only %d %s pairs found."), Added, ToString(Category));
+			}
+		};
+
+		AddSurfacePairs(ETerrainCategory::Plains, PlainsTiles);
+		AddSurfacePairs(ETerrainCategory::Mountains, MountainTiles);
+
+		// Caves: anywhere an agent can stand well under the surface of its column
+		TArray<FIntVector> CaveVoxels;
+		for (int32 Y = Region.Min.Y; Y < Region.Min.Y + Region.Width; ++Y)
+		{
+			for (int32 X = Region.Min.X; X < Region.Min.X + Region.Width; ++X)
+			{
+				for (int32 Z = 1; Z < Region.GetHeight(X, Y) - 3; ++Z)
+				{
+					if (Nav.IsWalkable(FIntVector(X, Y, Z)))
+					{
+						CaveVoxels.Add(FIntVector(X, Y, Z));
+					}
+				}
+			}
+		}
+
+		int32 Added = 0;
+		TArray<FIntVector> Goals;
+		for (int32 Attempt = 0; Attempt < PairsPerCategory * 32 && Added < PairsPerCategory && CaveVoxels.Num() > 1; ++Attempt)
+		{
+			const FIntVector Start = CaveVoxels[Random.RandRange(0, CaveVoxels.Num() - 1)];
+
+			Goals.Reset();
+			for (const FIntVector& Candidate : CaveVoxels)
+			{
+				if (Candidate != Start && FMath::Abs(Candidate.X - Start.X) <= MaxCaveGoalDistance && FMath::Abs(Candidate.Y - Start.Y) <= MaxCaveGoalDistance)
+				{
+					Goals.Add(Candidate);
+				}
+			}
+			if (Goals.Num() == 0) continue;
+
+			OutPairs.Add(FBenchPair{ ETerrainCategory::Caves, Start, Goals[Random.RandRange(0, Goals.Num() - 1)] });
+			Added++;
+		}
+
+		if (Added < PairsPerCategory)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("PathBench: Only %d cave pairs found among %d cave voxels."), Added, CaveVoxels.Num());
+		}
+	}
+
+	bool ParseMode(const FString& Name, FPathSearchParams& OutParams)
+	{
+		OutParams.bBidirectional = false;
+		if (Name.Equals(TEXT("AStar"), ESearchCase::IgnoreCase))
+		{
+			OutParams.Mode = EPathSearchMode::AStar;
+			return true;
+		}
+		if (Name.Equals(TEXT("Bidirectional"), ESearchCase::IgnoreCase))
+		{
+			OutParams.Mode = EPathSearchMode::AStar;
+			OutParams.bBidirectional = true;
+			return true;
+		}
+		if (Name.Equals(TEXT("JumpPoint"), ESearchCase::IgnoreCase))
+		{
+			OutParams.Mode = EPathSearchMode::JumpPoint;
+			return true;
+		}
+		if (Name.Equals(TEXT("Hierarchical"), ESearchCase::IgnoreCase))
+		{
+			OutParams.Mode = EPathSearchMode::Hierarchical;
+			return true;
+		}
+		return false;
+	}
+
+	bool WriteCsv(const FString& Path, const TArray<FBenchRow>& Rows)
+	{
+		FString Csv = TEXT("mode,pair,category,start_x,start_y,start_z,goal_x,goal_y,goal_z,result,path_points,path_cost,nodes_expanded,nodes_generated,min_ms,avg_ms,allocations\n");
+		for (const FBenchRow& Row : Rows)
+		{
+			Csv += FString::Printf(TEXT("%s,%d,%s,%d,%d,%d,%d,%d,%d,%s,%d,%.1f,%d,%d,%.4f,%.4f,%lld\n"),
+				*Row.Mode, Row.PairIndex, ToString(Row.Pair.Category),
+				Row.Pair.Start.X, Row.Pair.Start.Y, Row.Pair.Start.Z, Row.Pair.Goal.X, Row.Pair.Goal.Y, Row.Pair.Goal.Z,
+				Row.Result, Row.PathPoints, Row.PathCost, Row.NodesExpanded, Row.NodesGenerated, Row.MinMs, Row.AvgMs, Row.Allocations);
+		}
+		return BenchmarkReport::SaveFile(Path, Csv);
+	}
+
+	TArray<TSharedPtr<FJsonValue>> ToJson(const FIntVector& Coord)
+	{
+		return { MakeShared<FJsonValueNumber>(Coord.X), MakeShared<FJsonValueNumber>(Coord.Y), MakeShared<FJsonValueNumber>(Coord.Z) };
+	}
+
+	bool WriteJson(const FString& Path, const FHeadlessVoxelWorld& World, const int32 Radius, const int32 Iterations, const TArray<FBenchRow>& Rows)
+	{
+		const TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+		Root->SetStringField(TEXT("config"), World.GetConfig()->GetPathName());
+		Root->SetNumberField(TEXT("radius"), Radius);
+		Root->SetNumberField(TEXT("iterations"), Iterations);
+
+		TArray<TSharedPtr<FJsonValue>> Queries;
+		for (const FBenchRow& Row : Rows)
+		{
+			const TSharedRef<FJsonObject> Query = MakeShared<FJsonObject>();
+			Query->SetStringField(TEXT("mode"), Row.Mode);
+			Query->SetNumberField(TEXT("pair"), Row.PairIndex);
+			Query->SetStringField(TEXT("category"), ToString(Row.Pair.Category));
+			Query->SetArrayField(TEXT("start"), ToJson(Row.Pair.Start));
+			Query->SetArrayField(TEXT("goal"), ToJson(Row.Pair.Goal));
+			Query->SetStringField(TEXT("result"), Row.Result);
+			Query->SetNumberField(TEXT("path_points"), Row.PathPoints);
+			Query->SetNumberField(TEXT("path_cost"), Row.PathCost);
+			Query->SetNumberField(TEXT("nodes_expanded"), Row.NodesExpanded);
+			Query->SetNumberField(TEXT("nodes_generated"), Row.NodesGenerated);
+			Query->SetNumberField(TEXT("min_ms"), Row.MinMs);
+			Query->SetNumberField(TEXT("avg_ms"), Row.AvgMs);
+			Query->SetNumberField(TEXT("allocations"), Row.Allocations);
+			Queries.Add(MakeShared<FJsonValueObject>(Query));
+		}
+		Root->SetArrayField(TEXT("queries"), Queries);
+
+		FString Json;
+		const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+		return FJsonSerializer::Serialize(Root, Writer) && BenchmarkReport::SaveFile(Path, Json);
+	}
+}
+
+UBloxelsPathBenchCommandlet::UBloxelsPathBenchCommandlet()
+{
+	IsClient = false;
+	IsServer = false;
+	IsEditor = false;
+	LogToConsole = true;
+}
+
+int32 UBloxelsPathBenchCommandlet::Main(const FString& Params)
+{
+	FHeadlessVoxelWorld World;
+	if (!World.InitializeFromCommandLine(Params)) return 1;
+
+	int32 Radius = 4;
+	int32 PairsPerCategory = 8;
+	int32 Iterations = 3;
+	int32 MaxExpansions = 0;
+	FString ModeList = TEXT("AStar,Bidirectional,JumpPoint,Hierarchical");
+	const FString Output = BenchmarkReport::GetOutputPath(Params, TEXT("PathBench"));
+	FParse::Value(*Params, TEXT("Radius="), Radius);
+	FParse::Value(*Params, TEXT("Pairs="), PairsPerCategory);
+	FParse::Value(*Params, TEXT("Iterations="), Iterations);
+	FParse::Value(*Params, TEXT("MaxExpansions="), MaxExpansions);
+	FParse::Value(*Params, TEXT("Modes="), ModeList, false);
+	Radius = FMath::Clamp(Radius, 1, 32);
+	Iterations = FMath::Max(1, Iterations);
+
+	TArray<FString> Modes;
+	ModeList.ParseIntoArray(Modes, TEXT(","));
+
+	FBenchRegion Region;
+	GenerateRegion(World, Radius, Region);
+
+	const FVoxelNavQuery Nav(Region.Chunks, Region.ChunkSize, &Region.Graphs);
+
+	TArray<FBenchPair> Pairs;
+	BuildCorpus(Nav, Region, PairsPerCategory, Pairs);
+	if (Pairs.Num() == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("PathBench: No start/goal pairs in the generated region."));
+		return 1;
+	}
+
+	AllocationCounter::Install();
+
+	TArray<FBenchRow> Rows;
+	FPathSearchContext Search;
+	TArray<FVector> Path;
+	for (const FString& Mode : Modes)
+	{
+		FPathSearchParams SearchParams;
+		if (!ParseMode(Mode, SearchParams))
+		{
+			UE_LOG(LogTemp, Warning, TEXT("PathBench: Unknown mode '%s', skipped."), *Mode);
+			continue;
+		}
+		SearchParams.MaxExpansions = FMath::Max(0, MaxExpansions);
+		SearchParams.bAllowPartial = SearchParams.MaxExpansions > 0;
+
+		int64 TotalExpanded = 0;
+		double TotalMs = 0.0;
+		int32 Found = 0;
+
+		for (int32 PairIndex = 0; PairIndex < Pairs.Num(); ++PairIndex)
+		{
+			FBenchRow& Row = Rows.AddDefaulted_GetRef();
+			Row.Mode = Mode;
+			Row.PairIndex = PairIndex;
+			Row.Pair = Pairs[PairIndex];
+
+			SearchParams.Start = Row.Pair.Start;
+			SearchParams.End = Row.Pair.Goal;
+
+			bool bFound = false;
+			FPathfindingStats Stats;
+			double SumMs = 0.0;
+			Row.MinMs = TNumericLimits<double>::Max();
+			for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+			{
+				AllocationCounter::Begin();
+				bFound = UPathfindingManager::SearchPath(Nav, Search, SearchParams, Path, Stats);
+				Row.Allocations = AllocationCounter::End();
+
+				SumMs += Stats.Seconds * 1000.0;
+				Row.MinMs = FMath::Min(Row.MinMs, Stats.Seconds * 1000.0);
+			}
+
+			Row.Result = bFound ? TEXT("found") : Stats.bPartial ? TEXT("partial") : TEXT("failed");
+			Row.PathPoints = Path.Num();
+			Row.PathCost = Stats.PathCost;
+			Row.NodesExpanded = Stats.NodesExpanded;
+			Row.NodesGenerated = Stats.NodesGenerated;
+			Row.AvgMs = SumMs / Iterations;
+
+			TotalExpanded += Stats.NodesExpanded;
+			TotalMs += Row.AvgMs;
+			Found += bFound ? 1 : 0;
+		}
+
+		UE_LOG(LogTemp, Display, TEXT("PathBench: %-12s %d/%d found, %lld nodes expanded, %.3f ms, %.0f nodes/sec"),
+			*Mode, Found, Pairs.Num(), TotalExpanded, TotalMs, TotalMs > 0.0 ? TotalExpanded / (TotalMs / 1000.0) : 0.0);
+	}
+
+	AllocationCounter::Uninstall();
+
+	const FString CsvPath = Output + TEXT(".csv");
+	const FString JsonPath = Output + TEXT(".json");
+	if (!WriteCsv(CsvPath, Rows) || !WriteJson(JsonPath, World, Radius, Iterations, Rows))
+	{
+		UE_LOG(LogTemp, Error, TEXT("PathBench: Could not write results to %s."), *Output);
+		return 1;
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("PathBench: %d queries written to %s and %s."), Rows.Num(), *CsvPath, *JsonPath);
+	return 0;
+}
@@ -0,0 +1,29 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "BloxelsPathBenchCommandlet.generated.h"
+
+/**
+ * Pathfinding benchmark and regression run over generated terrain, with no map and nothing rendered:
+ *
+ *   UnrealEditor-Cmd Bloxels -run=BloxelsPathBench -nullrhi [-Config=<asset>] [-Seed=N] [-Radius=4] [-Pairs=8]
+ *       [-Iterations=3] [-Modes=AStar,Bidirectional,JumpPoint,Hierarchical] [-MaxExpansions=0] [-Output=<path>]
+ *
+ * Generates the chunks within Radius of the origin, then picks start/goal pairs on plains, in mountains and in
+ * caves with a fixed random stream. The same config, seed and radius always give the same corpus, so runs of
+ * different builds line up query by query. Writes <Output>.csv and <Output>.json with nodes expanded, time,
+ * path cost and heap allocations per query.
+ */
+UCLASS()
+class BLOXELS_API UBloxelsPathBenchCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UBloxelsPathBenchCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
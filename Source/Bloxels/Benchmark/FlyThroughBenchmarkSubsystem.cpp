@@ -0,0 +1,314 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#include "FlyThroughBenchmarkSubsystem.h"
+
+#include "BenchmarkReport.h"
+#include "Bloxels/Player/FreeCamera/FreeCameraPawn.h"
+#include "Bloxels/Voxel/World/VoxelWorld.h"
+#include "Bloxels/Voxel/World/WorldGenerationConfig.h"
+#include "Bloxels/Voxel/World/WorldGenerationSubsystem.h"
+#include "Dom/JsonObject.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace
+{
+	// Fixed so the default route only changes with the world
+	constexpr int32 RouteSeed = 0x5EED;
+	constexpr int32 ChunksPerWaypoint = 4;
+	constexpr int32 FlightHeightInVoxels = 24;
+	constexpr float MaxTurnDegrees = 30.f;
+
+	bool LoadPathFile(const FString& Path, TArray<FVector>& OutPoints)
+	{
+		TArray<FString> Lines;
+		if (!FFileHelper::LoadFileToStringArray(Lines, *Path)) return false;
+
+		for (const FString& Line : Lines)
+		{
+			TArray<FString> Parts;
+			if (Line.ParseIntoArray(Parts, TEXT(",")) != 3) continue;
+			OutPoints.Add(FVector(FCString::Atod(*Parts[0]), FCString::Atod(*Parts[1]), FCString::Atod(*Parts[2])));
+		}
+		return OutPoints.Num() >= 2;
+	}
+}
+
+void UFlyThroughBenchmarkSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	const TCHAR* CommandLine = FCommandLine::Get();
+	if (!FParse::Param(CommandLine, TEXT("FlyThrough"))) return;
+
+	FParse::Value(CommandLine, TEXT("FlyThroughPath="), PathFile);
+	FParse::Value(CommandLine, TEXT("FlyThroughSpeed="), Speed);
+	FParse::Value(CommandLine, TEXT("FlyThroughLength="), LengthInChunks);
+	FParse::Value(CommandLine, TEXT("FlyThroughWarmup="), WarmupSeconds);
+	FParse::Value(CommandLine, TEXT("Seed="), Seed);
+	Speed = FMath::Max(1.f, Speed);
+	LengthInChunks = FMath::Max(1, LengthInChunks);
+
+	State = EState::WaitingForWorld;
+	StateStartTime = FPlatformTime::Seconds();
+	UE_LOG(LogTemp, Display, TEXT("FlyThrough: waiting for the voxel world."));
+}
+
+bool UFlyThroughBenchmarkSubsystem::DoesSupportWorldType(const EWorldType::Type WorldType) const
+{
+	return WorldType == EWorldType::Game || WorldType == EWorldType::PIE;
+}
+
+TStatId UFlyThroughBenchmarkSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UFlyThroughBenchmarkSubsystem, STATGROUP_Tickables);
+}
+
+AFreeCameraPawn* UFlyThroughBenchmarkSubsystem::GetPawn() const
+{
+	const APlayerController* Controller = UGameplayStatics::GetPlayerController(GetWorld(), 0);
+	return Controller ? Cast<AFreeCameraPawn>(Controller->GetPawn()) : nullptr;
+}
+
+AVoxelWorld* UFlyThroughBenchmarkSubsystem::GetVoxelWorld() const
+{
+	return Cast<AVoxelWorld>(UGameplayStatics::GetActorOfClass(GetWorld(), AVoxelWorld::StaticClass()));
+}
+
+void UFlyThroughBenchmarkSubsystem::Tick(const float DeltaTime)
+{
+	Super::Tick(DeltaTime);
+
+	if (bRecording)
+	{
+		RecordTimer -= DeltaTime;
+		if (const APawn* Pawn = GetPawn(); Pawn && RecordTimer <= 0.f)
+		{
+			RecordedPoints.Add(Pawn->GetActorLocation());
+			RecordTimer = RecordInterval;
+		}
+	}
+
+	if (State == EState::Idle || State == EState::Done) return;
+
+	AVoxelWorld* VoxelWorld = GetVoxelWorld();
+	AFreeCameraPawn* Pawn = GetPawn();
+	const double Now = FPlatformTime::Seconds();
+
+	switch (State)
+	{
+	case EState::WaitingForWorld:
+		// The world builds its light engine and nav grid once the registry is up, so those mark it as ready
+		if (VoxelWorld && Pawn && VoxelWorld->GetLightEngine())
+		{
+			State = EState::Warmup;
+			StateStartTime = Now;
+		}
+		else if (Now - StateStartTime > WorldTimeoutSeconds)
+		{
+			UE_LOG(LogTemp, Error, TEXT("FlyThrough: no voxel world or free camera after %.0f s."), WorldTimeoutSeconds);
+			Finish(VoxelWorld, false);
+		}
+		break;
+
+	case EState::Warmup:
+		if (Now - StateStartTime < WarmupSeconds || !VoxelWorld || !Pawn) break;
+
+		if (!BuildPath(*VoxelWorld, Pawn->GetActorLocation()))
+		{
+			Finish(VoxelWorld, false);
+			break;
+		}
+		Distance = 0.f;
+		FrameMs.Reset();
+		FrameCallbackMs.Reset();
+		StartChunksStreamed = VoxelWorld->GetStreamingCounters().ChunksStreamed;
+		LastCallbackSeconds = VoxelWorld->GetStreamingCounters().ChunkCallbackSeconds;
+		LastFrameTime = Now;
+		State = EState::Flying;
+		UE_LOG(LogTemp, Display, TEXT("FlyThrough: flying %.0f units at %.0f units/s."), PathLength, Speed);
+		break;
+
+	case EState::Flying:
+		if (!VoxelWorld || !Pawn)
+		{
+			UE_LOG(LogTemp, Error, TEXT("FlyThrough: lost the voxel world or camera mid-flight."));
+			Finish(VoxelWorld, false);
+			break;
+		}
+		TickFlight(DeltaTime, *VoxelWorld, *Pawn);
+		break;
+
+	default:
+		break;
+	}
+}
+
+bool UFlyThroughBenchmarkSubsystem::BuildPath(const AVoxelWorld& VoxelWorld, const FVector& Start)
+{
+	TArray<FVector> Points;
+	if (!PathFile.IsEmpty())
+	{
+		if (!LoadPathFile(PathFile, Points))
+		{
+			UE_LOG(LogTemp, Error, TEXT("FlyThrough: could not read a path from %s."), *PathFile);
+			return false;
+		}
+	}
+	else
+	{
+		const UWorldGenerationConfig* Config = VoxelWorld.GetWorldGenerationConfig();
+		const UWorldGenerationSubsystem* Generator = VoxelWorld.GetWorldGenerationSubsystem();
+		if (!Config || !Generator) return false;
+
+		const float VoxelSize = Config->VoxelSize;
+		const float StepLength = ChunksPerWaypoint * Config->ChunkSize * VoxelSize;
+		const int32 NumSteps = FMath::DivideAndRoundUp(LengthInChunks, ChunksPerWaypoint);
+
+		FRandomStream Random(RouteSeed);
+		FVector Point = Start;
+		float Heading = 0.f;
+		for (int32 Step = 0; Step <= NumSteps; ++Step)
+		{
+			const int32 VoxelX = FMath::FloorToInt32(Point.X / VoxelSize);
+			const int32 VoxelY = FMath::FloorToInt32(Point.Y / VoxelSize);
+			const int32 Height = Generator->GetTerrainHeight(VoxelX, VoxelY, Generator->GetBiome(VoxelX, VoxelY));
+			Point.Z = (Height + FlightHeightInVoxels) * VoxelSize;
+			Points.Add(Point);
+
+			Heading += Random.FRandRange(-MaxTurnDegrees, MaxTurnDegrees);
+			Point += FRotator(0.f, Heading, 0.f).Vector() * StepLength;
+		}
+	}
+
+	// Keyed by distance along the polyline so a fixed speed covers the same ground per second
+	Path.Reset();
+	PathLength = 0.f;
+	for (int32 Index = 0; Index < Points.Num(); ++Index)
+	{
+		if (Index > 0)
+		{
+			PathLength += FVector::Dist(Points[Index - 1], Points[Index]);
+		}
+		const int32 Key = Path.AddPoint(PathLength, Points[Index]);
+		Path.Points[Key].InterpMode = CIM_CurveAuto;
+	}
+	Path.AutoSetTangents();
+	return PathLength > 0.f;
+}
+
+void UFlyThroughBenchmarkSubsystem::TickFlight(const float DeltaTime, AVoxelWorld& VoxelWorld, AFreeCameraPawn& Pawn)
+{
+	const double Now = FPlatformTime::Seconds();
+	const FVoxelStreamingCounters& Counters = VoxelWorld.GetStreamingCounters();
+
+	// The first frame measures the warmup handover, not the flight
+	if (Distance > 0.f)
+	{
+		FrameMs.Add((Now - LastFrameTime) * 1000.0);
+		FrameCallbackMs.Add((Counters.ChunkCallbackSeconds - LastCallbackSeconds) * 1000.0);
+	}
+	LastFrameTime = Now;
+	LastCallbackSeconds = Counters.ChunkCallbackSeconds;
+
+	Distance = FMath::Min(Distance + Speed * DeltaTime, PathLength);
+	const FVector Location = Path.Eval(Distance);
+	const FVector Direction = Path.EvalDerivative(Distance).GetSafeNormal();
+	Pawn.SetView(Location, Direction.IsNearlyZero() ? Pawn.GetActorRotation() : Direction.Rotation());
+
+	if (Distance >= PathLength)
+	{
+		Finish(&VoxelWorld, true);
+	}
+}
+
+void UFlyThroughBenchmarkSubsystem::Finish(const AVoxelWorld* VoxelWorld, const bool bCompleted)
+{
+	State = EState::Done;
+
+	TArray<double> Sorted = FrameMs;
+	double TotalMs = 0.0;
+	int32 Hitches = 0;
+	for (const double Ms : FrameMs)
+	{
+		TotalMs += Ms;
+		Hitches += Ms > HitchMs ? 1 : 0;
+	}
+	double CallbackMs = 0.0;
+	for (const double Ms : FrameCallbackMs) CallbackMs += Ms;
+
+	const int32 ChunksStreamed = VoxelWorld ? VoxelWorld->GetStreamingCounters().ChunksStreamed - StartChunksStreamed : 0;
+	const int32 Frames = FrameMs.Num();
+	const double AvgMs = Frames > 0 ? TotalMs / Frames : 0.0;
+	const double P50 = BenchmarkReport::Percentile(Sorted, 0.5);
+	const double P95 = BenchmarkReport::Percentile(Sorted, 0.95);
+	const double P99 = BenchmarkReport::Percentile(Sorted, 0.99);
+	const double MaxMs = Sorted.Num() > 0 ? Sorted.Last() : 0.0;
+
+	UE_LOG(LogTemp, Display, TEXT("FlyThrough: %s, %d frames in %.2f s, avg %.2f ms, p50 %.2f ms, p95 %.2f ms, p99 %.2f ms, max %.2f ms, %d hitches"),
+		bCompleted ? TEXT("completed") : TEXT("failed"), Frames, TotalMs / 1000.0, AvgMs, P50, P95, P99, MaxMs, Hitches);
+	UE_LOG(LogTemp, Display, TEXT("FlyThrough: %d chunks streamed, %.2f ms in chunk callbacks on the game thread"),
+		ChunksStreamed, CallbackMs);
+
+	const TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetBoolField(TEXT("completed"), bCompleted);
+	Root->SetStringField(TEXT("map"), GetWorld()->GetMapName());
+	Root->SetStringField(TEXT("path"), PathFile.IsEmpty() ? TEXT("generated") : PathFile);
+	Root->SetNumberField(TEXT("seed"), Seed);
+	Root->SetNumberField(TEXT("speed"), Speed);
+	Root->SetNumberField(TEXT("path_length"), PathLength);
+	Root->SetNumberField(TEXT("frames"), Frames);
+	Root->SetNumberField(TEXT("seconds"), TotalMs / 1000.0);
+	Root->SetNumberField(TEXT("avg_ms"), AvgMs);
+	Root->SetNumberField(TEXT("p50_ms"), P50);
+	Root->SetNumberField(TEXT("p95_ms"), P95);
+	Root->SetNumberField(TEXT("p99_ms"), P99);
+	Root->SetNumberField(TEXT("max_ms"), MaxMs);
+	Root->SetNumberField(TEXT("hitches"), Hitches);
+	Root->SetNumberField(TEXT("hitch_threshold_ms"), HitchMs);
+	Root->SetNumberField(TEXT("chunks_streamed"), ChunksStreamed);
+	Root->SetNumberField(TEXT("chunk_callback_ms"), CallbackMs);
+
+	FString Csv = TEXT("frame,frame_ms,chunk_callback_ms\n");
+	for (int32 Frame = 0; Frame < Frames; ++Frame)
+	{
+		Csv += FString::Printf(TEXT("%d,%.3f,%.3f\n"), Frame, FrameMs[Frame], FrameCallbackMs[Frame]);
+	}
+
+	const FString Output = BenchmarkReport::GetOutputPath(FCommandLine::Get(), TEXT("FlyThrough"));
+	FString Json;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&Json);
+	bool bWritten = FJsonSerializer::Serialize(Root, Writer) && BenchmarkReport::SaveFile(Output + TEXT(".json"), Json);
+	bWritten = BenchmarkReport::SaveFile(Output + TEXT(".csv"), Csv) && bWritten;
+	if (bWritten)
+	{
+		UE_LOG(LogTemp, Display, TEXT("FlyThrough: report written to %s.json and %s.csv."), *Output, *Output);
+	}
+	else
+	{
+		UE_LOG(LogTemp, Error, TEXT("FlyThrough: could not write the report to %s."), *Output);
+	}
+
+	FPlatformMisc::RequestExitWithStatus(false, bCompleted && bWritten ? 0 : 1);
+}
+
+void UFlyThroughBenchmarkSubsystem::StartRecording()
+{
+	RecordedPoints.Reset();
+	RecordTimer = 0.f;
+	bRecording = true;
+}
+
+bool UFlyThroughBenchmarkSubsystem::StopRecording(const FString& Path)
+{
+	bRecording = false;
+
+	FString Csv;
+	for (const FVector& Point : RecordedPoints)
+	{
+		Csv += FString::Printf(TEXT("%.1f,%.1f,%.1f\n"), Point.X, Point.Y, Point.Z);
+	}
+	return RecordedPoints.Num() >= 2 && BenchmarkReport::SaveFile(Path, Csv);
+}
@@ -0,0 +1,89 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Math/InterpCurve.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "FlyThroughBenchmarkSubsystem.generated.h"
+
+class AFreeCameraPawn;
+class AVoxelWorld;
+
+/**
+ * Streaming benchmark that flies the free camera along a fixed path, then writes a report and exits:
+ *
+ *   UnrealEditor Bloxels -game -nullrhi -benchmark -fps=60 -FlyThrough [-FlyThroughPath=<csv>] [-FlyThroughSpeed=2000]
+ *       [-FlyThroughLength=64] [-FlyThroughWarmup=3] [-Seed=N] [-Output=<path>]
+ *
+ * Without a path file the route is built from a fixed random stream over the terrain, so the same seed gives the
+ * same flight. -benchmark -fps=60 fixes the time step, which makes the camera cover the same ground every frame
+ * whatever the machine. Records real frame time, game thread time in chunk callbacks, chunks streamed and hitches,
+ * and writes <Output>.json plus per-frame <Output>.csv. Works with -nullrhi and -RenderOffscreen.
+ *
+ * Paths can be recorded in game with the FlyThroughRecord and FlyThroughSave cheats.
+ */
+UCLASS()
+class BLOXELS_API UFlyThroughBenchmarkSubsystem : public UTickableWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Tick(float DeltaTime) override;
+	virtual TStatId GetStatId() const override;
+
+	// Samples the player's location until StopRecording, which writes one "x,y,z" line per sample
+	void StartRecording();
+	bool StopRecording(const FString& Path);
+	bool IsRecording() const { return bRecording; }
+
+protected:
+	virtual bool DoesSupportWorldType(const EWorldType::Type WorldType) const override;
+
+private:
+	enum class EState : uint8
+	{
+		Idle,
+		WaitingForWorld,
+		Warmup,
+		Flying,
+		Done,
+	};
+
+	static constexpr double HitchMs = 33.3;
+	static constexpr double WorldTimeoutSeconds = 60.0;
+	static constexpr float RecordInterval = 0.25f;
+
+	EState State = EState::Idle;
+
+	// Options
+	FString PathFile;
+	float Speed = 2000.f;    // Units per second
+	int32 LengthInChunks = 64;
+	float WarmupSeconds = 3.f;
+	int32 Seed = 0;
+
+	// Flight
+	FInterpCurveVector Path;
+	float PathLength = 0.f;
+	float Distance = 0.f;
+	double StateStartTime = 0.0;
+	double LastFrameTime = 0.0;
+	int32 StartChunksStreamed = 0;
+	double LastCallbackSeconds = 0.0;
+	TArray<double> FrameMs;
+	TArray<double> FrameCallbackMs;
+
+	// Recording
+	bool bRecording = false;
+	float RecordTimer = 0.f;
+	TArray<FVector> RecordedPoints;
+
+	AFreeCameraPawn* GetPawn() const;
+	AVoxelWorld* GetVoxelWorld() const;
+
+	bool BuildPath(const AVoxelWorld& VoxelWorld, const FVector& Start);
+	void TickFlight(float DeltaTime, AVoxelWorld& VoxelWorld, AFreeCameraPawn& Pawn);
+	void Finish(const AVoxelWorld* VoxelWorld, bool bCompleted);
+};
@@ -0,0 +1,106 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#include "HeadlessVoxelWorld.h"
+
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Bloxels/Voxel/Chunk/VoxelChunkAsync.h"
+#include "Bloxels/Voxel/VoxelRegistry/VoxelRegistrySubsystem.h"
+#include "Bloxels/Voxel/World/WorldGenerationConfig.h"
+#include "Bloxels/Voxel/World/WorldGenerationSubsystem.h"
+#include "Engine/Engine.h"
+#include "Engine/GameInstance.h"
+
+FHeadlessVoxelWorld::~FHeadlessVoxelWorld()
+{
+	Shutdown();
+}
+
+bool FHeadlessVoxelWorld::Initialize(const FString& ConfigPath, const TOptional<int32> Seed)
+{
+	Shutdown();
+
+	// Commandlets start before the asset registry has scanned, and the voxel registry looks its assets up by path
+	IAssetRegistry& AssetRegistry = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry").Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	Config = LoadObject<UWorldGenerationConfig>(nullptr, *ConfigPath);
+	if (!Config)
+	{
+		UE_LOG(LogTemp, Error, TEXT("HeadlessVoxelWorld: Could not load config '%s'."), *ConfigPath);
+		return false;
+	}
+
+	if (Seed.IsSet())
+	{
+		Config = Config->CopyWithSeed(Seed.GetValue(), GetTransientPackage());
+	}
+	Config->AddToRoot();
+
+	GameInstance = NewObject<UGameInstance>(GEngine);
+	GameInstance->AddToRoot();
+	GameInstance->InitializeStandalone();
+
+	Registry = GameInstance->GetSubsystem<UVoxelRegistrySubsystem>();
+	Generator = GameInstance->GetSubsystem<UWorldGenerationSubsystem>();
+	if (!Registry || !Generator || Registry->GetVoxelCount() == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("HeadlessVoxelWorld: Voxel registry or world generation subsystem is not available."));
+		Shutdown();
+		return false;
+	}
+
+	Generator->InitializeConfig(Config);
+
+	UE_LOG(LogTemp, Display, TEXT("HeadlessVoxelWorld: %s, chunk size %d, %d voxel types, seeds %d/%d/%d/%d."),
+		*Config->GetPathName(), Config->ChunkSize, Registry->GetVoxelCount(),
+		Config->Temperature.NoiseSeed, Config->Habitability.NoiseSeed, Config->Elevation.NoiseSeed, Config->Underground.NoiseSeed);
+	return true;
+}
+
+bool FHeadlessVoxelWorld::InitializeFromCommandLine(const FString& Params)
+{
+	FString ConfigPath = DefaultConfigPath;
+	FParse::Value(*Params, TEXT("Config="), ConfigPath);
+
+	TOptional<int32> Seed;
+	int32 SeedValue = 0;
+	if (FParse::Value(*Params, TEXT("Seed="), SeedValue))
+	{
+		Seed = SeedValue;
+	}
+
+	return Initialize(ConfigPath, Seed);
+}
+
+void FHeadlessVoxelWorld::Shutdown()
+{
+	if (GameInstance)
+	{
+		GameInstance->Shutdown();
+		GameInstance->RemoveFromRoot();
+		GameInstance = nullptr;
+	}
+	if (Config)
+	{
+		Config->RemoveFromRoot();
+		Config = nullptr;
+	}
+	Registry = nullptr;
+	Generator = nullptr;
+}
+
+void FHeadlessVoxelWorld::GenerateChunk(const FIntVector& ChunkCoord, TArray<uint16>& OutVoxelData, TArray<int32>& OutSkyStart,
+	FVoxelGenStageTimes* OutStageTimes) const
+{
+	VoxelChunkAsync::GenerateVoxelData(*Generator, *Registry, Config->ChunkSize, ChunkCoord, OutVoxelData, OutSkyStart, OutStageTimes);
+}
+
+int32 FHeadlessVoxelWorld::GetTerrainHeight(const int32 X, const int32 Y) const
+{
+	return Generator->GetTerrainHeight(X, Y, Generator->GetBiome(X, Y));
+}
+
+int32 FHeadlessVoxelWorld::GetChunkSize() const
+{
+	return Config ? Config->ChunkSize : 0;
+}
@@ -0,0 +1,49 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FVoxelGenStageTimes;
+class UGameInstance;
+class UVoxelRegistrySubsystem;
+class UWorldGenerationConfig;
+class UWorldGenerationSubsystem;
+
+/**
+ * World generation without a map or an AVoxelWorld, for commandlets. A standalone game instance brings the
+ * registry and generation subsystems up the same way they come up in game, so nothing is rendered and
+ * -nullrhi works.
+ */
+class BLOXELS_API FHeadlessVoxelWorld
+{
+public:
+	static constexpr const TCHAR* DefaultConfigPath = TEXT("/Game/Bloxels/DA_WorldGenConfig.DA_WorldGenConfig");
+
+	~FHeadlessVoxelWorld();
+
+	// Seed, when set, replaces every noise seed of a copy of the config so the asset stays untouched
+	bool Initialize(const FString& ConfigPath, TOptional<int32> Seed = {});
+	void Shutdown();
+
+	// Reads -Config= and -Seed= from a commandlet's parameters
+	bool InitializeFromCommandLine(const FString& Params);
+
+	// Safe on any thread
+	void GenerateChunk(const FIntVector& ChunkCoord, TArray<uint16>& OutVoxelData, TArray<int32>& OutSkyStart,
+		FVoxelGenStageTimes* OutStageTimes = nullptr) const;
+
+	// Terrain surface of a world column, the same height GenerateChunk uses
+	int32 GetTerrainHeight(int32 X, int32 Y) const;
+
+	int32 GetChunkSize() const;
+	UWorldGenerationConfig* GetConfig() const { return Config; }
+	UVoxelRegistrySubsystem* GetRegistry() const { return Registry; }
+	UWorldGenerationSubsystem* GetGenerator() const { return Generator; }
+
+private:
+	UGameInstance* GameInstance = nullptr;
+	UWorldGenerationConfig* Config = nullptr;
+	UVoxelRegistrySubsystem* Registry = nullptr;
+	UWorldGenerationSubsystem* Generator = nullptr;
+};
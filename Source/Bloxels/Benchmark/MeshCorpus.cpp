@@ -0,0 +1,175 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#include "MeshCorpus.h"
+
+#include "HeadlessVoxelWorld.h"
+#include "Bloxels/Voxel/Lighting/VoxelLightEngine.h"
+#include "Bloxels/Voxel/VoxelRegistry/VoxelRegistrySubsystem.h"
+#include "Bloxels/Voxel/World/WorldGenerationConfig.h"
+#include "Hash/xxhash.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace
+{
+	// Fixed so the noise chunk never changes
+	constexpr int32 NoiseSeed = 0x5EED;
+
+	// Terrain columns, in chunks. Each gives the chunk holding its surface and the one below it.
+	const FIntPoint TerrainColumns[] = { { 0, 0 }, { 3, -2 }, { -5, 4 }, { 12, 9 } };
+
+	template <typename T>
+	void HashArray(FXxHash64Builder& Builder, const TArray<T>& Array)
+	{
+		const int32 Num = Array.Num();
+		Builder.Update(&Num, sizeof(Num));
+		Builder.Update(Array.GetData(), Array.Num() * sizeof(T));
+	}
+}
+
+void MeshCorpus::BuildCorpus(const FHeadlessVoxelWorld& World, TArray<FMeshCase>& OutCases)
+{
+	const UVoxelRegistrySubsystem* Registry = World.GetRegistry();
+	const int32 ChunkSize = World.GetChunkSize();
+	const int32 VoxelCount = ChunkSize * ChunkSize * ChunkSize;
+	const uint16 Air = Registry->GetIDFromName(TEXT("Air"));
+	const uint16 Stone = Registry->GetIDFromName(TEXT("Stone"));
+
+	TArray<int32> SkyStart;
+	for (const FIntPoint& Column : TerrainColumns)
+	{
+		const int32 Center = ChunkSize / 2;
+		const int32 Height = World.GetTerrainHeight(Column.X * ChunkSize + Center, Column.Y * ChunkSize + Center);
+		const int32 SurfaceZ = FMath::FloorToInt32(static_cast<float>(Height) / ChunkSize);
+		for (const int32 Z : { SurfaceZ, SurfaceZ - 1 })
+		{
+			FMeshCase& Case = OutCases.AddDefaulted_GetRef();
+			Case.Name = FString::Printf(TEXT("terrain_%d_%d_%d"), Column.X, Column.Y, Z);
+			World.GenerateChunk(FIntVector(Column.X, Column.Y, Z), Case.VoxelData, SkyStart);
+		}
+	}
+
+	FMeshCase& Checkerboard = OutCases.AddDefaulted_GetRef();
+	Checkerboard.Name = TEXT("checkerboard");
+	Checkerboard.VoxelData.SetNumUninitialized(VoxelCount);
+	for (int32 Z = 0; Z < ChunkSize; ++Z)
+	{
+		for (int32 Y = 0; Y < ChunkSize; ++Y)
+		{
+			for (int32 X = 0; X < ChunkSize; ++X)
+			{
+				Checkerboard.VoxelData[VoxelChunkAsync::GetIndex(X, Y, Z, ChunkSize)] = (X + Y + Z) % 2 ? Stone : Air;
+			}
+		}
+	}
+
+	FMeshCase& Noise = OutCases.AddDefaulted_GetRef();
+	Noise.Name = TEXT("noise");
+	Noise.VoxelData.SetNumUninitialized(VoxelCount);
+	FRandomStream Random(NoiseSeed);
+	for (uint16& Voxel : Noise.VoxelData)
+	{
+		Voxel = Random.GetFraction() < 0.5f ? Stone : Air;
+	}
+
+	FMeshCase& Solid = OutCases.AddDefaulted_GetRef();
+	Solid.Name = TEXT("solid");
+	Solid.VoxelData.Init(Stone, VoxelCount);
+
+	FMeshCase& Single = OutCases.AddDefaulted_GetRef();
+	Single.Name = TEXT("single");
+	Single.VoxelData.Init(Air, VoxelCount);
+	Single.VoxelData[VoxelChunkAsync::GetIndex(ChunkSize / 2, ChunkSize / 2, ChunkSize / 2, ChunkSize)] = Stone;
+}
+
+FVoxelMeshContext MeshCorpus::MakeContext(const FHeadlessVoxelWorld& World)
+{
+	FVoxelMeshContext Context;
+	Context.Registry = World.GetRegistry();
+	Context.ChunkSize = World.GetChunkSize();
+	Context.VoxelSize = World.GetConfig()->VoxelSize;
+	Context.IsTransparentOutside = [](const FIntVector&) { return true; };
+	Context.GetLightOutside = [](const FIntVector&) { return VoxelLight::UnloadedLight; };
+	return Context;
+}
+
+int32 MeshCorpus::GetSectionSize(const FHeadlessVoxelWorld& World)
+{
+	const int32 ChunkSize = World.GetChunkSize();
+	const int32 RequestedSectionSize = World.GetConfig()->MeshSectionSize;
+	return (RequestedSectionSize > 0 && ChunkSize % RequestedSectionSize == 0) ? RequestedSectionSize : ChunkSize;
+}
+
+void MeshCorpus::MeshChunk(const FVoxelMeshContext& Context, const TArray<uint16>& VoxelData, const TArray<uint8>& LightData,
+	const int32 SectionSize, TArray<FSectionMeshData>& OutSections)
+{
+	const int32 SectionsPerAxis = Context.ChunkSize / SectionSize;
+	OutSections.Reset();
+	OutSections.SetNum(SectionsPerAxis * SectionsPerAxis * SectionsPerAxis);
+	for (int32 SectionIndex = 0; SectionIndex < OutSections.Num(); ++SectionIndex)
+	{
+		const FIntVector SectionMin(
+			(SectionIndex % SectionsPerAxis) * SectionSize,
+			((SectionIndex / SectionsPerAxis) % SectionsPerAxis) * SectionSize,
+			(SectionIndex / (SectionsPerAxis * SectionsPerAxis)) * SectionSize);
+
+		OutSections[SectionIndex].SectionIndex = SectionIndex;
+		VoxelChunkAsync::GenerateSectionMesh(Context, VoxelData, LightData, SectionMin, SectionSize, OutSections[SectionIndex].MeshSections);
+	}
+}
+
+uint64 MeshCorpus::HashSections(const TArray<FSectionMeshData>& Sections)
+{
+	FXxHash64Builder Builder;
+	for (const FSectionMeshData& Section : Sections)
+	{
+		Builder.Update(&Section.SectionIndex, sizeof(Section.SectionIndex));
+
+		TArray<FMeshSectionKey> Keys;
+		Section.MeshSections.GetKeys(Keys);
+		Keys.Sort([](const FMeshSectionKey& A, const FMeshSectionKey& B)
+		{
+			if (A.VoxelType != B.VoxelType) return A.VoxelType < B.VoxelType;
+			const FVector NormalA = A.GetNormal();
+			const FVector NormalB = B.GetNormal();
+			if (NormalA.X != NormalB.X) return NormalA.X < NormalB.X;
+			if (NormalA.Y != NormalB.Y) return NormalA.Y < NormalB.Y;
+			return NormalA.Z < NormalB.Z;
+		});
+
+		for (const FMeshSectionKey& Key : Keys)
+		{
+			const FMeshData& Mesh = Section.MeshSections[Key];
+			Builder.Update(&Key.VoxelType, sizeof(Key.VoxelType));
+			// Hashed as the normal, so goldens from before the axis key still match
+			const FVector Normal = Key.GetNormal();
+			Builder.Update(&Normal, sizeof(Normal));
+			HashArray(Builder, Mesh.Vertices);
+			HashArray(Builder, Mesh.Triangles);
+			HashArray(Builder, Mesh.Normals);
+			HashArray(Builder, Mesh.UVs);
+			HashArray(Builder, Mesh.VertexColors);
+		}
+	}
+	return Builder.Finalize().Hash;
+}
+
+FString MeshCorpus::GetDefaultGoldenPath()
+{
+	return FPaths::ProjectDir() / TEXT("Benchmarks/MeshGolden.csv");
+}
+
+bool MeshCorpus::LoadGolden(const FString& Path, TMap<FString, uint64>& OutGolden)
+{
+	OutGolden.Reset();
+	TArray<FString> Lines;
+	if (!FFileHelper::LoadFileToStringArray(Lines, *Path)) return false;
+
+	for (const FString& Line : Lines)
+	{
+		FString Name, Hash;
+		if (Line.StartsWith(TEXT("#")) || !Line.Split(TEXT(","), &Name, &Hash)) continue;
+		OutGolden.Add(Name.TrimStartAndEnd(), FCString::Strtoui64(*Hash.TrimStartAndEnd(), nullptr, 16));
+	}
+	return true;
+}
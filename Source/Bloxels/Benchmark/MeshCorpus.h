@@ -0,0 +1,42 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Bloxels/Voxel/Chunk/VoxelChunkAsync.h"
+
+class FHeadlessVoxelWorld;
+
+/**
+ * The fixed meshing corpus and its golden hashes, shared by -run=BloxelsMeshBench and the Bloxels.Meshing.Golden
+ * automation test. Everything beyond the chunk border reads as air at full light.
+ */
+namespace MeshCorpus
+{
+	struct FMeshCase
+	{
+		FString Name;
+		TArray<uint16> VoxelData;
+	};
+
+	// Generated terrain chunks plus checkerboard, random noise, all-solid and single-voxel chunks
+	BLOXELS_API void BuildCorpus(const FHeadlessVoxelWorld& World, TArray<FMeshCase>& OutCases);
+
+	BLOXELS_API FVoxelMeshContext MakeContext(const FHeadlessVoxelWorld& World);
+
+	// The config's section size, or the whole chunk when it doesn't divide it
+	BLOXELS_API int32 GetSectionSize(const FHeadlessVoxelWorld& World);
+
+	// Same sections a freshly loaded chunk would rebuild
+	BLOXELS_API void MeshChunk(const FVoxelMeshContext& Context, const TArray<uint16>& VoxelData, const TArray<uint8>& LightData,
+		int32 SectionSize, TArray<FSectionMeshData>& OutSections);
+
+	// Sections in key order, so the hash doesn't depend on map layout
+	BLOXELS_API uint64 HashSections(const TArray<FSectionMeshData>& Sections);
+
+	// <Project>/Benchmarks/MeshGolden.csv
+	BLOXELS_API FString GetDefaultGoldenPath();
+
+	// One "name,hash" line per case, "#" starts a comment. False when the file can't be read.
+	BLOXELS_API bool LoadGolden(const FString& Path, TMap<FString, uint64>& OutGolden);
+}
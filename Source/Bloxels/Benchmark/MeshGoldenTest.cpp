@@ -0,0 +1,62 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#include "HeadlessVoxelWorld.h"
+#include "MeshCorpus.h"
+#include "Bloxels/Voxel/Lighting/VoxelLightEngine.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+// Meshes the corpus with the default config and seed and checks every case against Benchmarks/MeshGolden.csv
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FBloxelsMeshGoldenTest, "Bloxels.Meshing.Golden",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FBloxelsMeshGoldenTest::RunTest(const FString& Parameters)
+{
+	const FString GoldenPath = MeshCorpus::GetDefaultGoldenPath();
+	TMap<FString, uint64> Golden;
+	if (!MeshCorpus::LoadGolden(GoldenPath, Golden))
+	{
+		AddError(FString::Printf(TEXT("Could not read golden hashes from %s, record them with -run=BloxelsMeshBench -UpdateGolden."), *GoldenPath));
+		return false;
+	}
+
+	FHeadlessVoxelWorld World;
+	if (!World.Initialize(FHeadlessVoxelWorld::DefaultConfigPath))
+	{
+		AddError(TEXT("Could not initialize the headless voxel world."));
+		return false;
+	}
+
+	const int32 ChunkSize = World.GetChunkSize();
+	const int32 SectionSize = MeshCorpus::GetSectionSize(World);
+	const FVoxelMeshContext Context = MeshCorpus::MakeContext(World);
+
+	TArray<MeshCorpus::FMeshCase> Cases;
+	MeshCorpus::BuildCorpus(World, Cases);
+
+	TArray<uint8> LightData;
+	LightData.Init(VoxelLight::UnloadedLight, ChunkSize * ChunkSize * ChunkSize);
+
+	TArray<FSectionMeshData> Sections;
+	for (const MeshCorpus::FMeshCase& Case : Cases)
+	{
+		MeshCorpus::MeshChunk(Context, Case.VoxelData, LightData, SectionSize, Sections);
+		const uint64 Hash = MeshCorpus::HashSections(Sections);
+
+		const uint64* Expected = Golden.Find(Case.Name);
+		if (!Expected)
+		{
+			AddError(FString::Printf(TEXT("%s has no golden hash."), *Case.Name));
+			continue;
+		}
+		if (*Expected != Hash)
+		{
+			AddError(FString::Printf(TEXT("%s hashes to %016llx, golden is %016llx."), *Case.Name, Hash, *Expected));
+		}
+	}
+
+	return !HasAnyErrors();
+}
+
+#endif
@@ -3,9 +3,12 @@
 #include "Bloxels/Player/Commands/BloxelsCheatManager.h"
 
 #include "DebugSubsystem.h"
+#include "Bloxels/Benchmark/FlyThroughBenchmarkSubsystem.h"
 #include "Bloxels/Player/FreeCamera/FreeCameraPawn.h"
 #include "Bloxels/Voxel/PathFinding/PathfindingSubsystem.h"
 #include "Bloxels/Voxel/Chunk/VoxelChunk.h"
+#include "Bloxels/Voxel/Chunk/VoxelJobScheduler.h"
+#include "Bloxels/Voxel/Structure/VoxelStructureFile.h"
 #include "Bloxels/Voxel/World/WorldGenerationConfig.h"
 #include "Kismet/GameplayStatics.h"
 
@@ -57,81 +60,58 @@ void UBloxelsCheatManager::ExportSelection(const FString& FileName)
     UDebugSubsystem* Debug = GetWorld()->GetGameInstance()->GetSubsystem<UDebugSubsystem>();
     if (!Debug) return;
 
-    FVector Pos1 = Debug->Position1;
-    FVector Pos2 = Debug->Position2;
-    FVector Origin = Debug->Position3;
-
-    const FVector MinVec = FVector::Min(Pos1, Pos2).GridSnap(100);
-    const FVector MaxVec = FVector::Max(Pos1, Pos2).GridSnap(100);
-    const FVector OriginVec = Origin.GridSnap(100);
-
-    const FIntVector Min(
-        FMath::RoundToInt(MinVec.X),
-        FMath::RoundToInt(MinVec.Y),
-        FMath::RoundToInt(MinVec.Z));
+    AVoxelWorld* World = Cast<AVoxelWorld>(UGameplayStatics::GetActorOfClass(GetWorld(), AVoxelWorld::StaticClass()));
+    if (!World) return;
 
-    const FIntVector Max(
-        FMath::RoundToInt(MaxVec.X),
-        FMath::RoundToInt(MaxVec.Y),
-        FMath::RoundToInt(MaxVec.Z));
+    FIntVector Min, Max;
+    GetSelectionBounds(Debug, Min, Max);
+    const FIntVector Origin = ToVoxelCoord(Debug->Position3);
 
-    const FIntVector OriginSnapped(
-        FMath::RoundToInt(OriginVec.X),
-        FMath::RoundToInt(OriginVec.Y),
-        FMath::RoundToInt(OriginVec.Z));
+    const UVoxelRegistrySubsystem* Registry = World->GetVoxelRegistry();
+    const uint16 AirID = Registry->GetIDFromName("Air");
 
-    AVoxelWorld* World = Cast<AVoxelWorld>(UGameplayStatics::GetActorOfClass(GetWorld(), AVoxelWorld::StaticClass()));
-    if (!World) return;
+    FVoxelStructure Structure;
+    Structure.Min = Min - Origin;
+    Structure.Size = Max - Min + FIntVector(1);
+    Structure.Palette.Add(NAME_None);
+    Structure.Cells.Init(0, Structure.GetNumCells());
 
-    FString Output = TEXT("{ \"Voxels\": [\n");
+    // Voxel IDs are resolved to palette entries once per type instead of once per voxel
+    TMap<uint16, uint16> VoxelToPalette;
     int32 ExportedCount = 0;
-    
-    for (int32 X = Min.X; X <= Max.X; X += 100)
-        for (int32 Y = Min.Y; Y <= Max.Y; Y += 100)
-            for (int32 Z = Min.Z; Z <= Max.Z; Z += 100)
-            {
-                int VoxelID = World->GetVoxelAtWorldCoordinates((X - 100) / 100, (Y - 100) / 100, (Z - 100) / 100);
-
-                if (VoxelID == World->GetVoxelRegistry()->GetIDFromName("Air")) continue; // Skip air
 
-                FName Name = World->GetVoxelRegistry()->GetNameFromID(VoxelID);
-                FIntVector Offset = FIntVector(X, Y, Z) - OriginSnapped;
+    for (int32 Z = 0; Z < Structure.Size.Z; Z++)
+        for (int32 Y = 0; Y < Structure.Size.Y; Y++)
+            for (int32 X = 0; X < Structure.Size.X; X++)
+            {
+                const uint16 VoxelID = World->GetVoxelAtWorldCoordinates(Min.X + X, Min.Y + Y, Min.Z + Z);
+                if (VoxelID == AirID) continue; // Skip air
 
-                Output += FString::Printf(TEXT("{\"Offset\":[%d,%d,%d],\"ID\":\"%s\"},\n"),
-                    Offset.X / 100, Offset.Y / 100, Offset.Z / 100, *Name.ToString());
+                uint16* PaletteIndex = VoxelToPalette.Find(VoxelID);
+                if (!PaletteIndex)
+                {
+                    PaletteIndex = &VoxelToPalette.Add(VoxelID, static_cast<uint16>(Structure.Palette.Num()));
+                    Structure.Palette.Add(Registry->GetNameFromID(VoxelID));
+                }
 
+                Structure.Cells[Structure.GetIndex(X, Y, Z)] = *PaletteIndex;
                 ExportedCount++;
             }
 
-    Output.RemoveFromEnd(TEXT(",\n")); // remove trailing comma
-    Output += TEXT("\n]}\n");
-
-    FFileHelper::SaveStringToFile(Output, *(FPaths::ProjectSavedDir() + FileName + ".blxl"));
+    if (!VoxelStructureFile::Save(FPaths::ProjectSavedDir() + FileName + ".blxl", Structure))
+    {
+        UE_LOG(LogTemp, Error, TEXT("ExportSelection: Failed to write %s.blxl"), *FileName);
+        return;
+    }
 
-    FFileHelper::SaveStringToFile(Output, *(FPaths::ProjectSavedDir() + FileName + ".blxl"));
     UE_LOG(LogTemp, Log, TEXT("ExportSelection complete: %d voxels exported."), ExportedCount);
 }
 
 
 void UBloxelsCheatManager::ImportStructure(const FString& FileName)
 {
-    FString Input;
     const FString FullPath = FPaths::ProjectSavedDir() + FileName + ".blxl";
     UE_LOG(LogTemp, Log, TEXT("ImportStructure: Loading from %s"), *FullPath);
-    
-    if (!FFileHelper::LoadFileToString(Input, *FullPath))
-    {
-        UE_LOG(LogTemp, Error, TEXT("ImportStructure: Failed to load file to string"));
-        return;
-    }
-    
-    TSharedPtr<FJsonObject> Root;
-    TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Input);
-    if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
-    {
-        UE_LOG(LogTemp, Error, TEXT("ImportStructure: Failed to deserialize JSON structure."));
-        return;
-    }
 
     UDebugSubsystem* Debug = GetWorld()->GetGameInstance()->GetSubsystem<UDebugSubsystem>();
     if (!Debug) return;
@@ -139,78 +119,149 @@ void UBloxelsCheatManager::ImportStructure(const FString& FileName)
     AVoxelWorld* World = Cast<AVoxelWorld>(UGameplayStatics::GetActorOfClass(GetWorld(), AVoxelWorld::StaticClass()));
     if (!World) return;
 
-    FVector SnappedOrigin = Debug->Position3.GridSnap(100) / 100.0f;
-    FIntVector Origin = FIntVector(FMath::RoundToInt(SnappedOrigin.X), FMath::RoundToInt(SnappedOrigin.Y), FMath::RoundToInt(SnappedOrigin.Z));
+    const FIntVector Origin = ToVoxelCoord(Debug->Position3);
+    const UVoxelRegistrySubsystem* Registry = World->GetVoxelRegistry();
 
+    TArray<uint16> PaletteToVoxel;
+    auto ResolvePalette = [&PaletteToVoxel, Registry](const TArray<FName>& Palette)
+    {
+        PaletteToVoxel.SetNum(Palette.Num());
+        for (int32 i = 0; i < Palette.Num(); ++i)
+        {
+            const FName Name = Palette[i] == TEXT("AirForced") ? FName(TEXT("Air")) : Palette[i];
+            PaletteToVoxel[i] = Registry->GetIDFromName(Name);
+        }
+    };
 
-    const TArray<TSharedPtr<FJsonValue>> Voxels = Root->GetArrayField(TEXT("Voxels"));
-    UE_LOG(LogTemp, Log, TEXT("ImportStructure: Found %d voxel entries"), Voxels.Num());
-
-    TSet<FIntVector> AffectedChunks;
-    
+    TArray<FVoxelEdit> Edits;
     int32 ImportedCount = 0;
 
-    for (const TSharedPtr<FJsonValue>& VoxelVal : Voxels)
+    auto PlaceCells = [&](const FIntVector& BlockMin, const FIntVector& BlockSize, const TArray<uint16>& Cells)
     {
-        TSharedPtr<FJsonObject> VoxelObj = VoxelVal->AsObject();
-        const TArray<TSharedPtr<FJsonValue>>& OffsetArr = VoxelObj->GetArrayField(TEXT("Offset"));
+        Edits.Reset();
+        for (int32 Z = 0; Z < BlockSize.Z; ++Z)
+            for (int32 Y = 0; Y < BlockSize.Y; ++Y)
+                for (int32 X = 0; X < BlockSize.X; ++X)
+                {
+                    const uint16 PaletteIndex = Cells[(Z * BlockSize.Y * BlockSize.X) + (Y * BlockSize.X) + X];
+                    if (PaletteIndex == 0) continue;
 
-        if (OffsetArr.Num() != 3)
-        {
-            UE_LOG(LogTemp, Warning, TEXT("ImportStructure: Skipping malformed Offset array."));
-            continue;
-        }
+                    Edits.Emplace(Origin + BlockMin + FIntVector(X, Y, Z), PaletteToVoxel[PaletteIndex]);
+                }
 
-        FIntVector Offset(
-            OffsetArr[0]->AsNumber(),
-            OffsetArr[1]->AsNumber(),
-            OffsetArr[2]->AsNumber()
-        );
+        World->SetVoxels(Edits);
+        ImportedCount += Edits.Num();
+    };
 
-        FIntVector WorldVoxelPos = Origin + Offset;
-        FName IDName = FName(VoxelObj->GetStringField(TEXT("ID")));
+    // Every block writes straight into chunk storage; touched chunks are remeshed once when the batch commits
+    World->BeginEditBatch();
 
-        if (IDName == TEXT("AirForced"))
+    if (VoxelStructureFile::IsBinaryFile(FullPath))
+    {
+        // Stream the payload one block at a time so large prefabs never need a full in-memory copy
+        FVoxelStructureReader Reader;
+        if (!Reader.Open(FullPath))
         {
-            IDName = TEXT("Air");
+            UE_LOG(LogTemp, Error, TEXT("ImportStructure: Failed to open binary structure."));
+            World->CommitEditBatch();
+            return;
         }
-        
-        uint16 BlockID = World->GetVoxelRegistry()->GetIDFromName(IDName);
 
-        UE_LOG(LogTemp, Verbose, TEXT("Importing voxel: Offset=(%d,%d,%d) -> World=(%d,%d,%d), ID=%s"),
-            Offset.X, Offset.Y, Offset.Z,
-            WorldVoxelPos.X, WorldVoxelPos.Y, WorldVoxelPos.Z,
-            *IDName.ToString());
+        UE_LOG(LogTemp, Log, TEXT("ImportStructure: Found %d voxel entries"), Reader.GetNonEmptyCount());
+        ResolvePalette(Reader.GetPalette());
 
-        
-        World->PlaceBlock(WorldVoxelPos.X - 1, WorldVoxelPos.Y - 1, WorldVoxelPos.Z - 1, BlockID);
+        FVoxelStructureBlock Block;
+        while (Reader.ReadNextBlock(Block))
+        {
+            if (Block.NonEmptyCount > 0)
+            {
+                PlaceCells(Block.Min, Block.Size, Block.Cells);
+            }
+        }
 
-        const int ChunkSize = World->GetWorldGenerationConfig()->ChunkSize;
-        
-        // Track affected chunk
-        FIntVector ChunkCoord(
-            FMath::FloorToInt(static_cast<float>(WorldVoxelPos.X) / ChunkSize),
-            FMath::FloorToInt(static_cast<float>(WorldVoxelPos.Y) / ChunkSize),
-            FMath::FloorToInt(static_cast<float>(WorldVoxelPos.Z) / ChunkSize)
-        );
-        AffectedChunks.Add(ChunkCoord);
-        ImportedCount++;
+        if (Reader.HasError())
+        {
+            UE_LOG(LogTemp, Error, TEXT("ImportStructure: Structure payload is corrupt, import stopped early."));
+        }
     }
-
-    // Regenerate all affected chunks
-    for (const FIntVector& Coord : AffectedChunks)
+    else
     {
-        if (World->Chunks.Contains(Coord))
+        // Legacy JSON structures
+        FVoxelStructure Structure;
+        if (!VoxelStructureFile::LoadLegacyJson(FullPath, Structure))
         {
-            if (AVoxelChunk* Chunk = World->Chunks[Coord])
-            {
-                Chunk->TryGenerateChunkMesh();
-            }
+            UE_LOG(LogTemp, Error, TEXT("ImportStructure: Failed to load legacy JSON structure."));
+            World->CommitEditBatch();
+            return;
         }
+
+        ResolvePalette(Structure.Palette);
+        PlaceCells(Structure.Min, Structure.Size, Structure.Cells);
     }
+
+    const int32 RemeshedCount = World->CommitEditBatch();
     
     UE_LOG(LogTemp, Log, TEXT("ImportStructure complete: %d voxels imported."), ImportedCount);
-    UE_LOG(LogTemp, Log, TEXT("Chunks regenerated: %d"), AffectedChunks.Num());
+    UE_LOG(LogTemp, Log, TEXT("Chunks regenerated: %d"), RemeshedCount);
+}
+
+void UBloxelsCheatManager::PlaceStructure(const FString& FileName)
+{
+    UDebugSubsystem* Debug = GetWorld()->GetGameInstance()->GetSubsystem<UDebugSubsystem>();
+    if (!Debug) return;
+
+    UWorldGenerationSubsystem* Generator = GetWorld()->GetGameInstance()->GetSubsystem<UWorldGenerationSubsystem>();
+    if (!Generator) return;
+
+    Generator->LoadStructureAt(FileName, ToVoxelCoord(Debug->Position3));
+}
+
+void UBloxelsCheatManager::FillSelection(const FString& BlockName)
+{
+    UDebugSubsystem* Debug = GetWorld()->GetGameInstance()->GetSubsystem<UDebugSubsystem>();
+    AVoxelWorld* World = Cast<AVoxelWorld>(UGameplayStatics::GetActorOfClass(GetWorld(), AVoxelWorld::StaticClass()));
+    if (!Debug || !World) return;
+
+    FIntVector Min, Max;
+    GetSelectionBounds(Debug, Min, Max);
+
+    const int32 Count = World->FillBox(Min, Max, World->GetVoxelRegistry()->GetIDFromName(FName(BlockName)));
+    UE_LOG(LogTemp, Log, TEXT("FillSelection: %d voxels set to %s"), Count, *BlockName);
+}
+
+void UBloxelsCheatManager::ReplaceSelection(const FString& FromBlockName, const FString& ToBlockName)
+{
+    UDebugSubsystem* Debug = GetWorld()->GetGameInstance()->GetSubsystem<UDebugSubsystem>();
+    AVoxelWorld* World = Cast<AVoxelWorld>(UGameplayStatics::GetActorOfClass(GetWorld(), AVoxelWorld::StaticClass()));
+    if (!Debug || !World) return;
+
+    FIntVector Min, Max;
+    GetSelectionBounds(Debug, Min, Max);
+
+    const UVoxelRegistrySubsystem* Registry = World->GetVoxelRegistry();
+    const int32 Count = World->ReplaceInBox(Min, Max, Registry->GetIDFromName(FName(FromBlockName)), Registry->GetIDFromName(FName(ToBlockName)));
+    UE_LOG(LogTemp, Log, TEXT("ReplaceSelection: %d %s voxels replaced with %s"), Count, *FromBlockName, *ToBlockName);
+}
+
+void UBloxelsCheatManager::BrushSphere(int32 Radius, const FString& BlockName)
+{
+    AVoxelWorld* World = Cast<AVoxelWorld>(UGameplayStatics::GetActorOfClass(GetWorld(), AVoxelWorld::StaticClass()));
+    if (!World) return;
+
+    const FIntVector Center = ToVoxelCoord(GetLookAt(false));
+    const int32 Count = World->FillSphere(Center, Radius, World->GetVoxelRegistry()->GetIDFromName(FName(BlockName)));
+    UE_LOG(LogTemp, Log, TEXT("BrushSphere: %d voxels set to %s around %s"), Count, *BlockName, *Center.ToString());
+}
+
+void UBloxelsCheatManager::BrushBox(int32 HalfExtent, const FString& BlockName)
+{
+    AVoxelWorld* World = Cast<AVoxelWorld>(UGameplayStatics::GetActorOfClass(GetWorld(), AVoxelWorld::StaticClass()));
+    if (!World) return;
+
+    const FIntVector Center = ToVoxelCoord(GetLookAt(false));
+    const int32 Count = World->FillBox(Center - FIntVector(HalfExtent), Center + FIntVector(HalfExtent),
+        World->GetVoxelRegistry()->GetIDFromName(FName(BlockName)));
+    UE_LOG(LogTemp, Log, TEXT("BrushBox: %d voxels set to %s around %s"), Count, *BlockName, *Center.ToString());
 }
 
 
@@ -248,6 +299,81 @@ void UBloxelsCheatManager::ClearPathEnd()
     }
 }
 
+void UBloxelsCheatManager::PathBenchmark(int32 Iterations, const FString& Mode, const int32 MaxExpansions)
+{
+    FPathSearchParams Params;
+    if (!ParseSearchMode(Mode, Params))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("PathBenchmark: Unknown mode '%s'."), *Mode);
+        return;
+    }
+
+    UPathfindingSubsystem* PathfindingSubsystem = GetWorld()->GetGameInstance()->GetSubsystem<UPathfindingSubsystem>();
+    UPathfindingManager* Manager = PathfindingSubsystem ? PathfindingSubsystem->GetPathfindingManager() : nullptr;
+    const APlayerController* PC = GetOuterAPlayerController();
+    if (!Manager || !PC || !PC->GetPawn())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("PathBenchmark: No pathfinding manager or player pawn."));
+        return;
+    }
+
+    Iterations = FMath::Max(1, Iterations);
+    Params.MaxExpansions = FMath::Max(0, MaxExpansions);
+    Params.bAllowPartial = Params.MaxExpansions > 0;
+    const FIntVector Center = ToVoxelCoord(PC->GetPawn()->GetActorLocation());
+
+    // Horizontal offsets from the player; the Z of each endpoint is the first standable voxel in its column
+    static const FIntPoint Pairs[][2] = {
+        { FIntPoint(0, 0),    FIntPoint(24, 0) },
+        { FIntPoint(0, 0),    FIntPoint(0, -24) },
+        { FIntPoint(-16, -16), FIntPoint(16, 16) },
+        { FIntPoint(-30, 8),  FIntPoint(30, -8) },
+        { FIntPoint(10, -28), FIntPoint(-12, 30) },
+        { FIntPoint(-40, 0),  FIntPoint(40, 0) },
+    };
+
+    int64 TotalExpanded = 0;
+    double TotalSeconds = 0.0;
+
+    for (int32 PairIndex = 0; PairIndex < UE_ARRAY_COUNT(Pairs); ++PairIndex)
+    {
+        FIntVector Start, End;
+        const FIntPoint StartXY = Pairs[PairIndex][0] + FIntPoint(Center.X, Center.Y);
+        const FIntPoint EndXY = Pairs[PairIndex][1] + FIntPoint(Center.X, Center.Y);
+        if (!Manager->FindWalkableInColumn(StartXY.X, StartXY.Y, Center.Z + 64, Center.Z - 128, Start) ||
+            !Manager->FindWalkableInColumn(EndXY.X, EndXY.Y, Center.Z + 64, Center.Z - 128, End))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("PathBenchmark: Pair %d has no standable endpoint, skipped."), PairIndex);
+            continue;
+        }
+
+        TArray<FVector> Path;
+        FPathfindingStats Stats;
+        double PairSeconds = 0.0;
+        bool bFound = false;
+        Params.Start = Start;
+        Params.End = End;
+        for (int32 Iteration = 0; Iteration < Iterations; ++Iteration)
+        {
+            bFound = Manager->FindPath(Params, Path, Stats);
+            PairSeconds += Stats.Seconds;
+        }
+
+        TotalExpanded += static_cast<int64>(Stats.NodesExpanded) * Iterations;
+        TotalSeconds += PairSeconds;
+
+        UE_LOG(LogTemp, Log, TEXT("PathBenchmark: %s -> %s %s, expanded %d, cost %.1f, %.3f ms avg"),
+            *Start.ToString(), *End.ToString(), bFound ? TEXT("found") : Stats.bPartial ? TEXT("partial") : TEXT("failed"),
+            Stats.NodesExpanded, Stats.PathCost, PairSeconds * 1000.0 / Iterations);
+    }
+
+    if (TotalSeconds > 0.0)
+    {
+        UE_LOG(LogTemp, Log, TEXT("PathBenchmark: %lld nodes expanded in %.3f ms, %.0f nodes/sec"),
+            TotalExpanded, TotalSeconds * 1000.0, TotalExpanded / TotalSeconds);
+    }
+}
+
 void UBloxelsCheatManager::GiveBlock(const FString& BlockName) const
 {
     if (const APlayerController* PC = GetOuterAPlayerController())
@@ -268,6 +394,49 @@ void UBloxelsCheatManager::SetPosition(int32 Index, const FVector& Pos)
     }
 }
 
+FIntVector UBloxelsCheatManager::ToVoxelCoord(const FVector& SelectionPos)
+{
+    return FIntVector(
+        FMath::FloorToInt(SelectionPos.X / 100.f),
+        FMath::FloorToInt(SelectionPos.Y / 100.f),
+        FMath::FloorToInt(SelectionPos.Z / 100.f));
+}
+
+void UBloxelsCheatManager::GetSelectionBounds(const UDebugSubsystem* Debug, FIntVector& OutMin, FIntVector& OutMax)
+{
+    const FIntVector Pos1 = ToVoxelCoord(Debug->Position1);
+    const FIntVector Pos2 = ToVoxelCoord(Debug->Position2);
+
+    OutMin = FIntVector(FMath::Min(Pos1.X, Pos2.X), FMath::Min(Pos1.Y, Pos2.Y), FMath::Min(Pos1.Z, Pos2.Z));
+    OutMax = FIntVector(FMath::Max(Pos1.X, Pos2.X), FMath::Max(Pos1.Y, Pos2.Y), FMath::Max(Pos1.Z, Pos2.Z));
+}
+
+bool UBloxelsCheatManager::ParseSearchMode(const FString& Name, FPathSearchParams& OutParams)
+{
+    if (Name.Equals(TEXT("AStar"), ESearchCase::IgnoreCase))
+    {
+        OutParams.Mode = EPathSearchMode::AStar;
+        return true;
+    }
+    if (Name.Equals(TEXT("Bidirectional"), ESearchCase::IgnoreCase) || Name.Equals(TEXT("BiAStar"), ESearchCase::IgnoreCase))
+    {
+        OutParams.Mode = EPathSearchMode::AStar;
+        OutParams.bBidirectional = true;
+        return true;
+    }
+    if (Name.Equals(TEXT("Hierarchical"), ESearchCase::IgnoreCase) || Name.Equals(TEXT("HPA"), ESearchCase::IgnoreCase))
+    {
+        OutParams.Mode = EPathSearchMode::Hierarchical;
+        return true;
+    }
+    if (Name.Equals(TEXT("JumpPoint"), ESearchCase::IgnoreCase) || Name.Equals(TEXT("JPS"), ESearchCase::IgnoreCase))
+    {
+        OutParams.Mode = EPathSearchMode::JumpPoint;
+        return true;
+    }
+    return false;
+}
+
 FVector UBloxelsCheatManager::GetLookAt(bool bReturnNormal)
 {
     APlayerController* PC = GetOuterAPlayerController();
@@ -308,16 +477,127 @@ FVector UBloxelsCheatManager::GetLookAt(bool bReturnNormal)
 
 void UBloxelsCheatManager::GeneratePathDebug(UDebugSubsystem* Debug)
 {
-    TArray<FVector> Path;
     if (UPathfindingSubsystem* PathfindingSubsystem = GetWorld()->GetGameInstance()->GetSubsystem<UPathfindingSubsystem>())
     {
-        if (PathfindingSubsystem->GetPathfindingManager()->FindPath(Debug->PathStart, Debug->PathEnd, Path))
-        {
-            Debug->SetDebugPath(Path);
-        }
-        else
-        {
-            Debug->ClearDebugPath();
-        }
+        // Only the latest start/end pair matters
+        PathfindingSubsystem->CancelPath(DebugPathRequest);
+
+        TWeakObjectPtr<UDebugSubsystem> WeakDebug(Debug);
+        DebugPathRequest = PathfindingSubsystem->RequestPath(Debug->PathStart, Debug->PathEnd, EPathRequestPriority::High,
+            FOnPathRequestComplete::CreateLambda([WeakDebug](FPathRequestHandle, const FPathResult& Result)
+            {
+                if (!WeakDebug.IsValid()) return;
+
+                if (Result.Status == EPathRequestStatus::Succeeded || Result.Status == EPathRequestStatus::Partial)
+                {
+                    WeakDebug->SetDebugPath(Result.PathPoints);
+                }
+                else
+                {
+                    WeakDebug->ClearDebugPath();
+                }
+            }));
+    }
+}
+
+void UBloxelsCheatManager::PathQueueStats()
+{
+    if (const UPathfindingSubsystem* PathfindingSubsystem = GetWorld()->GetGameInstance()->GetSubsystem<UPathfindingSubsystem>())
+    {
+        const FPathQueueStats Stats = PathfindingSubsystem->GetQueueStats();
+        UE_LOG(LogTemp, Log, TEXT("PathQueueStats: queued %d, running %d, awaiting %d, completed %lld, cancelled %lld"),
+            Stats.Queued, Stats.Running, Stats.AwaitingDelivery, Stats.Completed, Stats.Cancelled);
+        UE_LOG(LogTemp, Log, TEXT("PathQueueStats: queue latency avg %.2f ms, p95 %.2f ms, max %.2f ms"),
+            Stats.AvgQueueMs, Stats.P95QueueMs, Stats.MaxQueueMs);
+        UE_LOG(LogTemp, Log, TEXT("PathQueueStats: request to delivery avg %.2f ms, p95 %.2f ms, max %.2f ms"),
+            Stats.AvgTotalMs, Stats.P95TotalMs, Stats.MaxTotalMs);
+    }
+}
+
+void UBloxelsCheatManager::ChunkLatency()
+{
+    if (const AVoxelWorld* VoxelWorld = Cast<AVoxelWorld>(UGameplayStatics::GetActorOfClass(GetWorld(), AVoxelWorld::StaticClass())))
+    {
+        VoxelWorld->LogChunkLatency();
+    }
+}
+
+void UBloxelsCheatManager::ChunkLatencyCsv(const FString& FileName)
+{
+    const AVoxelWorld* VoxelWorld = Cast<AVoxelWorld>(UGameplayStatics::GetActorOfClass(GetWorld(), AVoxelWorld::StaticClass()));
+    if (!VoxelWorld) return;
+
+    const FString Path = FPaths::ProjectSavedDir() / TEXT("Telemetry") / FileName + TEXT(".csv");
+    if (VoxelWorld->ExportChunkLatencyCsv(Path))
+    {
+        UE_LOG(LogTemp, Log, TEXT("ChunkLatency: written to %s"), *Path);
+    }
+    else
+    {
+        UE_LOG(LogTemp, Error, TEXT("ChunkLatency: could not write %s"), *Path);
+    }
+}
+
+void UBloxelsCheatManager::ChunkLatencyReset()
+{
+    if (AVoxelWorld* VoxelWorld = Cast<AVoxelWorld>(UGameplayStatics::GetActorOfClass(GetWorld(), AVoxelWorld::StaticClass())))
+    {
+        VoxelWorld->ResetChunkLatency();
+    }
+}
+
+void UBloxelsCheatManager::FlyThroughRecord()
+{
+    if (UFlyThroughBenchmarkSubsystem* FlyThrough = GetWorld()->GetSubsystem<UFlyThroughBenchmarkSubsystem>())
+    {
+        FlyThrough->StartRecording();
+        UE_LOG(LogTemp, Log, TEXT("FlyThrough: recording, FlyThroughSave <Name> to stop"));
+    }
+}
+
+void UBloxelsCheatManager::FlyThroughSave(const FString& FileName)
+{
+    UFlyThroughBenchmarkSubsystem* FlyThrough = GetWorld()->GetSubsystem<UFlyThroughBenchmarkSubsystem>();
+    if (!FlyThrough || !FlyThrough->IsRecording())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("FlyThrough: not recording"));
+        return;
+    }
+
+    const FString Path = FPaths::ProjectSavedDir() / TEXT("FlyThrough") / FileName + TEXT(".csv");
+    if (FlyThrough->StopRecording(Path))
+    {
+        UE_LOG(LogTemp, Log, TEXT("FlyThrough: path written to %s"), *Path);
+    }
+    else
+    {
+        UE_LOG(LogTemp, Error, TEXT("FlyThrough: could not write %s, or fewer than two points were recorded"), *Path);
+    }
+}
+
+void UBloxelsCheatManager::ChunkMemory(const int32 TopN)
+{
+    if (const AVoxelWorld* VoxelWorld = Cast<AVoxelWorld>(UGameplayStatics::GetActorOfClass(GetWorld(), AVoxelWorld::StaticClass())))
+    {
+        VoxelWorld->LogChunkMemory(FMath::Max(0, TopN));
+    }
+}
+
+void UBloxelsCheatManager::VoxelJobStats()
+{
+    const AVoxelWorld* VoxelWorld = Cast<AVoxelWorld>(UGameplayStatics::GetActorOfClass(GetWorld(), AVoxelWorld::StaticClass()));
+    const TSharedPtr<FVoxelJobScheduler> Scheduler = VoxelWorld ? VoxelWorld->GetJobScheduler() : nullptr;
+    if (!Scheduler) return;
+
+    const FVoxelJobStats Stats = Scheduler->GetStats();
+    UE_LOG(LogTemp, Log, TEXT("VoxelJobStats: %d slots, generation queued %d running %d done %lld, meshing queued %d running %d done %lld, %lld borrowed slots"),
+        Stats.MaxInFlight,
+        Stats.Queued[0], Stats.Running[0], Stats.Completed[0],
+        Stats.Queued[1], Stats.Running[1], Stats.Completed[1], Stats.Stolen);
+
+    for (const TPair<uint32, double>& Thread : Stats.ThreadBusySeconds)
+    {
+        UE_LOG(LogTemp, Log, TEXT("VoxelJobStats: thread %u busy %.2f s, %.1f%% of %.1f s"),
+            Thread.Key, Thread.Value, Stats.WallSeconds > 0.0 ? 100.0 * Thread.Value / Stats.WallSeconds : 0.0, Stats.WallSeconds);
     }
 }
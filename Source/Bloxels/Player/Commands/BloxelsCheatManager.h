@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/CheatManager.h"
+#include "Bloxels/Voxel/PathFinding/PathfindingSubsystem.h"
 #include "BloxelsCheatManager.generated.h"
 
 class UDebugSubsystem;
@@ -39,6 +40,23 @@ public:
 	UFUNCTION(Exec)
 	void ImportStructure(const FString& FileName);
 
+	// Places the structure at selection 3 through world generation: loaded chunks are patched, the rest stamp it as they generate
+	UFUNCTION(Exec)
+	void PlaceStructure(const FString& FileName);
+
+	// Brushes
+	UFUNCTION(Exec)
+	void FillSelection(const FString& BlockName);
+
+	UFUNCTION(Exec)
+	void ReplaceSelection(const FString& FromBlockName, const FString& ToBlockName);
+
+	UFUNCTION(Exec)
+	void BrushSphere(int32 Radius, const FString& BlockName);
+
+	UFUNCTION(Exec)
+	void BrushBox(int32 HalfExtent, const FString& BlockName);
+
 	// Pathfinding Commands
 	UFUNCTION(Exec)
 	void SetPathStartLookAt(bool bOffset = false);
@@ -52,6 +70,42 @@ public:
 	UFUNCTION(Exec)
 	void ClearPathEnd();
 
+	// Runs a fixed set of start/end pairs around the player and reports expanded nodes per second.
+	// Mode is AStar, Bidirectional, Hierarchical or JumpPoint. MaxExpansions caps A* searches, 0 for no cap.
+	UFUNCTION(Exec)
+	void PathBenchmark(int32 Iterations = 5, const FString& Mode = TEXT("AStar"), int32 MaxExpansions = 0);
+
+	// Logs async path request queue depth and latency
+	UFUNCTION(Exec)
+	void PathQueueStats();
+
+	// Streaming latency per chunk lifecycle stage, p50/p95/p99
+	UFUNCTION(Exec)
+	void ChunkLatency();
+
+	// Writes the recorded chunk lifecycles to Saved/Telemetry/<FileName>.csv
+	UFUNCTION(Exec)
+	void ChunkLatencyCsv(const FString& FileName = TEXT("ChunkLatency"));
+
+	UFUNCTION(Exec)
+	void ChunkLatencyReset();
+
+	// Voxel job queue depth, completions, lane borrowing and per-thread utilisation
+	UFUNCTION(Exec)
+	void VoxelJobStats();
+
+	// Chunk memory by category and the TopN heaviest chunks
+	UFUNCTION(Exec)
+	void ChunkMemory(int32 TopN = 10);
+
+	// Samples the camera path for the fly-through benchmark
+	UFUNCTION(Exec)
+	void FlyThroughRecord();
+
+	// Stops sampling and writes the path to Saved/FlyThrough/<FileName>.csv, for -FlyThroughPath=
+	UFUNCTION(Exec)
+	void FlyThroughSave(const FString& FileName);
+
 	// Give Block!
 	UFUNCTION(Exec)
 	void GiveBlock(const FString& BlockName) const;
@@ -60,8 +114,15 @@ private:
 	// Block Selection Helpers
 	void SetPosition(int32 Index, const FVector& Pos);
 
+	// Converts a selection position (voxel centre in world units) to voxel coordinates
+	static FIntVector ToVoxelCoord(const FVector& SelectionPos);
+	static void GetSelectionBounds(const UDebugSubsystem* Debug, FIntVector& OutMin, FIntVector& OutMax);
+
 	// Pathfinding Helpers
 	FVector GetLookAt(bool bReturnNormal);
 
 	void GeneratePathDebug(UDebugSubsystem* Debug);
+	static bool ParseSearchMode(const FString& Name, FPathSearchParams& OutParams);
+
+	FPathRequestHandle DebugPathRequest;
 };
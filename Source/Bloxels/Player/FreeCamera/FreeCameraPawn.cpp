@@ -30,6 +30,14 @@ void AFreeCameraPawn::SetCurrentBlock(const FName BlockName)
     CurrentBlock = BlockName;
 }
 
+void AFreeCameraPawn::SetView(const FVector& Location, const FRotator& Rotation)
+{
+    SetActorLocation(Location);
+    Pitch = FMath::Clamp(static_cast<float>(Rotation.Pitch), -89.f, 89.f);
+    Yaw = static_cast<float>(Rotation.Yaw);
+    Camera->SetWorldRotation(FRotator(Pitch, Yaw, 0.f));
+}
+
 void AFreeCameraPawn::BeginPlay()
 {
     Super::BeginPlay();
@@ -20,6 +20,9 @@ public:
 
 	void SetCurrentBlock(const FName BlockName);
 
+	// Moves and turns the camera directly, for scripted flights
+	void SetView(const FVector& Location, const FRotator& Rotation);
+
 protected:
 	virtual void BeginPlay() override;
 	virtual void SetupPlayerInputComponent(UInputComponent* PlayerInputComponent) override;
@@ -0,0 +1,52 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// FPlatformTime::Seconds() of a chunk's first pass through each stage, 0 until it gets there
+struct FChunkLifecycle
+{
+	double Requested = 0.0;        // A mesh was wanted: spawned in view, or promoted from a neighbour-only chunk
+	double DataGenerated = 0.0;
+	double NeighboursReady = 0.0;  // The first mesh job started, its own and its neighbours' data tasks done
+	double MeshDone = 0.0;
+	double Displayed = 0.0;
+};
+
+namespace ChunkLifecycle
+{
+	enum EStage : uint8
+	{
+		Data,        // Requested to data generated
+		Neighbours,  // Own data to neighbours ready
+		Mesh,        // Neighbours ready to mesh applied
+		Display,     // Mesh applied to visible
+		Total,       // Requested to visible
+		NumStages
+	};
+
+	inline const TCHAR* GetStageName(const int32 Stage)
+	{
+		static const TCHAR* Names[] = { TEXT("data"), TEXT("neighbours"), TEXT("mesh"), TEXT("display"), TEXT("total") };
+		return Stage >= 0 && Stage < NumStages ? Names[Stage] : TEXT("unknown");
+	}
+
+	// Milliseconds spent in Stage. Chunks promoted after their data arrived count 0 for the data stage.
+	inline double GetStageMs(const FChunkLifecycle& Times, const int32 Stage)
+	{
+		const double DataReady = FMath::Max(Times.Requested, Times.DataGenerated);
+		double Start = 0.0;
+		double End = 0.0;
+		switch (Stage)
+		{
+		case Data: Start = Times.Requested; End = DataReady; break;
+		case Neighbours: Start = DataReady; End = Times.NeighboursReady; break;
+		case Mesh: Start = Times.NeighboursReady; End = Times.MeshDone; break;
+		case Display: Start = Times.MeshDone; End = Times.Displayed; break;
+		case Total: Start = Times.Requested; End = Times.Displayed; break;
+		default: break;
+		}
+		return FMath::Max(0.0, End - Start) * 1000.0;
+	}
+}
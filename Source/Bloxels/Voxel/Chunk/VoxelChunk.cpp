@@ -3,9 +3,21 @@
 #include "VoxelChunk.h"
 
 #include "VoxelChunkAsync.h"
+#include "VoxelJobScheduler.h"
+#include "Bloxels/Voxel/Core/VoxelStats.h"
+#include "Bloxels/Voxel/Lighting/VoxelLightEngine.h"
+#include "Bloxels/Voxel/PathFinding/VoxelNavGrid.h"
 #include "Bloxels/Voxel/World/WorldGenerationConfig.h"
 #include "Tasks/Task.h"
 
+namespace
+{
+	const FIntVector FaceOffsets[] = {
+		{1, 0, 0}, {-1, 0, 0},
+		{0, 1, 0}, {0, -1, 0},
+		{0, 0, 1}, {0, 0, -1}
+	};
+}
 
 AVoxelChunk::AVoxelChunk()
 {
@@ -14,222 +26,478 @@ AVoxelChunk::AVoxelChunk()
 	RootComponent = MeshComponent;
 }
 
+void AVoxelChunk::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (bCountedResident)
+	{
+		DEC_DWORD_STAT(STAT_BloxelsChunksResident);
+		bCountedResident = false;
+	}
+	DEC_MEMORY_STAT_BY(STAT_BloxelsVoxelMemory, TrackedVoxelBytes);
+	DEC_MEMORY_STAT_BY(STAT_BloxelsMeshMemory, TrackedMeshBytes);
+	TrackedVoxelBytes = 0;
+	TrackedMeshBytes = 0;
+
+	Super::EndPlay(EndPlayReason);
+}
+
+void AVoxelChunk::GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize)
+{
+	Super::GetResourceSizeEx(CumulativeResourceSize);
+	CumulativeResourceSize.AddDedicatedSystemMemoryBytes(GetMemoryUsage().GetTotal());
+}
+
+FVoxelChunkMemory AVoxelChunk::GetMemoryUsage() const
+{
+	FVoxelChunkMemory Memory;
+	Memory.VoxelData = VoxelData.GetAllocatedSize();
+	Memory.LightData = LightData.GetAllocatedSize();
+
+	if (MeshComponent)
+	{
+		for (int32 Index = 0; Index < MeshComponent->GetNumSections(); ++Index)
+		{
+			if (const FProcMeshSection* Section = MeshComponent->GetProcMeshSection(Index))
+			{
+				Memory.ProcMesh += Section->ProcVertexBuffer.GetAllocatedSize() + Section->ProcIndexBuffer.GetAllocatedSize();
+			}
+		}
+	}
+	return Memory;
+}
+
 void AVoxelChunk::InitializeChunk(AVoxelWorld* InVoxelWorld, int32 ChunkX, int32 ChunkY, int32 ChunkZ, bool bShouldGenMesh)
 {
 	VoxelWorld = InVoxelWorld;
 	ChunkCoords = FIntVector(ChunkX, ChunkY, ChunkZ);
-	bGenerateMesh = bShouldGenMesh;
     
     const int ChunkSize = VoxelWorld->GetWorldGenerationConfig()->ChunkSize;
 
 	// Initialize Voxel Data Size ***THIS SHOULD NOT CHANGE ANYWHERE AFTER ITS SET***
+	LLM_SCOPE_BYTAG(Bloxels_VoxelData);
 	VoxelData.SetNum(ChunkSize * ChunkSize * ChunkSize);
+	LightData.Init(0, ChunkSize * ChunkSize * ChunkSize);
+
+	// Sections must tile the chunk exactly, otherwise fall back to a single section
+	const int RequestedSectionSize = VoxelWorld->GetWorldGenerationConfig()->MeshSectionSize;
+	SectionSize = (RequestedSectionSize > 0 && ChunkSize % RequestedSectionSize == 0) ? RequestedSectionSize : ChunkSize;
+	SectionsPerAxis = ChunkSize / SectionSize;
+
+	const int NumSections = SectionsPerAxis * SectionsPerAxis * SectionsPerAxis;
+	SectionSlots.SetNum(NumSections);
+	SectionVersions.Init(0, NumSections);
+	DirtySections.Init(true, NumSections);
+
+	INC_DWORD_STAT(STAT_BloxelsChunksResident);
+	bCountedResident = true;
+	UpdateMemoryStats();
 
 	GenerateChunkDataAsync();
+	if (bShouldGenMesh)
+	{
+		RequestMesh();
+	}
 }
 
 void AVoxelChunk::GenerateChunkDataAsync()
 {
 	TWeakObjectPtr<AVoxelChunk> WeakChunk(this);
-	TWeakObjectPtr<AVoxelWorld> WeakWorld(VoxelWorld);
-	VoxelChunkAsync::GenerateChunkDataAsync(WeakChunk, WeakWorld, ChunkCoords);
+	DataTask = VoxelChunkAsync::GenerateChunkDataAsync(WeakChunk, VoxelChunkAsync::MakeJobContext(*VoxelWorld), ChunkCoords, DataSlot);
+}
+
+void AVoxelChunk::OnChunkDataGenerated(TSharedPtr<const FVoxelChunkData> InData, TSharedPtr<FVoxelNavChunk> InNavData, const double GeneratedTime)
+{
+	if (!InData.IsValid())
+	{
+		UE_LOG(LogTemp, Error, TEXT("VoxelChunk got no generated data!"));
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_BloxelsOnChunkDataGenerated);
+	LLM_SCOPE_BYTAG(Bloxels_VoxelData);
+	const double CallbackStart = FPlatformTime::Seconds();
+	BLOXELS_TRACE_CHUNK_SCOPE("OnChunkDataGenerated", ChunkCoords);
+
+	VoxelData = InData->VoxelData;
+	if (InData->LightData.Num() == LightData.Num())
+	{
+		FMemory::Memcpy(LightData.GetData(), InData->LightData.GetData(), InData->LightData.Num());
+	}
+	bHasData = true;
+	MarkDataChanged();
+	Lifecycle.DataGenerated = GeneratedTime;
+	UpdateMemoryStats();
+
+	// A first mesh in flight was built from this same data; only what relighting touches below needs redoing
+	if (!bMeshInFlight)
+	{
+		MarkAllSectionsDirty();
+	}
+	bDataPublished = DataSlot->Get() == InData;
+
+	if (const TSharedPtr<FVoxelNavGrid> NavGrid = VoxelWorld->GetNavGrid())
+	{
+		NavGrid->AddChunk(ChunkCoords, InNavData);
+	}
+
+	// Let light flow across the faces shared with already loaded neighbours
+	if (const TSharedPtr<FVoxelLightEngine> LightEngine = VoxelWorld->GetLightEngine())
+	{
+		LightEngine->QueueChunkLoaded(ChunkCoords);
+		LightEngine->Flush();
+	}
+
+	// Structures placed while this chunk was generating may have missed it
+	if (InData->StructureVersion != VoxelWorld->GetWorldGenerationSubsystem()->GetStructureVersion())
+	{
+		VoxelWorld->ApplyPlacedStructures(ChunkCoords, InData->StructureVersion);
+	}
+
+	VoxelWorld->AddChunkCallbackTime(FPlatformTime::Seconds() - CallbackStart);
 }
 
-void AVoxelChunk::OnChunkDataGenerated(TArray<uint16> InVoxelData)
+void AVoxelChunk::RequestMesh()
 {
-	TWeakObjectPtr<AVoxelChunk> WeakThis(this);
-	AsyncTask(ENamedThreads::GameThread, [InVoxelData = MoveTemp(InVoxelData), WeakThis]()
+	if (!VoxelWorld)
 	{
-		if (!WeakThis.IsValid())  // Check if AVoxelWorld is still valid before proceeding
+		UE_LOG(LogTemp, Error, TEXT("VoxelWorld is null"));
+		return;
+	}
+
+	if (!bGenerateMesh)
+	{
+		bGenerateMesh = true;
+		MarkMeshRequested();
+	}
+
+	if (bHasMeshSections || bMeshInFlight)
+	{
+		if (bHasData)
 		{
-			UE_LOG(LogTemp, Error, TEXT("VoxelChunk is no longer valid!"));
-			return;
+			GenerateChunkMeshAsync();
 		}
+		return;
+	}
 
-		WeakThis->VoxelData = InVoxelData;
-		WeakThis->bHasData = true;
-		if (WeakThis->bGenerateMesh)
+	GenerateFirstMeshAsync();
+}
+
+void AVoxelChunk::GenerateFirstMeshAsync()
+{
+	TArray<UE::Tasks::FTaskEvent> Prerequisites;
+	if (DataTask.IsSet())
+	{
+		Prerequisites.Add(DataTask.GetValue());
+	}
+
+	TArray<TSharedRef<FVoxelChunkRecord>> Neighbours;
+	for (const FIntVector& Offset : FaceOffsets)
+	{
+		// Neighbours are only loaded for their data, not meshed
+		const FIntVector NeighbourCoord = ChunkCoords + Offset;
+		VoxelWorld->TryCreateNewChunk(NeighbourCoord.X, NeighbourCoord.Y, NeighbourCoord.Z, false);
+
+		const AVoxelChunk* Neighbour = VoxelWorld->FindChunk(NeighbourCoord);
+		const TSharedPtr<FVoxelChunkRecord> Record = VoxelWorld->FindChunkRecord(NeighbourCoord);
+		if (!Neighbour || !Record)
+		{
+			continue;
+		}
+		if (Neighbour->DataTask.IsSet())
 		{
-			WeakThis->TryGenerateChunkMesh();
+			Prerequisites.Add(Neighbour->DataTask.GetValue());
 		}
-		WeakThis->ChunkDataGeneratedEvent.Broadcast();
-		// REMOVE ALL LISTENERS
-		WeakThis->ChunkDataGeneratedEvent.Clear();
-	});
+		Neighbours.Add(Record.ToSharedRef());
+	}
+
+	TArray<FSectionMeshData> SectionJobs;
+	for (int32 Index = 0; Index < SectionVersions.Num(); ++Index)
+	{
+		FSectionMeshData& Job = SectionJobs.AddDefaulted_GetRef();
+		Job.SectionIndex = Index;
+		Job.SectionVersion = SectionVersions[Index];
+	}
+
+	DirtySections.SetRange(0, DirtySections.Num(), false);
+	bRemeshPending = false;
+	bMeshInFlight = true;
+
+	// A chunk that already has its data may have been edited or relit since it was published
+	TSharedPtr<const FVoxelChunkData> OwnData;
+	if (bHasData)
+	{
+		OwnData = GetCurrentData();
+	}
+
+	TWeakObjectPtr<AVoxelChunk> WeakChunk(this);
+	VoxelChunkAsync::GenerateFirstChunkMeshAsync(WeakChunk, VoxelChunkAsync::MakeJobContext(*VoxelWorld), ChunkCoords, SectionSize,
+		MoveTemp(SectionJobs), OwnData, DataSlot, MoveTemp(Neighbours), MoveTemp(Prerequisites));
 }
 
-void AVoxelChunk::TryGenerateChunkMesh()
+void AVoxelChunk::GenerateChunkMeshAsync()
 {
-	if (!IsValid(this))
+	if (!bGenerateMesh || !bHasData)
+	{
+		UE_LOG(LogTemp, Error, TEXT("Invalid mesh generation call"));
+		return;
+	}
+
+	// Coalesce requests: the running job reruns once it finishes instead of racing a second job
+	if (bMeshInFlight)
+	{
+		bRemeshPending = true;
+		return;
+	}
+
+	// A full meshing lane keeps the dirty sections until the world has room for them
+	const TSharedPtr<FVoxelJobScheduler> Scheduler = VoxelWorld->GetJobScheduler();
+	if (Scheduler && Scheduler->IsSaturated(EVoxelJobLane::Meshing))
+	{
+		bRemeshPending = true;
+		VoxelWorld->DeferRemesh(ChunkCoords);
+		return;
+	}
+	bRemeshPending = false;
+
+	// Only the sections touched since the last job are remeshed; the rest keep their cached mesh
+	TArray<FSectionMeshData> SectionJobs;
+	for (TConstSetBitIterator<> It(DirtySections); It; ++It)
+	{
+		FSectionMeshData& Job = SectionJobs.AddDefaulted_GetRef();
+		Job.SectionIndex = It.GetIndex();
+		Job.SectionVersion = SectionVersions[It.GetIndex()];
+	}
+
+	if (SectionJobs.Num() == 0)
+	{
+		return;
+	}
+
+	DirtySections.SetRange(0, DirtySections.Num(), false);
+	bMeshInFlight = true;
+
+	// Border faces read the face neighbours' published snapshots, which committed edits and relighting keep current
+	TArray<TSharedRef<FVoxelChunkRecord>> Neighbours;
+	for (const FIntVector& Offset : FaceOffsets)
+	{
+		if (const TSharedPtr<FVoxelChunkRecord> Record = VoxelWorld->FindChunkRecord(ChunkCoords + Offset))
+		{
+			Neighbours.Add(Record.ToSharedRef());
+		}
+	}
+
+	// The job meshes the published snapshot; a batch of edits copies the chunk once however often it remeshes
+	TWeakObjectPtr<AVoxelChunk> WeakChunk(this);
+	VoxelChunkAsync::GenerateChunkMeshAsync(WeakChunk, VoxelChunkAsync::MakeJobContext(*VoxelWorld), GetCurrentData(), ChunkCoords, SectionSize,
+		MoveTemp(SectionJobs), MoveTemp(Neighbours));
+}
+
+
+void AVoxelChunk::OnMeshGenerated(TArray<FSectionMeshData> InSectionMeshes, const double NeighboursReady)
+{
+    DEC_DWORD_STAT(STAT_BloxelsChunksUploading);
+
+    const double CallbackStart = FPlatformTime::Seconds();
+    LLM_SCOPE_BYTAG(Bloxels_MeshData);
+    bMeshInFlight = false;
+
+    if (NeighboursReady > 0.0 && Lifecycle.NeighboursReady == 0.0)
     {
-        UE_LOG(LogTemp, Error, TEXT("VoxelChunk is invalid"));
-        return;
+        Lifecycle.NeighboursReady = NeighboursReady;
     }
 
-    if (!VoxelWorld)
+    // Drop sections that were edited while the job ran; they are dirty again and get remeshed below. The rest
+    // replace only their own component sections.
+    const double MeshDone = FPlatformTime::Seconds();
+    bool bAnyApplied = false;
+    for (const FSectionMeshData& Section : InSectionMeshes)
     {
-        UE_LOG(LogTemp, Error, TEXT("VoxelWorld is null"));
-        return;
+        if (SectionVersions.IsValidIndex(Section.SectionIndex) &&
+            SectionVersions[Section.SectionIndex] == Section.SectionVersion)
+        {
+            UploadSection(Section.SectionIndex, Section.MeshSections);
+            bAnyApplied = true;
+        }
     }
 
-    if (!VoxelWorld->GetVoxelRegistry())
+    if (bAnyApplied)
     {
-        UE_LOG(LogTemp, Error, TEXT("Voxel Registry is null"));
-        return;
+        if (Lifecycle.MeshDone == 0.0)
+        {
+            Lifecycle.MeshDone = MeshDone;
+        }
+        bHasMeshSections = true;
+        DisplayMesh();
+        UpdateMemoryStats();
     }
 
-    if (!bHasData)
+    if (bRemeshPending || DirtySections.Contains(true))
     {
-        UE_LOG(LogTemp, Error, TEXT("No Data!"));
-        return;
+        GenerateChunkMeshAsync();
     }
 
-    //UE_LOG(LogTemp, Log, TEXT("Generating chunk mesh (%d, %d)"), ChunkCoords.X, ChunkCoords.Y);
+    VoxelWorld->AddChunkCallbackTime(FPlatformTime::Seconds() - CallbackStart);
+}
 
-    static const FIntVector Offsets[] = {
-        {1, 0, 0}, {-1, 0, 0},
-        {0, 1, 0}, {0, -1, 0},
-        {0, 0, 1}, {0, 0, -1}
-    };
-    bool bAllGenerated = true;
+void AVoxelChunk::PublishData()
+{
+    if (bHasData)
+    {
+        DataSlot->Set(MakeDataSnapshot());
+        bDataPublished = true;
+    }
+}
 
-    for (const FIntVector& Offset : Offsets)
+TSharedRef<const FVoxelChunkData> AVoxelChunk::GetCurrentData()
+{
+    if (!bDataPublished)
     {
-        FIntVector NeighborCoord(ChunkCoords.X + Offset.X, ChunkCoords.Y + Offset.Y, ChunkCoords.Z + Offset.Z);
-        AVoxelChunk* NeighborChunk = nullptr;// = *VoxelWorld->Chunks.Find(NeighborCoord);
-        if (VoxelWorld->Chunks.Contains(NeighborCoord))
-        {
-            NeighborChunk = *VoxelWorld->Chunks.Find(NeighborCoord);
-        }
-        else
-        {
-            bAllGenerated = false;
-        }
+        PublishData();
+    }
+    return DataSlot->Get().ToSharedRef();
+}
 
-        // If NeighborChunk doesn't already exist, then we need to create it
-        if (NeighborChunk == nullptr)
-        {
-            bAllGenerated = false;
-            // We need to create the chunk & subscribe to on data generated
-            VoxelWorld->TryCreateNewChunk(NeighborCoord.X, NeighborCoord.Y, NeighborCoord.Z, false);
+TSharedRef<const FVoxelChunkData> AVoxelChunk::MakeDataSnapshot() const
+{
+    const TSharedRef<FVoxelChunkData> Snapshot = MakeShared<FVoxelChunkData>();
+    Snapshot->VoxelData = VoxelData;
+    Snapshot->LightData = LightData;
+    return Snapshot;
+}
 
-            NeighborChunk = *VoxelWorld->Chunks.Find(NeighborCoord);
-        }
+void AVoxelChunk::MarkVoxelDirty(const FIntVector& LocalCoord)
+{
+    if (SectionSize <= 0) return;
 
-        if (NeighborChunk != nullptr)
-        {
-            // If neighbor chunk doesn't already have data, subscribe to get notified when it finishes
-            if (!NeighborChunk->bHasData)
-            {
-                bAllGenerated = false;
-
-                // Check if already subscribed before adding
-                if (!NeighborChunk->OnChunkDataGenerated().IsBoundToObject(this))
-                {
-                    NeighborChunk->OnChunkDataGenerated().AddUObject(this, &AVoxelChunk::TryGenerateChunkMesh);
-                }
-            }
-        }
-    }
+    const FIntVector Section(LocalCoord.X / SectionSize, LocalCoord.Y / SectionSize, LocalCoord.Z / SectionSize);
+    const FIntVector InSection(LocalCoord.X % SectionSize, LocalCoord.Y % SectionSize, LocalCoord.Z % SectionSize);
 
-    if (bAllGenerated)
-    {
-        //UE_LOG(LogTemp, Display, TEXT("ALL NEIGHBORING CHUNKS ARE GENERATED FOR (%d, %d)"), ChunkCoords.X, ChunkCoords.Y);
+    MarkSectionDirty(Section.X, Section.Y, Section.Z);
 
-        GenerateChunkMeshAsync();
-    }
+    // Faces in the neighbouring section can be exposed or hidden by this voxel
+    if (InSection.X == 0) MarkSectionDirty(Section.X - 1, Section.Y, Section.Z);
+    else if (InSection.X == SectionSize - 1) MarkSectionDirty(Section.X + 1, Section.Y, Section.Z);
+
+    if (InSection.Y == 0) MarkSectionDirty(Section.X, Section.Y - 1, Section.Z);
+    else if (InSection.Y == SectionSize - 1) MarkSectionDirty(Section.X, Section.Y + 1, Section.Z);
+
+    if (InSection.Z == 0) MarkSectionDirty(Section.X, Section.Y, Section.Z - 1);
+    else if (InSection.Z == SectionSize - 1) MarkSectionDirty(Section.X, Section.Y, Section.Z + 1);
 }
 
-void AVoxelChunk::GenerateChunkMeshAsync()
+void AVoxelChunk::MarkAllSectionsDirty()
 {
-	if (!bGenerateMesh || !bHasData)
-	{
-		UE_LOG(LogTemp, Error, TEXT("Invalid mesh generation call"));
-		return;
-	}
+    bDataPublished = false;
+    ++EditVersion;
+    for (int32 Index = 0; Index < SectionVersions.Num(); ++Index)
+    {
+        ++SectionVersions[Index];
+    }
+    DirtySections.SetRange(0, DirtySections.Num(), true);
+}
 
-	TWeakObjectPtr<AVoxelChunk> WeakChunk(this);
-	TWeakObjectPtr<AVoxelWorld> WeakWorld(VoxelWorld);
-    TArray<uint16> VoxelDataCopy = VoxelData;
-	const FIntVector ChunkCoordsCopy = ChunkCoords;
+void AVoxelChunk::MarkSectionDirty(int32 SectionX, int32 SectionY, int32 SectionZ)
+{
+    if (SectionX < 0 || SectionX >= SectionsPerAxis ||
+        SectionY < 0 || SectionY >= SectionsPerAxis ||
+        SectionZ < 0 || SectionZ >= SectionsPerAxis)
+    {
+        return;
+    }
 
-	VoxelChunkAsync::GenerateChunkMeshAsync(WeakChunk, WeakWorld, VoxelDataCopy, ChunkCoordsCopy);
+    const int32 Index = (SectionZ * SectionsPerAxis * SectionsPerAxis) + (SectionY * SectionsPerAxis) + SectionX;
+    bDataPublished = false;
+    ++EditVersion;
+    ++SectionVersions[Index];
+    DirtySections[Index] = true;
 }
 
+void AVoxelChunk::UpdateMemoryStats()
+{
+    const FVoxelChunkMemory Memory = GetMemoryUsage();
+    const SIZE_T VoxelBytes = Memory.GetVoxelTotal();
+    const SIZE_T MeshBytes = Memory.GetMeshTotal();
+
+    DEC_MEMORY_STAT_BY(STAT_BloxelsVoxelMemory, TrackedVoxelBytes);
+    INC_MEMORY_STAT_BY(STAT_BloxelsVoxelMemory, VoxelBytes);
+    DEC_MEMORY_STAT_BY(STAT_BloxelsMeshMemory, TrackedMeshBytes);
+    INC_MEMORY_STAT_BY(STAT_BloxelsMeshMemory, MeshBytes);
+    TrackedVoxelBytes = VoxelBytes;
+    TrackedMeshBytes = MeshBytes;
+}
 
-void AVoxelChunk::OnMeshGenerated(const TMap<FMeshSectionKey, FMeshData>& InMeshSections)
+void AVoxelChunk::UploadSection(const int32 SectionIndex, const TMap<FMeshSectionKey, FMeshData>& Meshes)
 {
-    //UE_LOG(LogTemp, Error, TEXT("ON MESH GENERATED"));
-    TWeakObjectPtr<AVoxelChunk> WeakThis(this);
+    SCOPE_CYCLE_COUNTER(STAT_BloxelsDisplayMesh);
+    BLOXELS_TRACE_CHUNK_SCOPE("UploadSection", ChunkCoords);
 
-    AsyncTask(ENamedThreads::GameThread, [InMeshSections, WeakThis]()
+    TMap<FMeshSectionKey, int32>& Slots = SectionSlots[SectionIndex];
+
+    // Keys this section no longer has give their component section back
+    for (auto It = Slots.CreateIterator(); It; ++It)
+    {
+        const FMeshData* MeshData = Meshes.Find(It.Key());
+        if (!MeshData || MeshData->Vertices.Num() == 0)
+        {
+            MeshComponent->ClearMeshSection(It.Value());
+            FreeMeshSlots.Add(It.Value());
+            It.RemoveCurrent();
+        }
+    }
+
+    for (const auto& Entry : Meshes)
     {
-        if (!WeakThis.IsValid())  // Check if AVoxelChunk is still valid before proceeding
+        const FMeshData& MeshData = Entry.Value;
+        if (MeshData.Vertices.Num() == 0) continue;
+
+        // A reused slot keeps the material it was given for this key
+        int32* Slot = Slots.Find(Entry.Key);
+        const bool bNewSlot = Slot == nullptr;
+        if (bNewSlot)
+        {
+            Slot = &Slots.Add(Entry.Key, FreeMeshSlots.Num() > 0 ? FreeMeshSlots.Pop(EAllowShrinking::No) : NumMeshSlots++);
+        }
+
+        MeshComponent->CreateMeshSection_LinearColor(
+            *Slot, MeshData.Vertices, MeshData.Triangles, MeshData.Normals,
+            MeshData.UVs, MeshData.VertexColors, TArray<FProcMeshTangent>(), true);
+
+        if (bNewSlot)
         {
-            UE_LOG(LogTemp, Error, TEXT("VoxelChunk was deleted before chunk could be loaded."));
-            return;
+            MeshComponent->SetMaterial(*Slot, CreateSectionMaterial(Entry.Key));
         }
-        WeakThis->MeshSections = InMeshSections;
-        WeakThis->bHasMeshSections = true;
-        WeakThis->DisplayMesh();
-    });
+    }
 }
 
-void AVoxelChunk::DisplayMesh()  
-{  
-   MeshComponent->ClearAllMeshSections(); // Clear existing mesh sections before displaying new ones;  
+UMaterialInterface* AVoxelChunk::CreateSectionMaterial(const FMeshSectionKey& SectionKey)
+{
+    const UVoxelData* Voxel = VoxelWorld->GetVoxelRegistry()->GetVoxelByID(SectionKey.VoxelType);
+    UMaterialInstanceDynamic* MaterialInstance = UMaterialInstanceDynamic::Create(Voxel->Material, this);
+    if (!MaterialInstance)
+    {
+        return Voxel->Material;
+    }
 
-   // Apply mesh sections for each voxel type   
-   int SectionIndex = 0;  
-   int TotalTris = 0;  
-   int TotalVerts = 0;  
+    // Each face direction picks its tile from the atlas
+    const double NormalZ = SectionKey.GetNormal().Z;
+    const FIntPoint TileOffset = NormalZ == 0 ? Voxel->SideTileOffset : NormalZ > 0 ? Voxel->TopTileOffset : Voxel->BottomTileOffset;
+    MaterialInstance->SetScalarParameterValue(TEXT("TileOffsetX"), TileOffset.X);
+    MaterialInstance->SetScalarParameterValue(TEXT("TileOffsetY"), TileOffset.Y);
+    return MaterialInstance;
+}
 
-	//UE_LOG(LogTemp, Error, TEXT("AVoxelChunk::DisplayMesh"));
-	
-   for (const auto& Entry : MeshSections)  
-   {
-       const FMeshSectionKey SectionKey = Entry.Key;
-
-       if (const FMeshData& MeshData = Entry.Value; MeshData.Vertices.Num() > 0)  
-       {  
-           MeshComponent->CreateMeshSection(  
-               SectionIndex, MeshData.Vertices, MeshData.Triangles, MeshData.Normals,  
-               MeshData.UVs, TArray<FColor>(), TArray<FProcMeshTangent>(), true);  
-
-           UMaterialInterface* BaseMaterial = VoxelWorld->GetVoxelRegistry()->GetVoxelByID(SectionKey.VoxelType)->Material;
-           // Check if the material is a dynamic material instance and set the TileCountX parameter  
-
-           if (UMaterialInstanceDynamic* MaterialInstance = UMaterialInstanceDynamic::Create(BaseMaterial, this))
-           {  
-               if (SectionKey.Normal.Z == 0)
-               {
-                   MaterialInstance->SetScalarParameterValue(TEXT("TileOffsetX"), VoxelWorld->GetVoxelRegistry()->GetVoxelByID(SectionKey.VoxelType)->SideTileOffset.X);
-                   MaterialInstance->SetScalarParameterValue(TEXT("TileOffsetY"), VoxelWorld->GetVoxelRegistry()->GetVoxelByID(SectionKey.VoxelType)->SideTileOffset.Y);
-               }
-               else if (SectionKey.Normal.Z == 1)
-               {
-                   MaterialInstance->SetScalarParameterValue(TEXT("TileOffsetX"), VoxelWorld->GetVoxelRegistry()->GetVoxelByID(SectionKey.VoxelType)->TopTileOffset.X);
-                   MaterialInstance->SetScalarParameterValue(TEXT("TileOffsetY"), VoxelWorld->GetVoxelRegistry()->GetVoxelByID(SectionKey.VoxelType)->TopTileOffset.Y);
-               }
-               else if (SectionKey.Normal.Z == -1)
-               {
-                   MaterialInstance->SetScalarParameterValue(TEXT("TileOffsetX"), VoxelWorld->GetVoxelRegistry()->GetVoxelByID(SectionKey.VoxelType)->BottomTileOffset.X);
-                   MaterialInstance->SetScalarParameterValue(TEXT("TileOffsetY"), VoxelWorld->GetVoxelRegistry()->GetVoxelByID(SectionKey.VoxelType)->BottomTileOffset.Y);
-               }
-
-               // Set the material for the section  
-               MeshComponent->SetMaterial(SectionIndex, MaterialInstance);
-           }
-
-           TotalTris += MeshData.Triangles.Num() / 3;  
-           TotalVerts += MeshData.Vertices.Num();  
-           SectionIndex++;  
-       }  
-   }  
-
-   VoxelWorld->ActiveChunksLock.WriteLock();  
-   VoxelWorld->ActiveChunks.Add(ChunkCoords, this);  
+void AVoxelChunk::DisplayMesh()
+{
+   VoxelWorld->ActiveChunksLock.WriteLock();
+   VoxelWorld->ActiveChunks.Add(ChunkCoords, this);
    VoxelWorld->ActiveChunksLock.WriteUnlock();
+
+   // Only the first display counts; remeshes after edits aren't streaming latency
+   if (Lifecycle.Displayed == 0.0 && Lifecycle.Requested > 0.0)
+   {
+       Lifecycle.Displayed = FPlatformTime::Seconds();
+       VoxelWorld->RecordChunkLifecycle(ChunkCoords, Lifecycle);
+   }
 }
 
 void AVoxelChunk::UnloadChunk()
@@ -238,9 +506,13 @@ void AVoxelChunk::UnloadChunk()
     VoxelWorld->ActiveChunks.Remove(ChunkCoords);
     VoxelWorld->ActiveChunksLock.WriteUnlock();
 
-    VoxelWorld->ChunksLock.WriteLock();
-    VoxelWorld->Chunks.Remove(ChunkCoords);
-    VoxelWorld->ChunksLock.WriteUnlock();
+    DataSlot->Abandon();
+    VoxelWorld->RemoveChunk(ChunkCoords);
+
+    if (const TSharedPtr<FVoxelNavGrid> NavGrid = VoxelWorld->GetNavGrid())
+    {
+        NavGrid->RemoveChunk(ChunkCoords);
+    }
 
     MeshComponent->ClearAllMeshSections();
     this->Destroy();
@@ -257,28 +529,15 @@ bool AVoxelChunk::IsVoxelInChunk(int X, int Y, int Z) const
         Z >= 0 && Z < ChunkSize);
 }
 
-/// <returns>Returns true when voxel is transparent or outside the chunk</returns>
-bool AVoxelChunk::CheckVoxel(int X, int Y, int Z, FIntVector ChunkCoord)
+void AVoxelChunk::SetChunkCoords(FIntVector InCoords)
 {
-    const int ChunkSize = VoxelWorld->GetWorldGenerationConfig()->ChunkSize;
-    
-    if (!IsValid(VoxelWorld)) return false;
-    if (IsVoxelInChunk(X, Y, Z))
-    {
-        int16 NeighborType = VoxelData[(Z * ChunkSize * ChunkSize) + (Y * ChunkSize) + X];
-        return VoxelWorld->GetVoxelRegistry()->GetVoxelByID(NeighborType)->bIsTransparent;
-    }
-    else
-    {
-        int WorldX = ChunkCoord.X * ChunkSize + X;
-        int WorldY = ChunkCoord.Y * ChunkSize + Y;
-        int WorldZ = ChunkCoord.Z * ChunkSize + Z;
-        int16 NeighborType = VoxelWorld->GetVoxelAtWorldCoordinates(WorldX, WorldY, WorldZ);
-        return VoxelWorld->GetVoxelRegistry()->GetVoxelByID(NeighborType)->bIsTransparent;
-    }
+    ChunkCoords = InCoords;
 }
 
-void AVoxelChunk::SetChunkCoords(FIntVector InCoords)
+void AVoxelChunk::MarkMeshRequested()
 {
-    ChunkCoords = InCoords;
+    if (Lifecycle.Requested == 0.0)
+    {
+        Lifecycle.Requested = FPlatformTime::Seconds();
+    }
 }
\ No newline at end of file
@@ -4,15 +4,29 @@
 
 #include "CoreMinimal.h"
 #include "ProceduralMeshComponent.h"
+#include "ChunkLifecycle.h"
+#include "VoxelChunkData.h"
 #include "Bloxels/Voxel/Core/MeshData.h"
 #include "Bloxels/Voxel/Core/MeshSectionKey.h"
 #include "Bloxels/Voxel/World/VoxelWorld.h"
 #include "GameFramework/Actor.h"
+#include "Tasks/Task.h"
 #include "VoxelChunk.generated.h"
 
 class UVoxelConfig;
+struct FVoxelNavChunk;
 
-DECLARE_EVENT(AVoxelChunk, FOnChunkDataGenerated)
+// Heap held by one chunk, in bytes
+struct FVoxelChunkMemory
+{
+	SIZE_T VoxelData = 0;
+	SIZE_T LightData = 0;
+	SIZE_T ProcMesh = 0;  // The mesh component's CPU vertex and index buffers
+
+	SIZE_T GetVoxelTotal() const { return VoxelData + LightData; }
+	SIZE_T GetMeshTotal() const { return ProcMesh; }
+	SIZE_T GetTotal() const { return GetVoxelTotal() + GetMeshTotal(); }
+};
 
 UCLASS()
 class BLOXELS_API AVoxelChunk : public AActor
@@ -21,6 +35,11 @@ class BLOXELS_API AVoxelChunk : public AActor
 
 public:
 	AVoxelChunk();
+
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void GetResourceSizeEx(FResourceSizeEx& CumulativeResourceSize) override;
+
+	FVoxelChunkMemory GetMemoryUsage() const;
 	
 	UPROPERTY(VisibleAnywhere)
 	FIntVector ChunkCoords = FIntVector(-MAX_int32, -MAX_int32, -MAX_int32);
@@ -28,27 +47,51 @@ public:
 	
 	void InitializeChunk(AVoxelWorld* InVoxelWorld, int32 ChunkX, int32 ChunkY, int32 ChunkZ, bool bShouldGenMesh);
 
-	void OnChunkDataGenerated(TArray<uint16> InVoxelData);
+	void OnChunkDataGenerated(TSharedPtr<const FVoxelChunkData> InData, TSharedPtr<FVoxelNavChunk> InNavData, double GeneratedTime);
 
-	void TryGenerateChunkMesh();
+	// Keeps this chunk meshed from now on. The first mesh is a task behind this chunk's and its six neighbours'
+	// data tasks, spawning any neighbour that doesn't exist yet; later calls remesh the dirty sections.
+	void RequestMesh();
 
-	void OnMeshGenerated(const TMap<FMeshSectionKey, FMeshData>& InMeshSections);
+	// NeighboursReady is when a first mesh job found all its prerequisites done, 0 for remeshes
+	void OnMeshGenerated(TArray<FSectionMeshData> InSectionMeshes, double NeighboursReady);
+
+	// Call whenever voxel data that this chunk's mesh depends on changes.
+	// Marks the section holding the voxel, plus the adjacent section when the voxel sits on a section border.
+	void MarkVoxelDirty(const FIntVector& LocalCoord);
+	void MarkAllSectionsDirty();
+	uint32 GetEditVersion() const { return EditVersion; }
+	// Bumped whenever VoxelData is edited or replaced, so work done on a copy can tell it went stale
+	uint32 GetDataVersion() const { return DataVersion; }
+	void MarkDataChanged() { ++DataVersion; bDataPublished = false; }
+	// Replaces the published snapshot with the current voxels, so first meshes of neighbours see committed edits
+	void PublishData();
+	int32 GetSectionSize() const { return SectionSize; }
 
 	void UnloadChunk();
 
 	bool IsVoxelInChunk(int X, int Y, int Z) const;
 
-	bool CheckVoxel(int X, int Y, int Z, FIntVector ChunkCoord);
-
 	void SetChunkCoords(FIntVector InCoords);
 
+	// Starts the lifecycle clock when a chunk that was only loaded for its neighbours is asked for a mesh
+	void MarkMeshRequested();
+	const FChunkLifecycle& GetLifecycle() const { return Lifecycle; }
+
+	// Triggered once this chunk's data is in its slot; unset until InitializeChunk
+	const TOptional<UE::Tasks::FTaskEvent>& GetDataTask() const { return DataTask; }
+	TSharedRef<FVoxelChunkDataSlot> GetDataSlot() const { return DataSlot; }
+
 
 	// BOOLS
 	bool bGenerateMesh = false;
 	bool bHasData = false;
 	bool bHasMeshSections = false;
+	bool bMeshInFlight = false;   // At most one mesh job per chunk runs at a time
+	bool bRemeshPending = false;  // A remesh was requested while a job was in flight
 
 	TArray<uint16> VoxelData;
+	TArray<uint8> LightData;  // Packed sky/block light per voxel (see VoxelLight). Game thread only; light updates are written back here when they land.
 
 protected:
 	UPROPERTY(VisibleAnywhere)
@@ -58,16 +101,44 @@ protected:
 	AVoxelWorld* VoxelWorld = nullptr;
 	
 private:
-	FOnChunkDataGenerated& OnChunkDataGenerated() { return ChunkDataGeneratedEvent; }
-	FOnChunkDataGenerated ChunkDataGeneratedEvent;
+	TOptional<UE::Tasks::FTaskEvent> DataTask;
+	TSharedRef<FVoxelChunkDataSlot> DataSlot = MakeShared<FVoxelChunkDataSlot>();
 
-	
-	TMap<FMeshSectionKey, FMeshData> MeshSections;
+	// Sections. Every key of every section is its own mesh component section, so a remesh only re-uploads what it rebuilt.
+	int32 SectionSize = 0;
+	int32 SectionsPerAxis = 1;
+	TArray<TMap<FMeshSectionKey, int32>> SectionSlots;  // Mesh component section index per key, per section
+	TArray<int32> FreeMeshSlots;
+	int32 NumMeshSlots = 0;
+	TArray<uint32> SectionVersions;
+	TBitArray<> DirtySections;
+	bool bDataPublished = false;  // DataSlot holds the current voxels and light, so a remesh can share it
+
+	uint32 EditVersion = 0;
+	uint32 DataVersion = 0;
+
+	FChunkLifecycle Lifecycle;
+
+	// Bytes last reported to the Bloxels memory stats
+	SIZE_T TrackedVoxelBytes = 0;
+	SIZE_T TrackedMeshBytes = 0;
+	bool bCountedResident = false;
+
+	void UpdateMemoryStats();
+	TSharedRef<const FVoxelChunkData> MakeDataSnapshot() const;
+	// The published snapshot, republished first when the chunk changed since
+	TSharedRef<const FVoxelChunkData> GetCurrentData();
+
+	void MarkSectionDirty(int32 SectionX, int32 SectionY, int32 SectionZ);
 
 	
 	void GenerateChunkDataAsync();
 	
+	void GenerateFirstMeshAsync();
 	void GenerateChunkMeshAsync();
 	
+	// Replaces one section's mesh component sections with Meshes
+	void UploadSection(int32 SectionIndex, const TMap<FMeshSectionKey, FMeshData>& Meshes);
+	UMaterialInterface* CreateSectionMaterial(const FMeshSectionKey& SectionKey);
 	void DisplayMesh();
 };
\ No newline at end of file
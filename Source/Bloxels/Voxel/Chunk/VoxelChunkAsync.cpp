@@ -5,144 +5,429 @@
 #include <functional>
 
 #include "VoxelChunk.h"
+#include "VoxelJobScheduler.h"
+#include "Bloxels/Voxel/Lighting/VoxelLightEngine.h"
+#include "Bloxels/Voxel/PathFinding/VoxelNavGrid.h"
 #include "Bloxels/Voxel/World/Biome/BiomeProperties.h"
 #include "Tasks/Task.h"
 #include "Async/Async.h"
+#include "Bloxels/Voxel/Core/VoxelStats.h"
 #include "Bloxels/Voxel/World/WorldGenerationConfig.h"
 
+namespace
+{
+    // Through the scheduler when there is one, so jobs are ordered and bounded
+    UE::Tasks::FTaskEvent LaunchJob(const FVoxelJobContext& JobContext, const EVoxelJobLane Lane, const FIntVector& ChunkCoords,
+        TUniqueFunction<void()> Job, TArray<UE::Tasks::FTaskEvent> Prerequisites = {})
+    {
+        if (JobContext.Scheduler)
+        {
+            return JobContext.Scheduler->Submit(Lane, ChunkCoords, MoveTemp(Job), MoveTemp(Prerequisites));
+        }
+
+        UE::Tasks::FTaskEvent Done(TEXT("VoxelJobDone"));
+        UE::Tasks::Launch(TEXT("VoxelJob"), [Job = MoveTemp(Job), Done]() mutable
+        {
+            Job();
+            Done.Trigger();
+        }, Prerequisites, UE::Tasks::ETaskPriority::BackgroundNormal);
+        return Done;
+    }
+
+    // Whatever each neighbour has published by now; an empty slot reads as unloaded
+    TArray<TPair<FIntVector, TSharedPtr<const FVoxelChunkData>>> ReadNeighbours(const TArray<TSharedRef<FVoxelChunkRecord>>& Records)
+    {
+        TArray<TPair<FIntVector, TSharedPtr<const FVoxelChunkData>>> Neighbours;
+        Neighbours.Reserve(Records.Num());
+        for (const TSharedRef<FVoxelChunkRecord>& Record : Records)
+        {
+            Neighbours.Emplace(Record->ChunkCoords, Record->Data->Get());
+        }
+        return Neighbours;
+    }
+
+    // Meshes every entry of Sections, then hands them to the chunk; the upload is the only game thread step
+    void MeshAndUpload(const TWeakObjectPtr<AVoxelChunk>& Chunk, const FVoxelMeshContext& Context, const TArray<uint16>& VoxelData,
+        const TArray<uint8>& LightData, const int32 SectionSize, TArray<FSectionMeshData>&& Sections, const double NeighboursReady)
+    {
+        const int SectionsPerAxis = Context.ChunkSize / SectionSize;
+
+        for (FSectionMeshData& Section : Sections)
+        {
+            const FIntVector SectionMin(
+                (Section.SectionIndex % SectionsPerAxis) * SectionSize,
+                ((Section.SectionIndex / SectionsPerAxis) % SectionsPerAxis) * SectionSize,
+                (Section.SectionIndex / (SectionsPerAxis * SectionsPerAxis)) * SectionSize);
+
+            Section.MeshSections.Reset();
+            VoxelChunkAsync::GenerateSectionMesh(Context, VoxelData, LightData, SectionMin, SectionSize, Section.MeshSections);
+        }
+
+        DEC_DWORD_STAT(STAT_BloxelsChunksMeshing);
+        INC_DWORD_STAT(STAT_BloxelsChunksUploading);
+
+        AsyncTask(ENamedThreads::GameThread, [Chunk, ChunkCoords = Context.ChunkCoords, Sections = MoveTemp(Sections), NeighboursReady]() mutable
+        {
+            if (Chunk.IsValid())
+            {
+                Chunk->SetChunkCoords(ChunkCoords);
+                Chunk->OnMeshGenerated(MoveTemp(Sections), NeighboursReady);
+            }
+            else
+            {
+                DEC_DWORD_STAT(STAT_BloxelsChunksUploading);
+            }
+        });
+    }
+}
+
 namespace VoxelChunkAsync
 {
-    void GenerateChunkDataAsync(TWeakObjectPtr<AVoxelChunk> Chunk, TWeakObjectPtr<AVoxelWorld> World, FIntVector ChunkCoords)
+    FVoxelJobContext MakeJobContext(const AVoxelWorld& World)
+    {
+        FVoxelJobContext JobContext;
+        JobContext.Generator = World.GetWorldGenerationSubsystem();
+        JobContext.Registry = World.GetVoxelRegistry();
+        JobContext.ChunkSize = World.GetWorldGenerationConfig()->ChunkSize;
+        JobContext.VoxelSize = World.GetWorldGenerationConfig()->VoxelSize;
+        JobContext.LightEngine = World.GetLightEngine();
+        JobContext.NavGrid = World.GetNavGrid();
+        JobContext.Scheduler = World.GetJobScheduler();
+        return JobContext;
+    }
+
+    UE::Tasks::FTaskEvent GenerateChunkDataAsync(TWeakObjectPtr<AVoxelChunk> Chunk, const FVoxelJobContext& JobContext, FIntVector ChunkCoords,
+        TSharedRef<FVoxelChunkDataSlot> Slot)
     {
-        UE::Tasks::Launch(TEXT("VoxelGen"), [Chunk, World, ChunkCoords]()
+        INC_DWORD_STAT(STAT_BloxelsChunksQueued);
+        return LaunchJob(JobContext, EVoxelJobLane::Generation, ChunkCoords, [Chunk, JobContext, ChunkCoords, Slot]()
         {
-            if (!Chunk.IsValid() || !World.IsValid()) return;
+            DEC_DWORD_STAT(STAT_BloxelsChunksQueued);
+            if (Slot->IsAbandoned()) return;
+
+            SCOPE_CYCLE_COUNTER(STAT_BloxelsGenerateChunkData);
+            LLM_SCOPE_BYTAG(Bloxels_VoxelData);
+            BLOXELS_TRACE_CHUNK_SCOPE("VoxelGen", ChunkCoords);
+            INC_DWORD_STAT(STAT_BloxelsChunksGenerating);
 
-            const int32 ChunkSize = World->GetWorldGenerationConfig()->ChunkSize;
-            const int32 ChunkX = ChunkCoords.X;
-            const int32 ChunkY = ChunkCoords.Y;
+            const int32 ChunkSize = JobContext.ChunkSize;
             const int32 ChunkZ = ChunkCoords.Z;
 
+            // Read before stamping, so a placement racing with this task is caught when the data is applied
+            const UWorldGenerationSubsystem& Generator = *JobContext.Generator;
+            const uint32 StructureVersion = Generator.GetStructureVersion();
+
             TArray<uint16> VoxelData;
-            VoxelData.SetNum(ChunkSize * ChunkSize * ChunkSize);
+            TArray<int32> SkyStart;
+            GenerateVoxelData(Generator, *JobContext.Registry, ChunkSize, ChunkCoords, VoxelData, SkyStart);
 
-        	// INITIALIZE ALL VOXELS TO AIR
-        	const uint16 AirID = World->GetVoxelRegistry()->GetIDFromName("Air");
-			VoxelData.Init(AirID, ChunkSize * ChunkSize * ChunkSize);
+            TArray<uint8> LightData;
+            if (JobContext.LightEngine)
+            {
+                JobContext.LightEngine->ComputeInitialLight(VoxelData, SkyStart, ChunkZ, LightData);
+            }
+            else
+            {
+                LightData.Init(VoxelLight::UnloadedLight, ChunkSize * ChunkSize * ChunkSize);
+            }
 
-            for (int x = 0; x < ChunkSize; ++x)
+            TSharedPtr<FVoxelNavChunk> NavData;
+            if (JobContext.NavGrid)
             {
-                for (int y = 0; y < ChunkSize; ++y)
-                {
-                    for (int z = 0; z < ChunkSize; ++z)
-                    {
-						const UWorldGenerationSubsystem* WorldGenerationSubsystem = World->GetWorldGenerationSubsystem();
-	                    const int WorldX = ChunkX * ChunkSize + x;
-	                    const int WorldY = ChunkY * ChunkSize + y;
-						const int WorldZ = ChunkZ * ChunkSize + z;
-                        const int Index = (z * ChunkSize * ChunkSize) + (y * ChunkSize) + x;
-                    	const FName VoxelType = WorldGenerationSubsystem->GetVoxelAtPosition(WorldX, WorldY, WorldZ);
-                        VoxelData[Index] = World->GetVoxelRegistry()->GetIDFromName(VoxelType);
-                    }
-                }
+                LLM_SCOPE_BYTAG(Bloxels_Navigation);
+                NavData = JobContext.NavGrid->BuildChunk(VoxelData);
             }
 
-            AsyncTask(ENamedThreads::GameThread, [VoxelData = MoveTemp(VoxelData), Chunk]()
+            // Mesh jobs waiting on this one read it from the slot, not from the chunk
+            const TSharedRef<FVoxelChunkData> Data = MakeShared<FVoxelChunkData>();
+            Data->VoxelData = MoveTemp(VoxelData);
+            Data->LightData = MoveTemp(LightData);
+            Data->StructureVersion = StructureVersion;
+            Slot->Set(Data);
+            DEC_DWORD_STAT(STAT_BloxelsChunksGenerating);
+
+            const double GeneratedTime = FPlatformTime::Seconds();
+            AsyncTask(ENamedThreads::GameThread, [Data, NavData = MoveTemp(NavData), Chunk, GeneratedTime]()
             {
                 if (Chunk.IsValid())
                 {
-                    Chunk->OnChunkDataGenerated(VoxelData);
+                    Chunk->OnChunkDataGenerated(Data, NavData, GeneratedTime);
                 }
             });
         });
     }
 
+    void GenerateVoxelData(const UWorldGenerationSubsystem& Generator, const UVoxelRegistrySubsystem& Registry, const int32 ChunkSize,
+        const FIntVector ChunkCoords, TArray<uint16>& OutVoxelData, TArray<int32>& OutSkyStart, FVoxelGenStageTimes* OutStageTimes)
+    {
+        const int32 ChunkX = ChunkCoords.X;
+        const int32 ChunkY = ChunkCoords.Y;
+        const int32 ChunkZ = ChunkCoords.Z;
+        const int32 ColumnCount = ChunkSize * ChunkSize;
+
+        // Biome and height only vary per column, so they're worked out once per column rather than per voxel
+        uint64 StageStart = FPlatformTime::Cycles64();
+        auto EndStage = [OutStageTimes, &StageStart](double FVoxelGenStageTimes::* Stage)
+        {
+            const uint64 Now = FPlatformTime::Cycles64();
+            if (OutStageTimes)
+            {
+                OutStageTimes->*Stage += FPlatformTime::ToSeconds64(Now - StageStart);
+            }
+            StageStart = Now;
+        };
+
+        TArray<const FBiomeProperties*> ColumnBiomes;
+        TArray<EBiome> ColumnBiomeTypes;
+        ColumnBiomes.SetNum(ColumnCount);
+        ColumnBiomeTypes.SetNum(ColumnCount);
+        for (int y = 0; y < ChunkSize; ++y)
+        {
+            for (int x = 0; x < ChunkSize; ++x)
+            {
+                const EBiome Biome = Generator.GetBiome(ChunkX * ChunkSize + x, ChunkY * ChunkSize + y);
+                ColumnBiomeTypes[(y * ChunkSize) + x] = Biome;
+                ColumnBiomes[(y * ChunkSize) + x] = Generator.GetBiomeData(Biome);
+            }
+        }
+        EndStage(&FVoxelGenStageTimes::Biome);
+
+        TArray<int32> ColumnHeights;
+        ColumnHeights.SetNum(ColumnCount);
+        for (int y = 0; y < ChunkSize; ++y)
+        {
+            for (int x = 0; x < ChunkSize; ++x)
+            {
+                const int Column = (y * ChunkSize) + x;
+                ColumnHeights[Column] = Generator.GetTerrainHeight(ChunkX * ChunkSize + x, ChunkY * ChunkSize + y, ColumnBiomeTypes[Column]);
+            }
+        }
+        EndStage(&FVoxelGenStageTimes::Height);
+
+        TArray<FName> VoxelTypes;
+        VoxelTypes.SetNum(ColumnCount * ChunkSize);
+        for (int x = 0; x < ChunkSize; ++x)
+        {
+            for (int y = 0; y < ChunkSize; ++y)
+            {
+                const int Column = (y * ChunkSize) + x;
+                for (int z = 0; z < ChunkSize; ++z)
+                {
+                    const int WorldX = ChunkX * ChunkSize + x;
+                    const int WorldY = ChunkY * ChunkSize + y;
+                    const int WorldZ = ChunkZ * ChunkSize + z;
+                    const int Index = (z * ChunkSize * ChunkSize) + (y * ChunkSize) + x;
+                    VoxelTypes[Index] = Generator.GetVoxelInColumn(WorldX, WorldY, WorldZ, ColumnHeights[Column], ColumnBiomes[Column]);
+                }
+            }
+        }
+        EndStage(&FVoxelGenStageTimes::Caves);
+
+        OutVoxelData.SetNumUninitialized(VoxelTypes.Num());
+        for (int32 Index = 0; Index < VoxelTypes.Num(); ++Index)
+        {
+            OutVoxelData[Index] = Registry.GetIDFromName(VoxelTypes[Index]);
+        }
+        EndStage(&FVoxelGenStageTimes::IDs);
+
+        // Columns are open to the sky above the terrain surface; caves below it stay dark. Nothing is generated above
+        // the generation height, so a surface past it is open from there.
+        const int32 GenerationHeight = Generator.GetConfig()->GetGenerationHeight();
+        OutSkyStart.SetNum(ColumnCount);
+        for (int32 Column = 0; Column < ColumnCount; ++Column)
+        {
+            OutSkyStart[Column] = FMath::Min(ColumnHeights[Column], GenerationHeight) + 1;
+        }
+
+        // Placed structures go in before light and navigation are built, so they cost no extra remesh
+        Generator.StampStructures(ChunkCoords, ChunkSize, OutVoxelData, &OutSkyStart);
+    }
+
 	void GenerateChunkMeshAsync(
 		TWeakObjectPtr<AVoxelChunk> Chunk,
-		TWeakObjectPtr<AVoxelWorld> World,
-		const TArray<uint16>& VoxelDataCopy,
-		FIntVector ChunkCoords)
+		const FVoxelJobContext& JobContext,
+		TSharedRef<const FVoxelChunkData> Data,
+		FIntVector ChunkCoords,
+		int32 SectionSize,
+		TArray<FSectionMeshData> Sections,
+		TArray<TSharedRef<FVoxelChunkRecord>> Neighbours)
+	{
+		INC_DWORD_STAT(STAT_BloxelsChunksQueued);
+		LaunchJob(JobContext, EVoxelJobLane::Meshing, ChunkCoords,
+			[Chunk, JobContext, Data, ChunkCoords, SectionSize, Sections = MoveTemp(Sections), Neighbours = MoveTemp(Neighbours)]() mutable
+		{
+			DEC_DWORD_STAT(STAT_BloxelsChunksQueued);
+
+			SCOPE_CYCLE_COUNTER(STAT_BloxelsGenerateChunkMesh);
+			LLM_SCOPE_BYTAG(Bloxels_MeshData);
+			BLOXELS_TRACE_CHUNK_SCOPE("VoxelMesh", ChunkCoords);
+			INC_DWORD_STAT(STAT_BloxelsChunksMeshing);
+
+			const FVoxelMeshContext Context = MakeSnapshotMeshContext(JobContext.Registry, JobContext.ChunkSize, JobContext.VoxelSize, ChunkCoords,
+				ReadNeighbours(Neighbours));
+			MeshAndUpload(Chunk, Context, Data->VoxelData, Data->LightData, SectionSize, MoveTemp(Sections), 0.0);
+		});
+	}
+
+	void GenerateFirstChunkMeshAsync(
+		TWeakObjectPtr<AVoxelChunk> Chunk,
+		const FVoxelJobContext& JobContext,
+		FIntVector ChunkCoords,
+		int32 SectionSize,
+		TArray<FSectionMeshData> Sections,
+		TSharedPtr<const FVoxelChunkData> OwnData,
+		TSharedRef<FVoxelChunkDataSlot> OwnSlot,
+		TArray<TSharedRef<FVoxelChunkRecord>> Neighbours,
+		TArray<UE::Tasks::FTaskEvent> Prerequisites)
 	{
-		UE::Tasks::Launch(TEXT("VoxelMeshTask"), [=]()
+		INC_DWORD_STAT(STAT_BloxelsChunksQueued);
+		LaunchJob(JobContext, EVoxelJobLane::Meshing, ChunkCoords,
+			[Chunk, JobContext, ChunkCoords, SectionSize, Sections = MoveTemp(Sections), OwnData, OwnSlot, Neighbours = MoveTemp(Neighbours)]() mutable
 		{
-			if (!Chunk.IsValid() || !World.IsValid())
+			DEC_DWORD_STAT(STAT_BloxelsChunksQueued);
+			if (OwnSlot->IsAbandoned())
+				return;
+
+			// Every prerequisite has published by now; an empty slot means its job was dropped at shutdown
+			const TSharedPtr<const FVoxelChunkData> Data = OwnData ? OwnData : OwnSlot->Get();
+			if (!Data)
 				return;
-			
-			const int ChunkSize = World->GetWorldGenerationConfig()->ChunkSize;
-
-			TMap<FMeshSectionKey, FMeshData> MeshSections;
-
-			// +Z (Top)
-			ProcessFace(
-				Chunk, World, MeshSections, VoxelDataCopy,
-				ChunkSize, ChunkSize, ChunkSize,
-				FVector(0, 0, 1),
-				[&](int x, int y, int z) { return GetIndex(x, y, z, ChunkSize); },
-				[&](int x, int y, int z) { return CheckVoxel(Chunk, ChunkCoords, x, y, z + 1); },
-				[](int x, int y, int z) { return FVector(x, y, z); }
-			);
-
-			// -Z (Bottom)
-			ProcessFace(
-				Chunk, World, MeshSections, VoxelDataCopy,
-				ChunkSize, ChunkSize, ChunkSize,
-				FVector(0, 0, -1),
-				[&](int x, int y, int z) { return GetIndex(x, y, z, ChunkSize); },
-				[&](int x, int y, int z) { return CheckVoxel(Chunk, ChunkCoords, x, y, z - 1); },
-				[](int x, int y, int z) { return FVector(x, y, z); }
-			);
-
-			// +Y (Front)
-			ProcessFace(
-				Chunk, World, MeshSections, VoxelDataCopy,
-				ChunkSize, ChunkSize, ChunkSize,
-				FVector(0, 1, 0),
-				[&](int x, int z, int y) { return GetIndex(x, y, z, ChunkSize); },
-				[&](int x, int z, int y) { return CheckVoxel(Chunk, ChunkCoords, x, y + 1, z); },
-				[](int x, int z, int y) { return FVector(x, y, z); }
-			);
-
-			// -Y (Back)
-			ProcessFace(
-				Chunk, World, MeshSections, VoxelDataCopy,
-				ChunkSize, ChunkSize, ChunkSize,
-				FVector(0, -1, 0),
-				[&](int x, int z, int y) { return GetIndex(x, y, z, ChunkSize); },
-				[&](int x, int z, int y) { return CheckVoxel(Chunk, ChunkCoords, x, y - 1, z); },
-				[](int x, int z, int y) { return FVector(x, y, z); }
-			);
-
-			// +X (Right)
-			ProcessFace(
-				Chunk, World, MeshSections, VoxelDataCopy,
-				ChunkSize, ChunkSize, ChunkSize,
-				FVector(1, 0, 0),
-
-				[&](int y, int z, int x) { return GetIndex(x, y, z, ChunkSize); },
-				[&](int y, int z, int x) { return CheckVoxel(Chunk, ChunkCoords, x + 1, y, z); },
-				[](int y, int z, int x) { return FVector(x + 1, y, z); }
-			);
-
-			// -X (Left)
-			ProcessFace(
-				Chunk, World, MeshSections, VoxelDataCopy,
-				ChunkSize, ChunkSize, ChunkSize,
-				FVector(-1, 0, 0),
-				[&](int y, int z, int x) { return GetIndex(x, y, z, ChunkSize); },
-				[&](int y, int z, int x) { return CheckVoxel(Chunk, ChunkCoords, x - 1, y, z); },
-				[](int y, int z, int x) { return FVector(x, y, z); }
-			);
-
-			// Apply result on game thread
-			AsyncTask(ENamedThreads::GameThread, [Chunk, ChunkCoords, MeshSections = MoveTemp(MeshSections)]()
+
+			const double NeighboursReady = FPlatformTime::Seconds();
+			SCOPE_CYCLE_COUNTER(STAT_BloxelsGenerateChunkMesh);
+			LLM_SCOPE_BYTAG(Bloxels_MeshData);
+			BLOXELS_TRACE_CHUNK_SCOPE("VoxelMesh", ChunkCoords);
+			INC_DWORD_STAT(STAT_BloxelsChunksMeshing);
+
+			const FVoxelMeshContext Context = MakeSnapshotMeshContext(JobContext.Registry, JobContext.ChunkSize, JobContext.VoxelSize, ChunkCoords,
+				ReadNeighbours(Neighbours));
+			MeshAndUpload(Chunk, Context, Data->VoxelData, Data->LightData, SectionSize, MoveTemp(Sections), NeighboursReady);
+		}, MoveTemp(Prerequisites));
+	}
+
+	FVoxelMeshContext MakeSnapshotMeshContext(const UVoxelRegistrySubsystem* Registry, const int32 ChunkSize, const int32 VoxelSize, const FIntVector ChunkCoords,
+		TArray<TPair<FIntVector, TSharedPtr<const FVoxelChunkData>>> Neighbours)
+	{
+		FVoxelMeshContext Context;
+		Context.Registry = Registry;
+		Context.ChunkSize = ChunkSize;
+		Context.VoxelSize = VoxelSize;
+		Context.ChunkCoords = ChunkCoords;
+
+		// Faces only look one voxel across, so there are at most six chunks to scan
+		using FNeighbours = TArray<TPair<FIntVector, TSharedPtr<const FVoxelChunkData>>>;
+		const TSharedRef<const FNeighbours> SharedNeighbours = MakeShared<const FNeighbours>(MoveTemp(Neighbours));
+		auto FindVoxel = [SharedNeighbours, ChunkSize](const FIntVector& WorldCoord, int32& OutIndex) -> const FVoxelChunkData*
+		{
+			const FIntVector Coord = AVoxelWorld::GetChunkCoord(WorldCoord, ChunkSize);
+			for (const TPair<FIntVector, TSharedPtr<const FVoxelChunkData>>& Neighbour : *SharedNeighbours)
 			{
-				if (Chunk.IsValid())
+				if (Neighbour.Key == Coord && Neighbour.Value.IsValid())
 				{
-					Chunk->SetChunkCoords(ChunkCoords);
-					Chunk->OnMeshGenerated(MeshSections);
+					const FIntVector Local = AVoxelWorld::GetLocalCoord(WorldCoord, ChunkSize);
+					OutIndex = GetIndex(Local.X, Local.Y, Local.Z, ChunkSize);
+					return Neighbour.Value.Get();
 				}
-			});
-		});
+			}
+			return nullptr;
+		};
+
+		Context.IsTransparentOutside = [FindVoxel, Registry](const FIntVector& WorldCoord)
+		{
+			int32 Index = 0;
+			const FVoxelChunkData* Data = FindVoxel(WorldCoord, Index);
+			if (!Data || !Data->VoxelData.IsValidIndex(Index)) return true;
+
+			const UVoxelData* Voxel = Registry->GetVoxelByID(Data->VoxelData[Index]);
+			return Voxel && Voxel->bIsTransparent;
+		};
+		Context.GetLightOutside = [FindVoxel](const FIntVector& WorldCoord)
+		{
+			int32 Index = 0;
+			const FVoxelChunkData* Data = FindVoxel(WorldCoord, Index);
+			return Data && Data->LightData.IsValidIndex(Index) ? Data->LightData[Index] : VoxelLight::UnloadedLight;
+		};
+		return Context;
+	}
+
+	void GenerateSectionMesh(
+		const FVoxelMeshContext& Context,
+		const TArray<uint16>& VoxelData,
+		const TArray<uint8>& LightData,
+		FIntVector SectionMin,
+		int32 SectionSize,
+		TMap<FMeshSectionKey, FMeshData>& MeshSections)
+	{
+		const int ChunkSize = Context.ChunkSize;
+		const FIntVector O = SectionMin;
+
+		// Sweeps only cover the section; coordinates handed to the callbacks are section-local
+
+		// +Z (Top)
+		ProcessFace(
+			Context, MeshSections, VoxelData,
+			SectionSize, SectionSize, SectionSize,
+			FVector(0, 0, 1),
+			[&](int x, int y, int z) { return GetIndex(O.X + x, O.Y + y, O.Z + z, ChunkSize); },
+			[&](int x, int y, int z) { return CheckVoxel(Context, VoxelData, O.X + x, O.Y + y, O.Z + z + 1); },
+			[&](int x, int y, int z) { return GetLight(Context, LightData, O.X + x, O.Y + y, O.Z + z + 1); },
+			[&](int x, int y, int z) { return FVector(O.X + x, O.Y + y, O.Z + z); }
+		);
+
+		// -Z (Bottom)
+		ProcessFace(
+			Context, MeshSections, VoxelData,
+			SectionSize, SectionSize, SectionSize,
+			FVector(0, 0, -1),
+			[&](int x, int y, int z) { return GetIndex(O.X + x, O.Y + y, O.Z + z, ChunkSize); },
+			[&](int x, int y, int z) { return CheckVoxel(Context, VoxelData, O.X + x, O.Y + y, O.Z + z - 1); },
+			[&](int x, int y, int z) { return GetLight(Context, LightData, O.X + x, O.Y + y, O.Z + z - 1); },
+			[&](int x, int y, int z) { return FVector(O.X + x, O.Y + y, O.Z + z); }
+		);
+
+		// +Y (Front)
+		ProcessFace(
+			Context, MeshSections, VoxelData,
+			SectionSize, SectionSize, SectionSize,
+			FVector(0, 1, 0),
+			[&](int x, int z, int y) { return GetIndex(O.X + x, O.Y + y, O.Z + z, ChunkSize); },
+			[&](int x, int z, int y) { return CheckVoxel(Context, VoxelData, O.X + x, O.Y + y + 1, O.Z + z); },
+			[&](int x, int z, int y) { return GetLight(Context, LightData, O.X + x, O.Y + y + 1, O.Z + z); },
+			[&](int x, int z, int y) { return FVector(O.X + x, O.Y + y, O.Z + z); }
+		);
+
+		// -Y (Back)
+		ProcessFace(
+			Context, MeshSections, VoxelData,
+			SectionSize, SectionSize, SectionSize,
+			FVector(0, -1, 0),
+			[&](int x, int z, int y) { return GetIndex(O.X + x, O.Y + y, O.Z + z, ChunkSize); },
+			[&](int x, int z, int y) { return CheckVoxel(Context, VoxelData, O.X + x, O.Y + y - 1, O.Z + z); },
+			[&](int x, int z, int y) { return GetLight(Context, LightData, O.X + x, O.Y + y - 1, O.Z + z); },
+			[&](int x, int z, int y) { return FVector(O.X + x, O.Y + y, O.Z + z); }
+		);
+
+		// +X (Right)
+		ProcessFace(
+			Context, MeshSections, VoxelData,
+			SectionSize, SectionSize, SectionSize,
+			FVector(1, 0, 0),
+			[&](int y, int z, int x) { return GetIndex(O.X + x, O.Y + y, O.Z + z, ChunkSize); },
+			[&](int y, int z, int x) { return CheckVoxel(Context, VoxelData, O.X + x + 1, O.Y + y, O.Z + z); },
+			[&](int y, int z, int x) { return GetLight(Context, LightData, O.X + x + 1, O.Y + y, O.Z + z); },
+			[&](int y, int z, int x) { return FVector(O.X + x + 1, O.Y + y, O.Z + z); }
+		);
+
+		// -X (Left)
+		ProcessFace(
+			Context, MeshSections, VoxelData,
+			SectionSize, SectionSize, SectionSize,
+			FVector(-1, 0, 0),
+			[&](int y, int z, int x) { return GetIndex(O.X + x, O.Y + y, O.Z + z, ChunkSize); },
+			[&](int y, int z, int x) { return CheckVoxel(Context, VoxelData, O.X + x - 1, O.Y + y, O.Z + z); },
+			[&](int y, int z, int x) { return GetLight(Context, LightData, O.X + x - 1, O.Y + y, O.Z + z); },
+			[&](int y, int z, int x) { return FVector(O.X + x, O.Y + y, O.Z + z); }
+		);
 	}
 
 
@@ -151,21 +436,34 @@ namespace VoxelChunkAsync
     	return (Z * ChunkSize * ChunkSize) + (Y * ChunkSize) + X;
     }
 
-	bool CheckVoxel(const TWeakObjectPtr<AVoxelChunk>& Chunk, FIntVector ChunkCoords, int X, int Y, int Z)
+	bool CheckVoxel(const FVoxelMeshContext& Context, const TArray<uint16>& VoxelData, int X, int Y, int Z)
+    {
+    	const int ChunkSize = Context.ChunkSize;
+    	if (X >= 0 && X < ChunkSize && Y >= 0 && Y < ChunkSize && Z >= 0 && Z < ChunkSize)
+    	{
+    		const int Index = GetIndex(X, Y, Z, ChunkSize);
+    		const UVoxelData* Voxel = VoxelData.IsValidIndex(Index) ? Context.Registry->GetVoxelByID(VoxelData[Index]) : nullptr;
+    		return Voxel && Voxel->bIsTransparent;
+    	}
+    	return Context.IsTransparentOutside && Context.IsTransparentOutside(Context.ChunkCoords * ChunkSize + FIntVector(X, Y, Z));
+    }
+
+	uint8 GetLight(const FVoxelMeshContext& Context, const TArray<uint8>& LightData, int X, int Y, int Z)
     {
-    	return Chunk.IsValid() ? Chunk->CheckVoxel(X, Y, Z, ChunkCoords) : false;
+    	const int ChunkSize = Context.ChunkSize;
+    	if (X >= 0 && X < ChunkSize && Y >= 0 && Y < ChunkSize && Z >= 0 && Z < ChunkSize)
+    	{
+    		return LightData.IsValidIndex(GetIndex(X, Y, Z, ChunkSize)) ? LightData[GetIndex(X, Y, Z, ChunkSize)] : VoxelLight::UnloadedLight;
+    	}
+    	return Context.GetLightOutside ? Context.GetLightOutside(Context.ChunkCoords * ChunkSize + FIntVector(X, Y, Z)) : VoxelLight::UnloadedLight;
     }
 
 	void AddMergedFace(
-	const TWeakObjectPtr<AVoxelChunk>& Chunk,
-	const TWeakObjectPtr<AVoxelWorld>& World,
-	FVector Position, FVector Normal, int32 Width, int32 Height,
+	int32 VoxelSize,
+	FVector Position, FVector Normal, int32 Width, int32 Height, const FLinearColor& Color,
 	TArray<FVector>& Vertices, TArray<int32>& Triangles,
-	TArray<FVector>& Normals, TArray<FVector2D>& UVs)
+	TArray<FVector>& Normals, TArray<FVector2D>& UVs, TArray<FLinearColor>& Colors)
     {
-    	if (!Chunk.IsValid() || !World.IsValid()) return;
-
-    	const int VoxelSize = World->GetWorldGenerationConfig()->VoxelSize;
     	int32 VertexIndex = Vertices.Num();
     	FVector Right, Up;
 
@@ -236,6 +534,7 @@ namespace VoxelChunkAsync
     	for (int i = 0; i < 4; i++)
     	{
     		Normals.Add(Normal);
+    		Colors.Add(Color);
     	}
 
     	UVs.Append({
@@ -247,16 +546,18 @@ namespace VoxelChunkAsync
     }
 
 	void ProcessFace(
-		const TWeakObjectPtr<AVoxelChunk>& Chunk,
-		const TWeakObjectPtr<AVoxelWorld>& World,
+		const FVoxelMeshContext& Context,
 		TMap<FMeshSectionKey, FMeshData>& MeshSections,
 		const TArray<uint16>& VoxelData,
 		int PrimaryCount, int ACount, int BCount, const FVector& Normal,
 		const std::function<int(int, int, int)>& GetVoxelIndex,
 		const std::function<bool(int, int, int)>& IsNeighborVisible,
+		const std::function<uint8(int, int, int)>& GetNeighborLight,
 		const std::function<FVector(int, int, int)>& GetVoxelPosition)
     {
-    	struct FVoxelFace { int16 VoxelType = 0; bool bVisible = false; };
+    	// Faces only merge when they share both type and light, so each quad carries a single light level
+    	struct FVoxelFace { int16 VoxelType = 0; uint8 Light = 0; bool bVisible = false; };
+    	const uint8 Axis = FMeshSectionKey::AxisFromNormal(Normal);
 
     	TArray<TArray<FVoxelFace>> Mask;
     	Mask.SetNum(ACount);
@@ -276,11 +577,11 @@ namespace VoxelChunkAsync
     				if (Index < 0 || Index >= VoxelData.Num()) continue;
 
     				const int16 VoxelType = VoxelData[Index];
-    				const UVoxelData* Voxel = World->GetVoxelRegistry()->GetVoxelByID(VoxelType);
+    				const UVoxelData* Voxel = Context.Registry->GetVoxelByID(VoxelType);
 
     				if (Voxel && !Voxel->bIsInvisible && IsNeighborVisible(A, B, P))
     				{
-    					Mask[A][B] = { VoxelType, true };
+    					Mask[A][B] = { VoxelType, GetNeighborLight(A, B, P), true };
     				}
     			}
     		}
@@ -294,7 +595,8 @@ namespace VoxelChunkAsync
     				int Width = 1;
     				while (A + Width < ACount &&
 						   Mask[A + Width][B].bVisible &&
-						   Mask[A + Width][B].VoxelType == Mask[A][B].VoxelType)
+						   Mask[A + Width][B].VoxelType == Mask[A][B].VoxelType &&
+						   Mask[A + Width][B].Light == Mask[A][B].Light)
     					++Width;
 
     				int Height = 1;
@@ -304,7 +606,8 @@ namespace VoxelChunkAsync
     					for (int i = 0; i < Width; ++i)
     					{
     						if (!Mask[A + i][B + Height].bVisible ||
-								Mask[A + i][B + Height].VoxelType != Mask[A][B].VoxelType)
+								Mask[A + i][B + Height].VoxelType != Mask[A][B].VoxelType ||
+								Mask[A + i][B + Height].Light != Mask[A][B].Light)
     						{
     							Expand = false;
     							break;
@@ -313,10 +616,10 @@ namespace VoxelChunkAsync
     					if (Expand) ++Height;
     				}
 
-    				FMeshSectionKey Key(Mask[A][B].VoxelType, Normal);
+    				FMeshSectionKey Key(Mask[A][B].VoxelType, Axis);
     				FMeshData& MeshData = MeshSections.FindOrAdd(Key);
-    				AddMergedFace(Chunk, World, GetVoxelPosition(A, B, P), Normal, Width, Height,
-						MeshData.Vertices, MeshData.Triangles, MeshData.Normals, MeshData.UVs);
+    				AddMergedFace(Context.VoxelSize, GetVoxelPosition(A, B, P), Normal, Width, Height, VoxelLight::ToVertexColor(Mask[A][B].Light),
+						MeshData.Vertices, MeshData.Triangles, MeshData.Normals, MeshData.UVs, MeshData.VertexColors);
 
 
     				for (int i = 0; i < Width; ++i)
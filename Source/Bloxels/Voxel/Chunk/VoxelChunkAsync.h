@@ -5,42 +5,128 @@
 #include <functional>
 
 #include "CoreMinimal.h"
+#include "VoxelChunkData.h"
+#include "Bloxels/Voxel/Core/MeshData.h"
 #include "Bloxels/Voxel/World/VoxelWorld.h"
+#include "Tasks/Task.h"
 
 struct FMeshData;
 struct FMeshSectionKey;
 class AVoxelChunk;
+class FVoxelJobScheduler;
+class FVoxelLightEngine;
+class FVoxelNavGrid;
+class UVoxelRegistrySubsystem;
+class UWorldGenerationSubsystem;
+
+// Seconds spent in each stage of VoxelChunkAsync::GenerateVoxelData, summed over calls
+struct FVoxelGenStageTimes
+{
+    double Biome = 0.0;
+    double Height = 0.0;
+    double Caves = 0.0;  // Per-voxel fill: cave carving and surface layers
+    double IDs = 0.0;    // Voxel names to registry IDs
+};
+
+// Everything the mesher reads besides the chunk's own voxel and light copies. Voxels and light beyond the
+// chunk border come from the two callbacks, so meshing needs no live chunk or world.
+struct FVoxelMeshContext
+{
+    const UVoxelRegistrySubsystem* Registry = nullptr;
+    int32 ChunkSize = 0;
+    int32 VoxelSize = 0;
+    FIntVector ChunkCoords = FIntVector::ZeroValue;
+
+    // World voxel coordinate in, true when that voxel lets faces show through
+    TFunction<bool(const FIntVector&)> IsTransparentOutside;
+    TFunction<uint8(const FIntVector&)> GetLightOutside;
+};
+
+// What chunk jobs need from the world, read on the game thread when a job is launched. Jobs never touch the
+// world or chunk actors; those are only checked in the game thread callbacks.
+struct FVoxelJobContext
+{
+    const UWorldGenerationSubsystem* Generator = nullptr;
+    const UVoxelRegistrySubsystem* Registry = nullptr;
+    int32 ChunkSize = 0;
+    int32 VoxelSize = 0;
+    TSharedPtr<FVoxelLightEngine> LightEngine;
+    TSharedPtr<FVoxelNavGrid> NavGrid;
+    TSharedPtr<FVoxelJobScheduler> Scheduler;
+};
 
 namespace VoxelChunkAsync
 {
-    // Chunk Data Generation
-    void GenerateChunkDataAsync(TWeakObjectPtr<AVoxelChunk> Chunk, TWeakObjectPtr<AVoxelWorld> World, FIntVector ChunkCoords);
+    // Game thread
+    FVoxelJobContext MakeJobContext(const AVoxelWorld& World);
+
+    // Chunk Data Generation. The data is in Slot by the time the returned event triggers; the chunk itself is
+    // updated afterwards on the game thread.
+    UE::Tasks::FTaskEvent GenerateChunkDataAsync(TWeakObjectPtr<AVoxelChunk> Chunk, const FVoxelJobContext& JobContext, FIntVector ChunkCoords,
+        TSharedRef<FVoxelChunkDataSlot> Slot);
 
-    // Chunk Mesh Generation
+    // Terrain voxels of one chunk and the first sky-lit Z of each column. Needs no world, so tools can call it.
+    void GenerateVoxelData(const UWorldGenerationSubsystem& Generator, const UVoxelRegistrySubsystem& Registry, int32 ChunkSize,
+        FIntVector ChunkCoords, TArray<uint16>& OutVoxelData, TArray<int32>& OutSkyStart, FVoxelGenStageTimes* OutStageTimes = nullptr);
+
+    // Chunk Mesh Generation, one entry in Sections per section to rebuild. Faces on the chunk border read what
+    // the Neighbours records have published when the job runs.
     void GenerateChunkMeshAsync(
         TWeakObjectPtr<AVoxelChunk> Chunk,
-        TWeakObjectPtr<AVoxelWorld> World,
-        const TArray<uint16>& VoxelDataCopy,
-        FIntVector ChunkCoords);
+        const FVoxelJobContext& JobContext,
+        TSharedRef<const FVoxelChunkData> Data,
+        FIntVector ChunkCoords,
+        int32 SectionSize,
+        TArray<FSectionMeshData> Sections,
+        TArray<TSharedRef<FVoxelChunkRecord>> Neighbours);
+
+    // A chunk's first mesh: starts once Prerequisites (its own and its neighbours' data tasks) are done and reads
+    // the data they published, so nothing waits on the game thread before the upload. OwnData, when set, is
+    // meshed instead of OwnSlot.
+    void GenerateFirstChunkMeshAsync(
+        TWeakObjectPtr<AVoxelChunk> Chunk,
+        const FVoxelJobContext& JobContext,
+        FIntVector ChunkCoords,
+        int32 SectionSize,
+        TArray<FSectionMeshData> Sections,
+        TSharedPtr<const FVoxelChunkData> OwnData,
+        TSharedRef<FVoxelChunkDataSlot> OwnSlot,
+        TArray<TSharedRef<FVoxelChunkRecord>> Neighbours,
+        TArray<UE::Tasks::FTaskEvent> Prerequisites);
+
+    // Context whose border lookups read neighbour snapshots; a chunk missing from Neighbours reads as unloaded air
+    FVoxelMeshContext MakeSnapshotMeshContext(const UVoxelRegistrySubsystem* Registry, int32 ChunkSize, int32 VoxelSize, FIntVector ChunkCoords,
+        TArray<TPair<FIntVector, TSharedPtr<const FVoxelChunkData>>> Neighbours);
+
+    void GenerateSectionMesh(
+        const FVoxelMeshContext& Context,
+        const TArray<uint16>& VoxelData,
+        const TArray<uint8>& LightData,
+        FIntVector SectionMin,
+        int32 SectionSize,
+        TMap<FMeshSectionKey, FMeshData>& MeshSections);
     
     int32 GetIndex(int X, int Y, int Z, int ChunkSize);
     
-    bool CheckVoxel(const TWeakObjectPtr<AVoxelChunk>& Chunk, FIntVector ChunkCoords, int X, int Y, int Z);
+    // True when the voxel at chunk-local X/Y/Z, which may lie outside the chunk, is transparent
+    bool CheckVoxel(const FVoxelMeshContext& Context, const TArray<uint16>& VoxelData, int X, int Y, int Z);
+
+    // Light of the voxel at chunk-local X/Y/Z, which may lie outside the chunk
+    uint8 GetLight(const FVoxelMeshContext& Context, const TArray<uint8>& LightData, int X, int Y, int Z);
     
     void AddMergedFace(
-        const TWeakObjectPtr<AVoxelChunk>& Chunk,
-        const TWeakObjectPtr<AVoxelWorld>& World,
-        FVector Position, FVector Normal, int32 Width, int32 Height,
+        int32 VoxelSize,
+        FVector Position, FVector Normal, int32 Width, int32 Height, const FLinearColor& Color,
         TArray<FVector>& Vertices, TArray<int32>& Triangles,
-        TArray<FVector>& Normals, TArray<FVector2D>& UVs);
+        TArray<FVector>& Normals, TArray<FVector2D>& UVs, TArray<FLinearColor>& Colors);
     
     void ProcessFace(
-        const TWeakObjectPtr<AVoxelChunk>& Chunk,
-        const TWeakObjectPtr<AVoxelWorld>& World,
+        const FVoxelMeshContext& Context,
         TMap<FMeshSectionKey, FMeshData>& MeshSections,
         const TArray<uint16>& VoxelData,
         int PrimaryCount, int ACount, int BCount, const FVector& Normal,
         const std::function<int(int, int, int)>& GetVoxelIndex,
         const std::function<bool(int, int, int)>& IsNeighborVisible,
+        const std::function<uint8(int, int, int)>& GetNeighborLight,
         const std::function<FVector(int, int, int)>& GetVoxelPosition);
 }
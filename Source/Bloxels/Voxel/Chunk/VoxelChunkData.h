@@ -0,0 +1,42 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#pragma once
+
+#include <atomic>
+
+#include "CoreMinimal.h"
+
+// A chunk's voxels and light as of one point in time. Never modified once published, so any thread may read it.
+struct FVoxelChunkData
+{
+	TArray<uint16> VoxelData;
+	TArray<uint8> LightData;
+	uint32 StructureVersion = 0;  // UWorldGenerationSubsystem::GetStructureVersion() when generation stamped structures in
+};
+
+// Where a chunk publishes its data for tasks that can't touch the actor: the data task fills it before it
+// completes, and committed edits replace it. Readers keep whichever snapshot they got.
+class FVoxelChunkDataSlot
+{
+public:
+	// Set on the game thread when the chunk unloads, so queued jobs for it can skip their work from any thread
+	void Abandon() { bAbandoned = true; }
+	bool IsAbandoned() const { return bAbandoned; }
+
+	TSharedPtr<const FVoxelChunkData> Get() const
+	{
+		FReadScopeLock ReadLock(Lock);
+		return Data;
+	}
+
+	void Set(TSharedPtr<const FVoxelChunkData> InData)
+	{
+		FWriteScopeLock WriteLock(Lock);
+		Data = MoveTemp(InData);
+	}
+
+private:
+	mutable FRWLock Lock;
+	TSharedPtr<const FVoxelChunkData> Data;
+	std::atomic<bool> bAbandoned{ false };
+};
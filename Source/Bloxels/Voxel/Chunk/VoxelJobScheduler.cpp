@@ -0,0 +1,218 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#include "VoxelJobScheduler.h"
+
+void FVoxelJobScheduler::Initialize(const int32 InMaxInFlight, const int32 InMaxQueued)
+{
+	FScopeLock ScopeLock(&Lock);
+	MaxInFlight = FMath::Max(1, InMaxInFlight);
+	MaxQueued = FMath::Max(0, InMaxQueued);
+	bShutdown = false;
+	StatsStartTime = FPlatformTime::Seconds();
+}
+
+void FVoxelJobScheduler::Shutdown()
+{
+	TArray<FJob> Dropped;
+	{
+		FScopeLock ScopeLock(&Lock);
+		bShutdown = true;
+		for (TArray<FJob>& Queue : Queues)
+		{
+			Dropped.Append(MoveTemp(Queue));
+			Queue.Reset();
+		}
+	}
+
+	// Anything waiting on these must not hang
+	for (FJob& Job : Dropped)
+	{
+		Job.Done.Trigger();
+	}
+}
+
+UE::Tasks::FTaskEvent FVoxelJobScheduler::Submit(const EVoxelJobLane Lane, const FIntVector& ChunkCoord, TUniqueFunction<void()> Job,
+	TArray<UE::Tasks::FTaskEvent> Prerequisites)
+{
+	FJob NewJob;
+	NewJob.ChunkCoord = ChunkCoord;
+	NewJob.Function = MoveTemp(Job);
+	UE::Tasks::FTaskEvent Done = NewJob.Done;
+
+	if (Prerequisites.Num() == 0)
+	{
+		Enqueue(Lane, MoveTemp(NewJob));
+		return Done;
+	}
+
+	// Until its prerequisites are done the job holds no slot and doesn't count towards saturation
+	TWeakPtr<FVoxelJobScheduler> WeakThis = AsShared();
+	UE::Tasks::Launch(TEXT("VoxelJobGate"), [WeakThis, Lane, NewJob = MoveTemp(NewJob)]() mutable
+	{
+		if (const TSharedPtr<FVoxelJobScheduler> Scheduler = WeakThis.Pin())
+		{
+			Scheduler->Enqueue(Lane, MoveTemp(NewJob));
+		}
+		else
+		{
+			NewJob.Done.Trigger();
+		}
+	}, Prerequisites, UE::Tasks::ETaskPriority::BackgroundNormal, UE::Tasks::EExtendedTaskPriority::Inline);
+	return Done;
+}
+
+void FVoxelJobScheduler::Enqueue(const EVoxelJobLane Lane, FJob&& Job)
+{
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (bShutdown)
+		{
+			Job.Done.Trigger();
+			return;
+		}
+		Job.Distance = GetDistance(Job.ChunkCoord, Focus);
+		Queues[static_cast<int32>(Lane)].HeapPush(MoveTemp(Job), &FVoxelJobScheduler::IsNearer);
+	}
+
+	Pump();
+}
+
+void FVoxelJobScheduler::SetFocus(const FIntVector& ChunkCoord)
+{
+	FScopeLock ScopeLock(&Lock);
+	if (ChunkCoord == Focus) return;
+
+	Focus = ChunkCoord;
+	for (TArray<FJob>& Queue : Queues)
+	{
+		for (FJob& Job : Queue)
+		{
+			Job.Distance = GetDistance(Job.ChunkCoord, Focus);
+		}
+		Queue.Heapify(&FVoxelJobScheduler::IsNearer);
+	}
+}
+
+int64 FVoxelJobScheduler::GetDistance(const FIntVector& ChunkCoord, const FIntVector& InFocus)
+{
+	const FIntVector Delta = ChunkCoord - InFocus;
+	return static_cast<int64>(Delta.X) * Delta.X + static_cast<int64>(Delta.Y) * Delta.Y + static_cast<int64>(Delta.Z) * Delta.Z;
+}
+
+bool FVoxelJobScheduler::IsSaturated() const
+{
+	FScopeLock ScopeLock(&Lock);
+	return MaxQueued > 0 && Queues[0].Num() + Queues[1].Num() >= MaxQueued;
+}
+
+bool FVoxelJobScheduler::IsSaturated(const EVoxelJobLane Lane) const
+{
+	FScopeLock ScopeLock(&Lock);
+	return MaxQueued > 0 && Queues[static_cast<int32>(Lane)].Num() >= MaxQueued;
+}
+
+void FVoxelJobScheduler::Pump()
+{
+	TArray<TPair<EVoxelJobLane, FJob>> ToRun;
+	{
+		FScopeLock ScopeLock(&Lock);
+		if (bShutdown) return;
+
+		const int32 LaneShare = FMath::Max(1, MaxInFlight / NumVoxelJobLanes);
+		while (Running[0] + Running[1] < MaxInFlight)
+		{
+			// A lane within its share goes first; otherwise a busy lane borrows the idle one's slots
+			int32 Lane = INDEX_NONE;
+			for (int32 Candidate = NumVoxelJobLanes - 1; Candidate >= 0; --Candidate)
+			{
+				if (Queues[Candidate].Num() > 0 && Running[Candidate] < LaneShare)
+				{
+					Lane = Candidate;
+					break;
+				}
+			}
+			if (Lane == INDEX_NONE)
+			{
+				for (int32 Candidate = NumVoxelJobLanes - 1; Candidate >= 0; --Candidate)
+				{
+					if (Queues[Candidate].Num() > 0)
+					{
+						Lane = Candidate;
+						++Stolen;
+						break;
+					}
+				}
+			}
+			if (Lane == INDEX_NONE) break;
+
+			FJob Job;
+			Queues[Lane].HeapPop(Job, &FVoxelJobScheduler::IsNearer, EAllowShrinking::No);
+
+			++Running[Lane];
+			ToRun.Emplace(static_cast<EVoxelJobLane>(Lane), MoveTemp(Job));
+		}
+	}
+
+	for (TPair<EVoxelJobLane, FJob>& Entry : ToRun)
+	{
+		Run(Entry.Key, MoveTemp(Entry.Value));
+	}
+}
+
+void FVoxelJobScheduler::Run(const EVoxelJobLane Lane, FJob&& Job)
+{
+	TWeakPtr<FVoxelJobScheduler> WeakThis = AsShared();
+	UE::Tasks::Launch(TEXT("VoxelJob"), [WeakThis, Lane, Job = MoveTemp(Job)]() mutable
+	{
+		const double StartTime = FPlatformTime::Seconds();
+		Job.Function();
+		const double Seconds = FPlatformTime::Seconds() - StartTime;
+		Job.Done.Trigger();
+
+		if (const TSharedPtr<FVoxelJobScheduler> Scheduler = WeakThis.Pin())
+		{
+			Scheduler->OnJobFinished(Lane, FPlatformTLS::GetCurrentThreadId(), Seconds);
+		}
+	}, UE::Tasks::ETaskPriority::BackgroundNormal);
+}
+
+void FVoxelJobScheduler::OnJobFinished(const EVoxelJobLane Lane, const uint32 ThreadId, const double Seconds)
+{
+	{
+		FScopeLock ScopeLock(&Lock);
+		--Running[static_cast<int32>(Lane)];
+		++Completed[static_cast<int32>(Lane)];
+		BusySeconds.FindOrAdd(ThreadId) += Seconds;
+	}
+	Pump();
+}
+
+FVoxelJobStats FVoxelJobScheduler::GetStats() const
+{
+	FScopeLock ScopeLock(&Lock);
+	FVoxelJobStats Stats;
+	Stats.MaxInFlight = MaxInFlight;
+	for (int32 Lane = 0; Lane < NumVoxelJobLanes; ++Lane)
+	{
+		Stats.Queued[Lane] = Queues[Lane].Num();
+		Stats.Running[Lane] = Running[Lane];
+		Stats.Completed[Lane] = Completed[Lane];
+	}
+	Stats.Stolen = Stolen;
+	Stats.WallSeconds = FPlatformTime::Seconds() - StatsStartTime;
+	for (const TPair<uint32, double>& Pair : BusySeconds)
+	{
+		Stats.ThreadBusySeconds.Add(Pair);
+	}
+	Stats.ThreadBusySeconds.Sort([](const TPair<uint32, double>& A, const TPair<uint32, double>& B) { return A.Value > B.Value; });
+	return Stats;
+}
+
+void FVoxelJobScheduler::ResetStats()
+{
+	FScopeLock ScopeLock(&Lock);
+	Completed[0] = Completed[1] = 0;
+	Stolen = 0;
+	BusySeconds.Reset();
+	StatsStartTime = FPlatformTime::Seconds();
+}
@@ -0,0 +1,82 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tasks/Task.h"
+
+enum class EVoxelJobLane : uint8
+{
+	Generation,
+	Meshing,
+};
+
+constexpr int32 NumVoxelJobLanes = 2;
+
+struct FVoxelJobStats
+{
+	int32 MaxInFlight = 0;
+	int32 Queued[NumVoxelJobLanes] = {};
+	int32 Running[NumVoxelJobLanes] = {};
+	int64 Completed[NumVoxelJobLanes] = {};
+	int64 Stolen = 0;  // Jobs that ran on the other lane's share of slots
+	double WallSeconds = 0.0;
+	TArray<TPair<uint32, double>> ThreadBusySeconds;  // Per worker thread id, since the last reset
+};
+
+/**
+ * Admission control for chunk generation and meshing jobs in front of UE::Tasks.
+ * At most MaxInFlight jobs run at once, at background priority so engine tasks go first. Queued jobs start nearest
+ * to the focus chunk first; each lane is a heap on distance to the focus, reordered when the focus moves. Each lane
+ * owns half the slots, and a lane with nothing queued lends its slots to the other. Producers check IsSaturated
+ * before adding more chunks, and remeshes hold back while their own lane is full.
+ */
+class BLOXELS_API FVoxelJobScheduler : public TSharedFromThis<FVoxelJobScheduler>
+{
+public:
+	void Initialize(int32 InMaxInFlight, int32 InMaxQueued);
+	// Queued jobs are dropped, their tasks still complete; running jobs finish
+	void Shutdown();
+
+	// Any thread. Job joins the queue once every prerequisite has completed; the returned event is triggered once Job has run.
+	UE::Tasks::FTaskEvent Submit(EVoxelJobLane Lane, const FIntVector& ChunkCoord, TUniqueFunction<void()> Job,
+		TArray<UE::Tasks::FTaskEvent> Prerequisites = {});
+
+	void SetFocus(const FIntVector& ChunkCoord);
+	bool IsSaturated() const;
+	bool IsSaturated(EVoxelJobLane Lane) const;
+
+	FVoxelJobStats GetStats() const;
+	void ResetStats();
+
+private:
+	struct FJob
+	{
+		FIntVector ChunkCoord;
+		int64 Distance = 0;  // Squared, to the focus when it was queued or last reordered
+		TUniqueFunction<void()> Function;
+		UE::Tasks::FTaskEvent Done{ TEXT("VoxelJobDone") };
+	};
+
+	mutable FCriticalSection Lock;
+	TArray<FJob> Queues[NumVoxelJobLanes];
+	int32 Running[NumVoxelJobLanes] = {};
+	int64 Completed[NumVoxelJobLanes] = {};
+	int64 Stolen = 0;
+	FIntVector Focus = FIntVector::ZeroValue;
+	int32 MaxInFlight = 1;
+	int32 MaxQueued = 0;
+	bool bShutdown = false;
+
+	TMap<uint32, double> BusySeconds;
+	double StatsStartTime = 0.0;
+
+	static int64 GetDistance(const FIntVector& ChunkCoord, const FIntVector& InFocus);
+	static bool IsNearer(const FJob& A, const FJob& B) { return A.Distance < B.Distance; }
+
+	void Enqueue(EVoxelJobLane Lane, FJob&& Job);
+	// Starts queued jobs while slots are free
+	void Pump();
+	void Run(EVoxelJobLane Lane, FJob&& Job);
+	void OnJobFinished(EVoxelJobLane Lane, uint32 ThreadId, double Seconds);
+};
@@ -0,0 +1,62 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ChunkKey.generated.h"
+
+namespace ChunkKey
+{
+	constexpr int32 AxisBits = 21;  // +-1M chunks per axis
+	constexpr uint64 AxisMask = (1ull << AxisBits) - 1;
+
+	inline int32 UnpackAxis(const uint64 Bits)
+	{
+		// Sign-extend the low AxisBits
+		return static_cast<int32>(static_cast<int64>((Bits & AxisMask) << (64 - AxisBits)) >> (64 - AxisBits));
+	}
+}
+
+/**
+ * Chunk coordinates packed into one 64-bit word, for chunk maps and sets. Compares as a single integer, and the
+ * hash mixes all three axes at once instead of combining per-axis hashes.
+ */
+USTRUCT()
+struct FChunkKey
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	uint64 Packed = 0;
+
+	FChunkKey() = default;
+
+	// Implicit, so chunk maps can still be indexed with coordinates
+	FChunkKey(const FIntVector& ChunkCoords)
+		: Packed((static_cast<uint64>(ChunkCoords.X) & ChunkKey::AxisMask)
+			| ((static_cast<uint64>(ChunkCoords.Y) & ChunkKey::AxisMask) << ChunkKey::AxisBits)
+			| ((static_cast<uint64>(ChunkCoords.Z) & ChunkKey::AxisMask) << (ChunkKey::AxisBits * 2)))
+	{
+	}
+
+	FIntVector ToCoords() const
+	{
+		return FIntVector(
+			ChunkKey::UnpackAxis(Packed),
+			ChunkKey::UnpackAxis(Packed >> ChunkKey::AxisBits),
+			ChunkKey::UnpackAxis(Packed >> (ChunkKey::AxisBits * 2)));
+	}
+
+	bool operator==(const FChunkKey& Other) const { return Packed == Other.Packed; }
+	bool operator!=(const FChunkKey& Other) const { return Packed != Other.Packed; }
+
+	// splitmix64 finaliser: neighbouring chunks differ in a few low bits per axis, which it spreads over the whole word
+	friend uint32 GetTypeHash(const FChunkKey& Key)
+	{
+		uint64 Hash = Key.Packed;
+		Hash = (Hash ^ (Hash >> 30)) * 0xbf58476d1ce4e5b9ull;
+		Hash = (Hash ^ (Hash >> 27)) * 0x94d049bb133111ebull;
+		Hash ^= Hash >> 31;
+		return static_cast<uint32>(Hash);
+	}
+};
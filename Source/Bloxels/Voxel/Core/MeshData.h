@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "MeshSectionKey.h"
 
 struct FMeshData
 {
@@ -12,4 +13,35 @@ struct FMeshData
     TArray<FVector2D> UVs;
     TArray<FLinearColor> VertexColors;
     TArray<FProcMeshTangent> Tangents;
+
+    void Append(const FMeshData& Other)
+    {
+        const int32 VertexOffset = Vertices.Num();
+
+        Vertices.Append(Other.Vertices);
+        Normals.Append(Other.Normals);
+        UVs.Append(Other.UVs);
+        VertexColors.Append(Other.VertexColors);
+        Tangents.Append(Other.Tangents);
+
+        Triangles.Reserve(Triangles.Num() + Other.Triangles.Num());
+        for (const int32 Index : Other.Triangles)
+        {
+            Triangles.Add(Index + VertexOffset);
+        }
+    }
+
+    SIZE_T GetAllocatedSize() const
+    {
+        return Vertices.GetAllocatedSize() + Triangles.GetAllocatedSize() + Normals.GetAllocatedSize()
+            + UVs.GetAllocatedSize() + VertexColors.GetAllocatedSize() + Tangents.GetAllocatedSize();
+    }
+};
+
+// Cached mesh for one cubic sub-section of a chunk
+struct FSectionMeshData
+{
+    int32 SectionIndex = INDEX_NONE;
+    uint32 SectionVersion = 0;  // Version of the section's voxel data this mesh was built from
+    TMap<FMeshSectionKey, FMeshData> MeshSections;
 };
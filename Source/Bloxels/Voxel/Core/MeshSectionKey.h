@@ -5,30 +5,45 @@
 #include "CoreMinimal.h"
 #include "Math/Vector.h"
 
+// One mesh section per voxel type and face direction
 struct FMeshSectionKey
 {
-    uint16 VoxelType;
-    FVector Normal;
+    uint16 VoxelType = 0;
+    uint8 Axis = 0;  // Face direction: +X, -X, +Y, -Y, +Z, -Z
 
-    FMeshSectionKey()
-        : VoxelType(0), Normal(FVector::ZeroVector)
+    FMeshSectionKey() = default;
+
+    FMeshSectionKey(uint16 InVoxelType, uint8 InAxis)
+        : VoxelType(InVoxelType), Axis(InAxis)
     {
     }
 
-    FMeshSectionKey(int16 InVoxelType, const FVector& InNormal)
-        : VoxelType(InVoxelType), Normal(InNormal)
+    // Normal must be one of the six axis directions
+    static uint8 AxisFromNormal(const FVector& Normal)
     {
+        if (Normal.X != 0) return Normal.X > 0 ? 0 : 1;
+        if (Normal.Y != 0) return Normal.Y > 0 ? 2 : 3;
+        return Normal.Z > 0 ? 4 : 5;
     }
 
-    bool operator==(const FMeshSectionKey& Other) const
+    FVector GetNormal() const
     {
-        return VoxelType == Other.VoxelType && Normal.Equals(Other.Normal, 0.01f); // Tolerance!
+        static const FVector Normals[] = {
+            FVector(1, 0, 0), FVector(-1, 0, 0),
+            FVector(0, 1, 0), FVector(0, -1, 0),
+            FVector(0, 0, 1), FVector(0, 0, -1)
+        };
+        return Axis < UE_ARRAY_COUNT(Normals) ? Normals[Axis] : FVector::ZeroVector;
     }
 
-    friend int16 GetTypeHash(const FMeshSectionKey& Key)
+    bool operator==(const FMeshSectionKey& Other) const
     {
-        return HashCombine(::GetTypeHash(Key.VoxelType), 
-            HashCombine(HashCombine(::GetTypeHash(Key.Normal.X), ::GetTypeHash(Key.Normal.Y)), ::GetTypeHash(Key.Normal.Z)));
+        return VoxelType == Other.VoxelType && Axis == Other.Axis;
     }
 
+    // Type and axis fit in the hash side by side, so distinct keys never collide
+    friend uint32 GetTypeHash(const FMeshSectionKey& Key)
+    {
+        return (static_cast<uint32>(Key.VoxelType) << 3) | Key.Axis;
+    }
 };
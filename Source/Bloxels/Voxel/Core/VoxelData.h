@@ -23,6 +23,9 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ToolTip = "Whether this block is Invisible. Should this block be rendered at all?"))
 	bool bIsInvisible = false;
 
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, meta = (ClampMin = 0, ClampMax = 15, ToolTip = "Block light given off by this block, from 0 (none) to 15 (brightest)."))
+	int32 LightEmission = 0;
+
 	UPROPERTY(EditAnywhere, BlueprintReadWrite)
 	UMaterialInterface* Material = nullptr;
 
@@ -0,0 +1,18 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct FVoxelEdit
+{
+    FIntVector Coord;  // World voxel coordinates
+    uint16 VoxelID = 0;
+
+    FVoxelEdit() = default;
+
+    FVoxelEdit(const FIntVector& InCoord, uint16 InVoxelID)
+        : Coord(InCoord), VoxelID(InVoxelID)
+    {
+    }
+};
@@ -0,0 +1,32 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#include "VoxelStats.h"
+
+DEFINE_STAT(STAT_BloxelsGenerateChunkData);
+DEFINE_STAT(STAT_BloxelsGenerateChunkMesh);
+DEFINE_STAT(STAT_BloxelsOnChunkDataGenerated);
+DEFINE_STAT(STAT_BloxelsDisplayMesh);
+DEFINE_STAT(STAT_BloxelsUpdateChunks);
+DEFINE_STAT(STAT_BloxelsFindPath);
+
+DEFINE_STAT(STAT_BloxelsChunksQueued);
+DEFINE_STAT(STAT_BloxelsChunksGenerating);
+DEFINE_STAT(STAT_BloxelsChunksMeshing);
+DEFINE_STAT(STAT_BloxelsChunksUploading);
+DEFINE_STAT(STAT_BloxelsChunksResident);
+
+DEFINE_STAT(STAT_BloxelsVoxelMemory);
+DEFINE_STAT(STAT_BloxelsMeshMemory);
+
+LLM_DEFINE_TAG(Bloxels);
+LLM_DEFINE_TAG(Bloxels_VoxelData);
+LLM_DEFINE_TAG(Bloxels_MeshData);
+LLM_DEFINE_TAG(Bloxels_Navigation);
+
+namespace VoxelStats
+{
+	FString ChunkScopeName(const TCHAR* Stage, const FIntVector& ChunkCoords)
+	{
+		return FString::Printf(TEXT("%s (%d,%d,%d)"), Stage, ChunkCoords.X, ChunkCoords.Y, ChunkCoords.Z);
+	}
+}
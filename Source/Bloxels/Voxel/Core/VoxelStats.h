@@ -0,0 +1,51 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Stats/Stats.h"
+
+// Shown with "stat Bloxels"
+DECLARE_STATS_GROUP(TEXT("Bloxels"), STATGROUP_Bloxels, STATCAT_Advanced);
+
+// Pipeline stages
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Generate Chunk Data"), STAT_BloxelsGenerateChunkData, STATGROUP_Bloxels, BLOXELS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Generate Chunk Mesh"), STAT_BloxelsGenerateChunkMesh, STATGROUP_Bloxels, BLOXELS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("On Chunk Data Generated"), STAT_BloxelsOnChunkDataGenerated, STATGROUP_Bloxels, BLOXELS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Display Mesh"), STAT_BloxelsDisplayMesh, STATGROUP_Bloxels, BLOXELS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Update Chunks"), STAT_BloxelsUpdateChunks, STATGROUP_Bloxels, BLOXELS_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Find Path"), STAT_BloxelsFindPath, STATGROUP_Bloxels, BLOXELS_API);
+
+// Chunks in each pipeline state. Queued: launched, waiting for a worker. Generating/Meshing: running on a worker.
+// Uploading: mesh built, waiting for the game thread to display it. Resident: spawned and not yet destroyed.
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Chunks Queued"), STAT_BloxelsChunksQueued, STATGROUP_Bloxels, BLOXELS_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Chunks Generating"), STAT_BloxelsChunksGenerating, STATGROUP_Bloxels, BLOXELS_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Chunks Meshing"), STAT_BloxelsChunksMeshing, STATGROUP_Bloxels, BLOXELS_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Chunks Uploading"), STAT_BloxelsChunksUploading, STATGROUP_Bloxels, BLOXELS_API);
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Chunks Resident"), STAT_BloxelsChunksResident, STATGROUP_Bloxels, BLOXELS_API);
+
+// Heap owned by resident chunks
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Voxel Buffers"), STAT_BloxelsVoxelMemory, STATGROUP_Bloxels, BLOXELS_API);
+DECLARE_MEMORY_STAT_EXTERN(TEXT("Mesh Buffers"), STAT_BloxelsMeshMemory, STATGROUP_Bloxels, BLOXELS_API);
+
+// LLM tags, shown under Bloxels in "stat LLMFULL" and memory insights
+LLM_DECLARE_TAG_API(Bloxels, BLOXELS_API);
+LLM_DECLARE_TAG_API(Bloxels_VoxelData, BLOXELS_API);
+LLM_DECLARE_TAG_API(Bloxels_MeshData, BLOXELS_API);
+LLM_DECLARE_TAG_API(Bloxels_Navigation, BLOXELS_API);
+
+namespace VoxelStats
+{
+	BLOXELS_API FString ChunkScopeName(const TCHAR* Stage, const FIntVector& ChunkCoords);
+}
+
+// CPU trace scope named after the stage and the chunk, e.g. "VoxelMesh (3,-2,1)", so Insights shows which chunk each
+// event belongs to. The name is only formatted while the CPU channel is being traced.
+#if CPUPROFILERTRACE_ENABLED
+#define BLOXELS_TRACE_CHUNK_SCOPE(Stage, ChunkCoords) \
+	TRACE_CPUPROFILER_EVENT_SCOPE_TEXT(UE_TRACE_CHANNELEXPR_IS_ENABLED(CpuChannel) ? *VoxelStats::ChunkScopeName(TEXT(Stage), ChunkCoords) : TEXT(Stage))
+#else
+#define BLOXELS_TRACE_CHUNK_SCOPE(Stage, ChunkCoords)
+#endif
@@ -0,0 +1,547 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#include "VoxelLightEngine.h"
+
+#include "Async/Async.h"
+#include "Bloxels/Voxel/Chunk/VoxelChunk.h"
+#include "Bloxels/Voxel/VoxelRegistry/VoxelRegistrySubsystem.h"
+#include "Bloxels/Voxel/World/VoxelWorld.h"
+#include "Bloxels/Voxel/World/WorldGenerationConfig.h"
+#include "Tasks/Task.h"
+
+namespace
+{
+    const FIntVector Directions[6] = {
+        {1, 0, 0}, {-1, 0, 0},
+        {0, 1, 0}, {0, -1, 0},
+        {0, 0, 1}, {0, 0, -1}
+    };
+    constexpr int32 DownDirection = 5;
+
+    enum class ELightChannel : uint8 { Sky, Block };
+
+    FORCEINLINE uint8 GetChannel(const uint8 Packed, const ELightChannel Channel)
+    {
+        return Channel == ELightChannel::Sky ? VoxelLight::GetSky(Packed) : VoxelLight::GetBlock(Packed);
+    }
+
+    FORCEINLINE void SetChannel(uint8& Packed, const ELightChannel Channel, const uint8 Level)
+    {
+        Packed = Channel == ELightChannel::Sky
+            ? VoxelLight::Pack(Level, VoxelLight::GetBlock(Packed))
+            : VoxelLight::Pack(VoxelLight::GetSky(Packed), Level);
+    }
+
+    // Sunlight travels straight down without falling off; everything else loses one level per step
+    FORCEINLINE uint8 GetSpreadLevel(const ELightChannel Channel, const int32 Direction, const uint8 Level)
+    {
+        if (Channel == ELightChannel::Sky && Direction == DownDirection && Level == VoxelLight::MaxLight)
+        {
+            return VoxelLight::MaxLight;
+        }
+        return Level > 0 ? Level - 1 : 0;
+    }
+
+    struct FLightNode
+    {
+        FIntVector Coord;
+        uint8 Level;
+    };
+
+    // A chunk as an update saw it. Empty arrays stand for a chunk that isn't loaded or lit yet.
+    struct FLightChunkCopy
+    {
+        TWeakObjectPtr<AVoxelChunk> Chunk;
+        uint32 DataVersion = 0;
+        TArray<uint16> VoxelData;
+        TArray<uint8> LightData;
+    };
+
+    enum class ELightResolve : uint8 { Found, Unloaded, NotCopied };
+
+    /** One incremental relight over chunk copies. Records every voxel whose light changed. */
+    struct FLightJob
+    {
+        const FVoxelLightEngine& Engine;
+        TMap<FChunkKey, FLightChunkCopy>& Chunks;
+        int32 ChunkSize;
+
+        TSet<FIntVector> ChangedVoxels;
+        TArray<FVoxelLightSeed> Escaped;
+        TArray<FLightNode> AddQueues[2];
+        TArray<FLightNode> RemoveQueues[2];
+
+        FLightJob(const FVoxelLightEngine& InEngine, TMap<FChunkKey, FLightChunkCopy>& InChunks, const int32 InChunkSize)
+            : Engine(InEngine), Chunks(InChunks), ChunkSize(InChunkSize)
+        {
+        }
+
+        ELightResolve Resolve(const FIntVector& Coord, FLightChunkCopy*& OutChunk, int32& OutIndex) const
+        {
+            FLightChunkCopy* Copy = Chunks.Find(AVoxelWorld::GetChunkCoord(Coord, ChunkSize));
+            if (!Copy) return ELightResolve::NotCopied;
+
+            // Not lit yet; light flows in once it loads
+            if (Copy->VoxelData.Num() == 0) return ELightResolve::Unloaded;
+
+            const FIntVector Local = AVoxelWorld::GetLocalCoord(Coord, ChunkSize);
+            OutChunk = Copy;
+            OutIndex = (Local.Z * ChunkSize * ChunkSize) + (Local.Y * ChunkSize) + Local.X;
+            return ELightResolve::Found;
+        }
+
+        void QueueNeighbours(const FIntVector& Coord)
+        {
+            for (const FIntVector& Direction : Directions)
+            {
+                FLightChunkCopy* Chunk;
+                int32 Index;
+                if (Resolve(Coord + Direction, Chunk, Index) == ELightResolve::Found)
+                {
+                    const uint8 Light = Chunk->LightData[Index];
+                    AddQueues[static_cast<int32>(ELightChannel::Sky)].Add({ Coord + Direction, VoxelLight::GetSky(Light) });
+                    AddQueues[static_cast<int32>(ELightChannel::Block)].Add({ Coord + Direction, VoxelLight::GetBlock(Light) });
+                }
+            }
+        }
+
+        void Remove(const ELightChannel Channel)
+        {
+            TArray<FLightNode>& Queue = RemoveQueues[static_cast<int32>(Channel)];
+            TArray<FLightNode>& AddQueue = AddQueues[static_cast<int32>(Channel)];
+
+            for (int32 Head = 0; Head < Queue.Num(); ++Head)
+            {
+                const FLightNode Node = Queue[Head];
+                bool bEscaped = false;
+
+                for (int32 Direction = 0; Direction < 6; ++Direction)
+                {
+                    const FIntVector Neighbour = Node.Coord + Directions[Direction];
+                    FLightChunkCopy* Chunk;
+                    int32 Index;
+                    if (const ELightResolve Result = Resolve(Neighbour, Chunk, Index); Result != ELightResolve::Found)
+                    {
+                        if (Result == ELightResolve::NotCopied && !bEscaped)
+                        {
+                            Escaped.Add({ Node.Coord, Node.Level, static_cast<uint8>(Channel), true });
+                            bEscaped = true;
+                        }
+                        continue;
+                    }
+
+                    uint8& Light = Chunk->LightData[Index];
+                    const uint8 Level = GetChannel(Light, Channel);
+                    if (Level == 0) continue;
+
+                    const bool bFedByNode = Level < Node.Level ||
+                        (Level == VoxelLight::MaxLight && GetSpreadLevel(Channel, Direction, Node.Level) == VoxelLight::MaxLight);
+
+                    if (bFedByNode)
+                    {
+                        SetChannel(Light, Channel, 0);
+                        ChangedVoxels.Add(Neighbour);
+                        Queue.Add({ Neighbour, Level });
+
+                        // Emitters keep their own light and refill the hole
+                        if (Channel == ELightChannel::Block)
+                        {
+                            if (const uint8 Emission = Engine.GetEmission(Chunk->VoxelData[Index]); Emission > 0)
+                            {
+                                SetChannel(Light, Channel, Emission);
+                                AddQueue.Add({ Neighbour, Emission });
+                            }
+                        }
+                    }
+                    else
+                    {
+                        // Brighter neighbour with another source; it relights the removed area
+                        AddQueue.Add({ Neighbour, Level });
+                    }
+                }
+            }
+
+            Queue.Reset();
+        }
+
+        void Propagate(const ELightChannel Channel)
+        {
+            TArray<FLightNode>& Queue = AddQueues[static_cast<int32>(Channel)];
+
+            for (int32 Head = 0; Head < Queue.Num(); ++Head)
+            {
+                const FIntVector Coord = Queue[Head].Coord;
+                FLightChunkCopy* Chunk;
+                int32 Index;
+                if (Resolve(Coord, Chunk, Index) != ELightResolve::Found) continue;
+
+                // Levels may have changed since the node was queued; always spread the current value
+                const uint8 Level = GetChannel(Chunk->LightData[Index], Channel);
+                if (Level == 0) continue;
+
+                bool bEscaped = false;
+                for (int32 Direction = 0; Direction < 6; ++Direction)
+                {
+                    const uint8 NewLevel = GetSpreadLevel(Channel, Direction, Level);
+                    if (NewLevel == 0) continue;
+
+                    const FIntVector Neighbour = Coord + Directions[Direction];
+                    FLightChunkCopy* NeighbourChunk;
+                    int32 NeighbourIndex;
+                    if (const ELightResolve Result = Resolve(Neighbour, NeighbourChunk, NeighbourIndex); Result != ELightResolve::Found)
+                    {
+                        if (Result == ELightResolve::NotCopied && !bEscaped)
+                        {
+                            Escaped.Add({ Coord, 0, static_cast<uint8>(Channel), false });
+                            bEscaped = true;
+                        }
+                        continue;
+                    }
+                    if (!Engine.IsTransparent(NeighbourChunk->VoxelData[NeighbourIndex])) continue;
+
+                    uint8& NeighbourLight = NeighbourChunk->LightData[NeighbourIndex];
+                    if (GetChannel(NeighbourLight, Channel) >= NewLevel) continue;
+
+                    SetChannel(NeighbourLight, Channel, NewLevel);
+                    ChangedVoxels.Add(Neighbour);
+                    Queue.Add({ Neighbour, NewLevel });
+                }
+            }
+
+            Queue.Reset();
+        }
+
+        void Run()
+        {
+            for (const ELightChannel Channel : { ELightChannel::Sky, ELightChannel::Block })
+            {
+                Remove(Channel);
+                Propagate(Channel);
+            }
+        }
+    };
+}
+
+// What one update takes to the worker and brings back
+struct FVoxelLightEngine::FLightUpdate
+{
+    TArray<FVoxelLightChange> Changes;
+    TArray<FIntVector> Loads;
+    TArray<FVoxelLightSeed> Seeds;
+    TMap<FChunkKey, FLightChunkCopy> Chunks;  // The chunks holding the changes, loads and seeds, and their face neighbours
+
+    TArray<FIntVector> ChangedVoxels;
+    TArray<FVoxelLightSeed> Escaped;
+};
+
+namespace VoxelLight
+{
+    FLinearColor ToVertexColor(const uint8 Packed)
+    {
+        const uint8 Level = FMath::Max(GetSky(Packed), GetBlock(Packed));
+        const float Brightness = FMath::Pow(0.8f, static_cast<float>(MaxLight - Level));
+        return FLinearColor(Brightness, Brightness, Brightness, 1.f);
+    }
+}
+
+void FVoxelLightEngine::Initialize(AVoxelWorld* InWorld, const UVoxelRegistrySubsystem* Registry)
+{
+    World = InWorld;
+    ChunkSize = InWorld->GetWorldGenerationConfig()->ChunkSize;
+
+    const int32 VoxelCount = Registry->GetVoxelCount();
+    TransparentTable.Init(false, VoxelCount);
+    EmissionTable.Init(0, VoxelCount);
+
+    for (int32 ID = 0; ID < VoxelCount; ++ID)
+    {
+        if (const UVoxelData* Voxel = Registry->GetVoxelByID(ID))
+        {
+            TransparentTable[ID] = Voxel->bIsTransparent || Voxel->bIsInvisible;
+            EmissionTable[ID] = static_cast<uint8>(FMath::Clamp(Voxel->LightEmission, 0, static_cast<int32>(VoxelLight::MaxLight)));
+        }
+    }
+}
+
+void FVoxelLightEngine::ComputeInitialLight(const TArray<uint16>& VoxelData, const TArray<int32>& SkyStart, const int32 ChunkZ, TArray<uint8>& OutLight) const
+{
+    const int32 NumVoxels = ChunkSize * ChunkSize * ChunkSize;
+    OutLight.Init(0, NumVoxels);
+
+    TArray<int32> Queues[2];
+
+    for (int32 Z = 0; Z < ChunkSize; ++Z)
+    {
+        const int32 WorldZ = ChunkZ * ChunkSize + Z;
+        for (int32 Y = 0; Y < ChunkSize; ++Y)
+        {
+            for (int32 X = 0; X < ChunkSize; ++X)
+            {
+                const int32 Index = (Z * ChunkSize * ChunkSize) + (Y * ChunkSize) + X;
+                const uint16 VoxelID = VoxelData[Index];
+
+                if (IsTransparent(VoxelID) && WorldZ >= SkyStart[(Y * ChunkSize) + X])
+                {
+                    SetChannel(OutLight[Index], ELightChannel::Sky, VoxelLight::MaxLight);
+                    Queues[static_cast<int32>(ELightChannel::Sky)].Add(Index);
+                }
+
+                if (const uint8 Emission = GetEmission(VoxelID); Emission > 0)
+                {
+                    SetChannel(OutLight[Index], ELightChannel::Block, Emission);
+                    Queues[static_cast<int32>(ELightChannel::Block)].Add(Index);
+                }
+            }
+        }
+    }
+
+    // Flood inside the chunk only; light crossing into neighbours is exchanged once the chunk is loaded
+    for (const ELightChannel Channel : { ELightChannel::Sky, ELightChannel::Block })
+    {
+        TArray<int32>& Queue = Queues[static_cast<int32>(Channel)];
+        for (int32 Head = 0; Head < Queue.Num(); ++Head)
+        {
+            const int32 Index = Queue[Head];
+            const uint8 Level = GetChannel(OutLight[Index], Channel);
+            const FIntVector Local(Index % ChunkSize, (Index / ChunkSize) % ChunkSize, Index / (ChunkSize * ChunkSize));
+
+            for (int32 Direction = 0; Direction < 6; ++Direction)
+            {
+                const uint8 NewLevel = GetSpreadLevel(Channel, Direction, Level);
+                if (NewLevel == 0) continue;
+
+                const FIntVector Neighbour = Local + Directions[Direction];
+                if (Neighbour.X < 0 || Neighbour.X >= ChunkSize ||
+                    Neighbour.Y < 0 || Neighbour.Y >= ChunkSize ||
+                    Neighbour.Z < 0 || Neighbour.Z >= ChunkSize)
+                {
+                    continue;
+                }
+
+                const int32 NeighbourIndex = (Neighbour.Z * ChunkSize * ChunkSize) + (Neighbour.Y * ChunkSize) + Neighbour.X;
+                if (!IsTransparent(VoxelData[NeighbourIndex]) || GetChannel(OutLight[NeighbourIndex], Channel) >= NewLevel) continue;
+
+                SetChannel(OutLight[NeighbourIndex], Channel, NewLevel);
+                Queue.Add(NeighbourIndex);
+            }
+        }
+    }
+}
+
+void FVoxelLightEngine::QueueVoxelChange(const FIntVector& Coord, const uint16 OldID, const uint16 NewID)
+{
+    PendingChanges.Add({ Coord, OldID, NewID });
+}
+
+void FVoxelLightEngine::QueueChunkLoaded(const FIntVector& ChunkCoord)
+{
+    PendingLoads.Add(ChunkCoord);
+}
+
+void FVoxelLightEngine::Flush()
+{
+    if (bUpdateInFlight) return;
+    if (PendingChanges.Num() == 0 && PendingLoads.Num() == 0 && PendingSeeds.Num() == 0) return;
+
+    const AVoxelWorld* VoxelWorld = World.Get();
+    if (!VoxelWorld) return;
+
+    const TSharedRef<FLightUpdate> Update = MakeShared<FLightUpdate>();
+    Update->Changes = MoveTemp(PendingChanges);
+    Update->Loads = MoveTemp(PendingLoads);
+    Update->Seeds = MoveTemp(PendingSeeds);
+    PendingChanges.Reset();
+    PendingLoads.Reset();
+    PendingSeeds.Reset();
+
+    TSet<FChunkKey> Centres;
+    for (const FVoxelLightChange& Change : Update->Changes) Centres.Add(AVoxelWorld::GetChunkCoord(Change.Coord, ChunkSize));
+    for (const FIntVector& ChunkCoord : Update->Loads) Centres.Add(ChunkCoord);
+    for (const FVoxelLightSeed& Seed : Update->Seeds) Centres.Add(AVoxelWorld::GetChunkCoord(Seed.Coord, ChunkSize));
+
+    // Light rarely travels further than one chunk; what does is carried on by the next update
+    for (const FChunkKey& Centre : Centres)
+    {
+        const FIntVector CentreCoord = Centre.ToCoords();
+        for (int32 Direction = -1; Direction < 6; ++Direction)
+        {
+            const FIntVector ChunkCoord = Direction < 0 ? CentreCoord : CentreCoord + Directions[Direction];
+            if (Update->Chunks.Contains(ChunkCoord)) continue;
+
+            FLightChunkCopy& Copy = Update->Chunks.Add(ChunkCoord);
+            AVoxelChunk* Chunk = VoxelWorld->FindChunk(ChunkCoord);
+            if (Chunk && Chunk->bHasData && Chunk->LightData.Num() == Chunk->VoxelData.Num())
+            {
+                Copy.Chunk = Chunk;
+                Copy.DataVersion = Chunk->GetDataVersion();
+                Copy.VoxelData = Chunk->VoxelData;
+                Copy.LightData = Chunk->LightData;
+            }
+        }
+    }
+
+    bUpdateInFlight = true;
+    TSharedRef<FVoxelLightEngine> This = AsShared();
+    UE::Tasks::Launch(TEXT("VoxelLightUpdate"), [This, Update]()
+    {
+        This->RunUpdate(*Update);
+
+        TWeakPtr<FVoxelLightEngine> WeakThis = This;
+        AsyncTask(ENamedThreads::GameThread, [WeakThis, Update]()
+        {
+            if (const TSharedPtr<FVoxelLightEngine> Engine = WeakThis.Pin())
+            {
+                Engine->ApplyUpdate(*Update);
+            }
+        });
+    }, UE::Tasks::ETaskPriority::BackgroundNormal);
+}
+
+void FVoxelLightEngine::RunUpdate(FLightUpdate& Update) const
+{
+    FLightJob Job(*this, Update.Chunks, ChunkSize);
+
+    for (const FVoxelLightSeed& Seed : Update.Seeds)
+    {
+        TArray<FLightNode>* Queues = Seed.bRemove ? Job.RemoveQueues : Job.AddQueues;
+        Queues[Seed.Channel].Add({ Seed.Coord, Seed.Level });
+    }
+
+    for (const FVoxelLightChange& Change : Update.Changes)
+    {
+        FLightChunkCopy* Chunk;
+        int32 Index;
+        if (Job.Resolve(Change.Coord, Chunk, Index) != ELightResolve::Found) continue;
+
+        // Read the voxel back: a later edit in the same queue may have replaced it already
+        const uint16 VoxelID = Chunk->VoxelData[Index];
+        uint8& Light = Chunk->LightData[Index];
+
+        if (const uint8 BlockLevel = VoxelLight::GetBlock(Light); BlockLevel > 0)
+        {
+            SetChannel(Light, ELightChannel::Block, 0);
+            Job.RemoveQueues[static_cast<int32>(ELightChannel::Block)].Add({ Change.Coord, BlockLevel });
+        }
+
+        if (const uint8 Emission = GetEmission(VoxelID); Emission > 0)
+        {
+            SetChannel(Light, ELightChannel::Block, Emission);
+            Job.AddQueues[static_cast<int32>(ELightChannel::Block)].Add({ Change.Coord, Emission });
+        }
+
+        if (IsTransparent(VoxelID))
+        {
+            // Light around the voxel can now flow through it
+            Job.QueueNeighbours(Change.Coord);
+        }
+        else if (const uint8 SkyLevel = VoxelLight::GetSky(Light); SkyLevel > 0)
+        {
+            SetChannel(Light, ELightChannel::Sky, 0);
+            Job.RemoveQueues[static_cast<int32>(ELightChannel::Sky)].Add({ Change.Coord, SkyLevel });
+        }
+
+        Job.ChangedVoxels.Add(Change.Coord);
+    }
+
+    // Exchange light across every face of newly loaded chunks, in both directions
+    for (const FIntVector& ChunkCoord : Update.Loads)
+    {
+        for (int32 Direction = 0; Direction < 6; ++Direction)
+        {
+            const int32 Axis = Direction / 2;
+            const int32 AxisA = (Axis + 1) % 3;
+            const int32 AxisB = (Axis + 2) % 3;
+
+            FIntVector Local;
+            Local[Axis] = Directions[Direction][Axis] > 0 ? ChunkSize - 1 : 0;
+
+            for (int32 A = 0; A < ChunkSize; ++A)
+            {
+                for (int32 B = 0; B < ChunkSize; ++B)
+                {
+                    Local[AxisA] = A;
+                    Local[AxisB] = B;
+
+                    const FIntVector Inside = ChunkCoord * ChunkSize + Local;
+                    for (const FIntVector& Coord : { Inside, Inside + Directions[Direction] })
+                    {
+                        FLightChunkCopy* Chunk;
+                        int32 Index;
+                        if (Job.Resolve(Coord, Chunk, Index) == ELightResolve::Found)
+                        {
+                            const uint8 Light = Chunk->LightData[Index];
+                            Job.AddQueues[static_cast<int32>(ELightChannel::Sky)].Add({ Coord, VoxelLight::GetSky(Light) });
+                            Job.AddQueues[static_cast<int32>(ELightChannel::Block)].Add({ Coord, VoxelLight::GetBlock(Light) });
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    Job.Run();
+
+    Update.ChangedVoxels = Job.ChangedVoxels.Array();
+    Update.Escaped = MoveTemp(Job.Escaped);
+}
+
+void FVoxelLightEngine::ApplyUpdate(FLightUpdate& Update)
+{
+    bUpdateInFlight = false;
+
+    AVoxelWorld* VoxelWorld = World.Get();
+    if (!VoxelWorld) return;
+
+    // Chunks edited or regenerated meanwhile keep their light; only the work that started in them runs again, on fresh
+    // copies, along with a face exchange to pull back whatever this update spread into them. Unloaded chunks are dropped.
+    TSet<FChunkKey> Skipped;
+    for (const TPair<FChunkKey, FLightChunkCopy>& Pair : Update.Chunks)
+    {
+        const FLightChunkCopy& Copy = Pair.Value;
+        if (Copy.VoxelData.Num() == 0) continue;
+
+        const AVoxelChunk* Chunk = Copy.Chunk.Get();
+        if (!Chunk)
+        {
+            Skipped.Add(Pair.Key);
+        }
+        else if (Chunk->GetDataVersion() != Copy.DataVersion)
+        {
+            Skipped.Add(Pair.Key);
+            PendingLoads.Add(Pair.Key.ToCoords());
+        }
+    }
+
+    if (Skipped.Num() > 0)
+    {
+        for (const FVoxelLightChange& Change : Update.Changes)
+        {
+            if (Skipped.Contains(AVoxelWorld::GetChunkCoord(Change.Coord, ChunkSize))) PendingChanges.Add(Change);
+        }
+        for (const FVoxelLightSeed& Seed : Update.Seeds)
+        {
+            if (Skipped.Contains(AVoxelWorld::GetChunkCoord(Seed.Coord, ChunkSize))) PendingSeeds.Add(Seed);
+        }
+        Update.ChangedVoxels.RemoveAllSwap([this, &Skipped](const FIntVector& Voxel)
+        {
+            return Skipped.Contains(AVoxelWorld::GetChunkCoord(Voxel, ChunkSize));
+        });
+    }
+
+    for (const FIntVector& Voxel : Update.ChangedVoxels)
+    {
+        const FLightChunkCopy& Copy = Update.Chunks.FindChecked(AVoxelWorld::GetChunkCoord(Voxel, ChunkSize));
+        const FIntVector Local = AVoxelWorld::GetLocalCoord(Voxel, ChunkSize);
+        const int32 Index = (Local.Z * ChunkSize * ChunkSize) + (Local.Y * ChunkSize) + Local.X;
+        Copy.Chunk->LightData[Index] = Copy.LightData[Index];
+    }
+
+    PendingSeeds.Append(MoveTemp(Update.Escaped));
+
+    if (Update.ChangedVoxels.Num() > 0)
+    {
+        // Commits an edit batch, which flushes whatever queued up meanwhile
+        VoxelWorld->OnLightChanged(Update.ChangedVoxels);
+    }
+    Flush();
+}
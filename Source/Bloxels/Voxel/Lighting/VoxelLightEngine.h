@@ -0,0 +1,86 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AVoxelWorld;
+class AVoxelChunk;
+class UVoxelRegistrySubsystem;
+
+// Per-voxel light is one byte: sky light in the high nibble, block light in the low nibble
+namespace VoxelLight
+{
+    constexpr uint8 MaxLight = 15;
+
+    FORCEINLINE uint8 GetSky(const uint8 Packed) { return Packed >> 4; }
+    FORCEINLINE uint8 GetBlock(const uint8 Packed) { return Packed & 0x0F; }
+    FORCEINLINE uint8 Pack(const uint8 Sky, const uint8 Block) { return static_cast<uint8>((Sky << 4) | (Block & 0x0F)); }
+
+    // Light used for faces that look into chunks that are not loaded
+    constexpr uint8 UnloadedLight = MaxLight << 4;
+
+    FLinearColor ToVertexColor(uint8 Packed);
+}
+
+struct FVoxelLightChange
+{
+    FIntVector Coord;  // World voxel coordinates
+    uint16 OldID = 0;
+    uint16 NewID = 0;
+};
+
+// Light an update could not follow because it reached a chunk it had no copy of; the next update carries it on
+struct FVoxelLightSeed
+{
+    FIntVector Coord;  // World voxel coordinates, inside a chunk the update had
+    uint8 Level = 0;
+    uint8 Channel = 0;
+    bool bRemove = false;
+};
+
+/**
+ * Flood-fill sky and block light.
+ * Fresh chunks get their internal light while their data is generated. Edits and chunk arrivals are queued on the
+ * game thread and relit incrementally on a worker, one update at a time. Each update works on copies of the chunks
+ * around its changes; the game thread writes back only the voxels whose light changed, then hands them to
+ * AVoxelWorld to dirty the mesh sections that show them.
+ */
+class BLOXELS_API FVoxelLightEngine : public TSharedFromThis<FVoxelLightEngine>
+{
+public:
+    void Initialize(AVoxelWorld* InWorld, const UVoxelRegistrySubsystem* Registry);
+
+    bool IsTransparent(const uint16 VoxelID) const { return TransparentTable.IsValidIndex(VoxelID) && TransparentTable[VoxelID]; }
+    uint8 GetEmission(const uint16 VoxelID) const { return EmissionTable.IsValidIndex(VoxelID) ? EmissionTable[VoxelID] : 0; }
+
+    /**
+     * Lights a freshly generated chunk in isolation. Safe on any thread.
+     * SkyStart holds, per column (X fastest), the lowest world Z that is open to the sky.
+     */
+    void ComputeInitialLight(const TArray<uint16>& VoxelData, const TArray<int32>& SkyStart, int32 ChunkZ, TArray<uint8>& OutLight) const;
+
+    // Game thread
+    void QueueVoxelChange(const FIntVector& Coord, uint16 OldID, uint16 NewID);
+    void QueueChunkLoaded(const FIntVector& ChunkCoord);
+    void Flush();
+
+private:
+    struct FLightUpdate;
+
+    TWeakObjectPtr<AVoxelWorld> World;
+    int32 ChunkSize = 0;
+
+    TBitArray<> TransparentTable;
+    TArray<uint8> EmissionTable;
+
+    TArray<FVoxelLightChange> PendingChanges;
+    TArray<FIntVector> PendingLoads;
+    TArray<FVoxelLightSeed> PendingSeeds;
+
+    // The next update copies its chunks only once the previous one's light is back in them
+    bool bUpdateInFlight = false;
+
+    void RunUpdate(FLightUpdate& Update) const;
+    void ApplyUpdate(FLightUpdate& Update);
+};
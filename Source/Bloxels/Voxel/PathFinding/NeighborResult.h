@@ -2,13 +2,13 @@
 
 #pragma once
 
-struct FPathfindingNode;
+#include "CoreMinimal.h"
 
 struct FNeighborResult
 {
-    TSharedPtr<FPathfindingNode> Node;
+    FIntVector Coord;
     float MoveCost;
 
-    FNeighborResult(TSharedPtr<FPathfindingNode> InNode, float InCost)
-        : Node(InNode), MoveCost(InCost) {}
+    FNeighborResult(const FIntVector& InCoord, float InCost)
+        : Coord(InCoord), MoveCost(InCost) {}
 };
@@ -0,0 +1,16 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+// Movement costs shared by every search
+namespace PathfindingCosts
+{
+	constexpr float StraightCost = 10.f;
+	constexpr float DiagonalCost = 14.f;
+	constexpr float StepUpCost = 5.f;
+	constexpr float FallCost = 3.f;
+	constexpr int MaxStepUp = 1;
+	constexpr int MaxFallDistance = 3;
+}
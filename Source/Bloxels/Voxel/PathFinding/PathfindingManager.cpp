@@ -5,223 +5,401 @@
 
 #include "NeighborResult.h"
 #include "PathfindingNode.h"
+#include "VoxelNavGrid.h"
+#include "VoxelJumpPointSearch.h"
+#include "VoxelNavHierarchy.h"
+#include "Algo/Reverse.h"
+#include "Bloxels/Voxel/Core/VoxelStats.h"
 #include "Bloxels/Voxel/World/VoxelWorld.h"
 
+namespace
+{
+    bool IsOverBudget(const FPathSearchParams& Params, const int32 Expanded, const double Deadline)
+    {
+        if (Params.MaxExpansions > 0 && Expanded >= Params.MaxExpansions) return true;
+        return Params.MaxMicroseconds > 0 && (Expanded & 63) == 0 && FPlatformTime::Seconds() >= Deadline;
+    }
+
+    int64 DistanceSquared(const FIntVector& A, const FIntVector& B)
+    {
+        const int64 DX = A.X - B.X;
+        const int64 DY = A.Y - B.Y;
+        const int64 DZ = A.Z - B.Z;
+        return DX * DX + DY * DY + DZ * DZ;
+    }
+
+    // Nearer the goal in 3D, then cheaper to reach. HCost ignores height, so it can't rank partial ends.
+    bool IsBetterPartial(const FPathfindingNode& A, const FPathfindingNode& B, const FIntVector& Goal)
+    {
+        const int64 DistA = DistanceSquared(A.Coord, Goal);
+        const int64 DistB = DistanceSquared(B.Coord, Goal);
+        return DistA < DistB || (DistA == DistB && A.GCost < B.GCost);
+    }
+
+    void AppendPathTo(const FPathSearchContext& Search, const int32 EndIndex, TArray<FVector>& OutPathPoints)
+    {
+        const int32 First = OutPathPoints.Num();
+        for (int32 Index = EndIndex; Index != INDEX_NONE; Index = Search.Nodes[Index].Parent)
+        {
+            OutPathPoints.Add(Search.Nodes[Index].WorldPosition());
+        }
+        Algo::Reverse(OutPathPoints.GetData() + First, OutPathPoints.Num() - First);
+    }
+}
 
 bool UPathfindingManager::FindPath(const FIntVector& StartCoord, const FIntVector& EndCoord, TArray<FVector>& OutPathPoints)
+{
+    FPathfindingStats Stats;
+    return FindPath(StartCoord, EndCoord, OutPathPoints, Stats);
+}
+
+bool UPathfindingManager::FindPath(const FIntVector& StartCoord, const FIntVector& EndCoord, TArray<FVector>& OutPathPoints, FPathfindingStats& OutStats, const EPathSearchMode Mode)
+{
+    FPathSearchParams Params;
+    Params.Start = StartCoord;
+    Params.End = EndCoord;
+    Params.Mode = Mode;
+    return FindPath(Params, OutPathPoints, OutStats);
+}
+
+bool UPathfindingManager::FindPath(const FPathSearchParams& Params, TArray<FVector>& OutPathPoints, FPathfindingStats& OutStats)
 {
     OutPathPoints.Empty();
+    OutStats = FPathfindingStats();
+
+    const TSharedPtr<FVoxelNavGrid> NavGrid = VoxelWorld ? VoxelWorld->GetNavGrid() : nullptr;
+    if (!NavGrid) return false;
+
+    return SearchPath(NavGrid->MakeQuery(), SearchContext, Params, OutPathPoints, OutStats);
+}
+
+bool UPathfindingManager::SearchPath(const FVoxelNavQuery& Nav, FPathSearchContext& Search, const FPathSearchParams& Params, TArray<FVector>& OutPathPoints, FPathfindingStats& OutStats)
+{
+    if (Nav.GetUnloadedPolicy() != Params.UnloadedChunks)
+    {
+        FVoxelNavQuery PolicyNav(Nav);
+        PolicyNav.SetUnloadedPolicy(Params.UnloadedChunks);
+        return SearchPath(PolicyNav, Search, Params, OutPathPoints, OutStats);
+    }
+
+    SCOPE_CYCLE_COUNTER(STAT_BloxelsFindPath);
+    BLOXELS_TRACE_CHUNK_SCOPE("FindPath", AVoxelWorld::GetChunkCoord(Params.Start, Nav.GetChunkSize()));
+
+    if (Params.Mode == EPathSearchMode::Hierarchical && VoxelNavHierarchy::IsWorthwhile(Params, Nav.GetChunkSize()))
+    {
+        if (VoxelNavHierarchy::FindPath(Nav, Search, Params, OutPathPoints, OutStats))
+        {
+            UE_LOG(LogTemp, Verbose, TEXT("Hierarchical path built with %d nodes."), OutPathPoints.Num());
+            return true;
+        }
+        if (OutStats.bCancelled) return false;
+
+        // Portals are sampled, so a route through a narrow gap can be missed; the exact search settles it
+    }
 
-    if (!IsWalkable(StartCoord) || !IsWalkable(EndCoord)) return false;
+    if (Params.Mode == EPathSearchMode::JumpPoint)
+    {
+        return VoxelJumpPointSearch::FindPath(Nav, Search, Params, OutPathPoints, OutStats);
+    }
 
-    TMap<FIntVector, TSharedPtr<FPathfindingNode>> NodeMap;
-    TArray<TSharedPtr<FPathfindingNode>> OpenSet;
+    // A goal in an unloaded chunk has no backward frontier, so that case searches one way
+    if (Params.bBidirectional && Nav.IsWalkable(Params.End))
+    {
+        return SearchBidirectional(Nav, Search, Params, OutPathPoints, OutStats);
+    }
 
-    TSharedPtr<FPathfindingNode> StartNode = MakeShared<FPathfindingNode>(StartCoord);
-    TSharedPtr<FPathfindingNode> EndNode = MakeShared<FPathfindingNode>(EndCoord);
+    OutPathPoints.Reset();
+    OutStats = FPathfindingStats();
 
-    NodeMap.Add(StartCoord, StartNode);
-    OpenSet.Add(StartNode);
+    const FIntVector StartCoord = Params.Start;
+    const FIntVector EndCoord = Params.End;
+    const bool bAllowPartial = Params.bAllowPartial || Params.UnloadedChunks == EUnloadedChunkPolicy::Unknown;
+    if (!Nav.IsWalkable(StartCoord)) return false;
 
-    while (!OpenSet.IsEmpty())
+    // An unloaded goal can't be reached, but it can be approached
+    if (!Nav.IsWalkable(EndCoord) && !(bAllowPartial && !Nav.IsLoaded(EndCoord))) return false;
+
+    const double StartTime = FPlatformTime::Seconds();
+    const double Deadline = StartTime + Params.MaxMicroseconds * 1e-6;
+    Search.Reset();
+
+    bool bAdded = false;
+    const int32 StartIndex = Search.FindOrAddNode(StartCoord, bAdded);
+    Search.Nodes[StartIndex].HCost = Heuristic(StartCoord, EndCoord);
+    Search.OpenSet.Push(StartIndex);
+
+    bool bFound = false;
+    int32 BestIndex = StartIndex;
+    while (!Search.OpenSet.IsEmpty())
     {
-        OpenSet.Sort([](const TSharedPtr<FPathfindingNode>& A, const TSharedPtr<FPathfindingNode>& B)
+        if (Params.CancelFlag && (OutStats.NodesExpanded & 255) == 0 && Params.CancelFlag->load(std::memory_order_relaxed))
+        {
+            OutStats.bCancelled = true;
+            break;
+        }
+        if (IsOverBudget(Params, OutStats.NodesExpanded, Deadline))
         {
-            return A->FCost() < B->FCost();
-        });
+            OutStats.bBudgetExhausted = true;
+            break;
+        }
 
-        TSharedPtr<FPathfindingNode> Current = OpenSet[0];
-        OpenSet.RemoveAt(0);
+        const int32 CurrentIndex = Search.OpenSet.Pop();
+        Search.Nodes[CurrentIndex].bClosed = true;
+        OutStats.NodesExpanded++;
 
-        if (Current->Coord == EndCoord)
+        if (IsBetterPartial(Search.Nodes[CurrentIndex], Search.Nodes[BestIndex], EndCoord))
         {
-            while (Current)
-            {
-                OutPathPoints.Insert(Current->WorldPosition(), 0);
-                Current = Current->Parent.Pin();
-            }
-            UE_LOG(LogTemp, Warning, TEXT("Path built with %d nodes."), OutPathPoints.Num());
-            return true;
+            BestIndex = CurrentIndex;
         }
 
-        for (const FNeighborResult& Neighbor : GetNeighbors(Current))
+        // Copy out: the pool may grow while neighbours are added
+        const FIntVector CurrentCoord = Search.Nodes[CurrentIndex].Coord;
+        const float CurrentGCost = Search.Nodes[CurrentIndex].GCost;
+
+        if (CurrentCoord == EndCoord)
         {
-            float NewGCost = Current->GCost + Neighbor.MoveCost;
+            AppendPathTo(Search, CurrentIndex, OutPathPoints);
+            OutStats.PathCost = CurrentGCost;
+            bFound = true;
+            break;
+        }
 
-            if (!NodeMap.Contains(Neighbor.Node->Coord) || NewGCost < Neighbor.Node->GCost)
-            {
-                Neighbor.Node->GCost = NewGCost;
-                Neighbor.Node->HCost = FVector::Dist(FVector(Neighbor.Node->Coord), FVector(EndCoord));
-                Neighbor.Node->Parent = Current;
+        GetNeighbors(Nav, CurrentCoord, Search.Neighbors);
+        for (const FNeighborResult& Neighbor : Search.Neighbors)
+        {
+            const int32 NeighborIndex = Search.FindOrAddNode(Neighbor.Coord, bAdded);
+            FPathfindingNode& Node = Search.Nodes[NeighborIndex];
+            if (Node.bClosed) continue;
 
-                NodeMap.Add(Neighbor.Node->Coord, Neighbor.Node);
+            const float NewGCost = CurrentGCost + Neighbor.MoveCost;
+            if (!bAdded && NewGCost >= Node.GCost) continue;
 
-                if (!OpenSet.Contains(Neighbor.Node))
-                {
-                    OpenSet.Add(Neighbor.Node);
-                }
+            Node.GCost = NewGCost;
+            Node.Parent = CurrentIndex;
+
+            if (bAdded)
+            {
+                Node.HCost = Heuristic(Neighbor.Coord, EndCoord);
+                Search.OpenSet.Push(NeighborIndex);
+            }
+            else if (Search.OpenSet.Contains(NeighborIndex))
+            {
+                Search.OpenSet.DecreaseKey(NeighborIndex);
             }
         }
     }
-    UE_LOG(LogTemp, Warning, TEXT("Pathfinding failed."));
+
+    OutStats.NodesGenerated = Search.Nodes.Num();
+    OutStats.Seconds = FPlatformTime::Seconds() - StartTime;
+
+    if (bFound)
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("Path built with %d nodes."), OutPathPoints.Num());
+        return true;
+    }
+    if (OutStats.bCancelled) return false;
+
+    if (bAllowPartial && BestIndex != StartIndex)
+    {
+        AppendPathTo(Search, BestIndex, OutPathPoints);
+        OutStats.PathCost = Search.Nodes[BestIndex].GCost;
+        OutStats.bPartial = true;
+        UE_LOG(LogTemp, Verbose, TEXT("Partial path built with %d nodes after %d expansions."), OutPathPoints.Num(), OutStats.NodesExpanded);
+        return false;
+    }
+
+    if (OutStats.bBudgetExhausted)
+    {
+        UE_LOG(LogTemp, Verbose, TEXT("Pathfinding ran out of budget after %d expansions."), OutStats.NodesExpanded);
+    }
+    else
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Pathfinding failed."));
+    }
     return false;
 }
 
-TArray<FNeighborResult> UPathfindingManager::GetNeighbors(TSharedPtr<FPathfindingNode> Node)
+bool UPathfindingManager::SearchBidirectional(const FVoxelNavQuery& Nav, FPathSearchContext& Search, const FPathSearchParams& Params, TArray<FVector>& OutPathPoints, FPathfindingStats& OutStats)
 {
-    const float StraightCost = 10.f;
-    const float DiagonalCost = 14.f;
-    const float StepUpCost = 5.f;
-    const float FallCost = 3.f;
-    const int MaxStepUp = 1;
-    const int MaxFallDistance = 3;
-
-    const TArray<TPair<FIntVector, float>> Directions = {
-        {FIntVector( 1,  0, 0), StraightCost},
-        {FIntVector(-1,  0, 0), StraightCost},
-        {FIntVector( 0,  1, 0), StraightCost},
-        {FIntVector( 0, -1, 0), StraightCost},
-        {FIntVector( 1,  1, 0), DiagonalCost},
-        {FIntVector( 1, -1, 0), DiagonalCost},
-        {FIntVector(-1,  1, 0), DiagonalCost},
-        {FIntVector(-1, -1, 0), DiagonalCost},
-    };
-
-    TArray<FNeighborResult> Neighbors;
-
-    for (const auto& DirPair : Directions)
-    {
-        const FIntVector Offset = DirPair.Key;
-        float MoveCost = DirPair.Value;
-        FIntVector BaseCoord = Node->Coord + Offset;
-
-        if (Offset.X != 0 && Offset.Y != 0 && !IsDiagonalAllowed(Node->Coord, Offset, MaxFallDistance))
+    OutPathPoints.Reset();
+    OutStats = FPathfindingStats();
+
+    const FIntVector StartCoord = Params.Start;
+    const FIntVector EndCoord = Params.End;
+    if (!Nav.IsWalkable(StartCoord) || !Nav.IsWalkable(EndCoord)) return false;
+
+    // The backward half searches over reversed links from the goal
+    static thread_local FPathSearchContext Backward;
+
+    const double StartTime = FPlatformTime::Seconds();
+    const double Deadline = StartTime + Params.MaxMicroseconds * 1e-6;
+    Search.Reset();
+    Backward.Reset();
+
+    bool bAdded = false;
+    const int32 StartIndex = Search.FindOrAddNode(StartCoord, bAdded);
+    Search.Nodes[StartIndex].HCost = Heuristic(StartCoord, EndCoord);
+    Search.OpenSet.Push(StartIndex);
+
+    const int32 GoalIndex = Backward.FindOrAddNode(EndCoord, bAdded);
+    Backward.Nodes[GoalIndex].HCost = Heuristic(EndCoord, StartCoord);
+    Backward.OpenSet.Push(GoalIndex);
+
+    // Cheapest join seen so far, as a node in each half
+    float BestCost = StartCoord == EndCoord ? 0.f : TNumericLimits<float>::Max();
+    int32 MeetForward = StartIndex;
+    int32 MeetBackward = GoalIndex;
+    int32 BestIndex = StartIndex;
+
+    while (!Search.OpenSet.IsEmpty() && !Backward.OpenSet.IsEmpty())
+    {
+        // A path not found yet crosses both frontiers, so it costs at least the larger of their lowest f
+        const float Bound = FMath::Max(Search.Nodes[Search.OpenSet.Top()].FCost(), Backward.Nodes[Backward.OpenSet.Top()].FCost());
+        if (Bound >= BestCost) break;
+
+        if (Params.CancelFlag && (OutStats.NodesExpanded & 255) == 0 && Params.CancelFlag->load(std::memory_order_relaxed))
         {
-            continue;
+            OutStats.bCancelled = true;
+            break;
         }
-
-        // Try same level
-        if (auto N = CreateNode(BaseCoord))
+        if (IsOverBudget(Params, OutStats.NodesExpanded, Deadline))
         {
-            Neighbors.Add(FNeighborResult(N, MoveCost));
-            continue;
+            OutStats.bBudgetExhausted = true;
+            break;
         }
 
-        // Step up
-        TryStepUp(Neighbors, BaseCoord, MoveCost, StepUpCost, MaxStepUp);
+        // Grow the smaller frontier
+        const bool bForward = Search.OpenSet.Num() <= Backward.OpenSet.Num();
+        FPathSearchContext& Side = bForward ? Search : Backward;
+        const FPathSearchContext& Other = bForward ? Backward : Search;
+        const FIntVector& Target = bForward ? EndCoord : StartCoord;
 
-        // Drop down
-        TryFallDown(Neighbors, Node->Coord, Offset, MoveCost, FallCost, MaxFallDistance);
-    }
+        const int32 CurrentIndex = Side.OpenSet.Pop();
+        Side.Nodes[CurrentIndex].bClosed = true;
+        OutStats.NodesExpanded++;
 
-    return Neighbors;
-}
+        if (bForward && IsBetterPartial(Search.Nodes[CurrentIndex], Search.Nodes[BestIndex], EndCoord))
+        {
+            BestIndex = CurrentIndex;
+        }
 
+        const FIntVector CurrentCoord = Side.Nodes[CurrentIndex].Coord;
+        const float CurrentGCost = Side.Nodes[CurrentIndex].GCost;
 
-TSharedPtr<FPathfindingNode> UPathfindingManager::CreateNode(const FIntVector& Coord)
-{
-    if (!IsWalkable(Coord)) return nullptr;
-    return MakeShared<FPathfindingNode>(Coord);
-}
+        if (bForward)
+        {
+            GetNeighbors(Nav, CurrentCoord, Side.Neighbors);
+        }
+        else
+        {
+            Side.Neighbors.Reset();
+            VoxelNav::AppendPredecessors(Nav, CurrentCoord, Side.Neighbors);
+        }
 
-bool UPathfindingManager::IsWalkable(const FIntVector& Coord) const
-{
-    FIntVector Below = Coord - FIntVector(0, 0, 1);
-    return IsAir(Coord) && IsAir(Coord + FIntVector(0, 0, 1)) && IsSolid(Below);
-}
+        for (const FNeighborResult& Neighbor : Side.Neighbors)
+        {
+            const int32 NeighborIndex = Side.FindOrAddNode(Neighbor.Coord, bAdded);
+            FPathfindingNode& Node = Side.Nodes[NeighborIndex];
+            if (Node.bClosed) continue;
 
-bool UPathfindingManager::IsAir(const FIntVector& Coord) const
-{
-    if (!VoxelWorld) return false;
-    
-    uint16 Voxel = VoxelWorld->GetVoxelAtWorldCoordinates(Coord.X, Coord.Y, Coord.Z);
-    return VoxelWorld->GetVoxelRegistry()->GetVoxelByID(Voxel)->VoxelID == FName("Air");
-}
+            const float NewGCost = CurrentGCost + Neighbor.MoveCost;
+            if (!bAdded && NewGCost >= Node.GCost) continue;
 
-void UPathfindingManager::SetVoxelWorld(AVoxelWorld* InWorld)
-{
-    VoxelWorld = InWorld;
-}
+            Node.GCost = NewGCost;
+            Node.Parent = CurrentIndex;
 
-bool UPathfindingManager::IsDiagonalAllowed(const FIntVector& Coord, const FIntVector& Offset, int MaxFallDistance) const
-{
-    FIntVector Side1 = Coord + FIntVector(Offset.X, 0, 0);
-    FIntVector Side2 = Coord + FIntVector(0, Offset.Y, 0);
-    FIntVector UpOffset(0, 0, 1);
+            if (bAdded)
+            {
+                Node.HCost = Heuristic(Neighbor.Coord, Target);
+                Side.OpenSet.Push(NeighborIndex);
+            }
+            else if (Side.OpenSet.Contains(NeighborIndex))
+            {
+                Side.OpenSet.DecreaseKey(NeighborIndex);
+            }
+
+            if (const int32* OtherIndex = Other.NodeLookup.Find(PathfindingCoord::Pack(Neighbor.Coord)))
+            {
+                const float Total = NewGCost + Other.Nodes[*OtherIndex].GCost;
+                if (Total < BestCost)
+                {
+                    BestCost = Total;
+                    MeetForward = bForward ? NeighborIndex : *OtherIndex;
+                    MeetBackward = bForward ? *OtherIndex : NeighborIndex;
+                }
+            }
+        }
+    }
 
-    if (IsAir(Side1) && IsAir(Side1 + UpOffset) && IsAir(Side2) && IsAir(Side2 + UpOffset))
+    OutStats.NodesGenerated = Search.Nodes.Num() + Backward.Nodes.Num();
+    OutStats.Seconds = FPlatformTime::Seconds() - StartTime;
+    if (OutStats.bCancelled) return false;
+
+    // A join found before the budget ran out is a complete path, if not a proven cheapest one
+    if (BestCost < TNumericLimits<float>::Max())
     {
-        FIntVector Diagonal = Coord + Offset;
+        AppendPathTo(Search, MeetForward, OutPathPoints);
 
-        for (int Drop = 1; Drop <= MaxFallDistance; ++Drop)
+        // Backward parents lead towards the goal
+        for (int32 Index = Backward.Nodes[MeetBackward].Parent; Index != INDEX_NONE; Index = Backward.Nodes[Index].Parent)
         {
-            FIntVector DropCoord = Diagonal - FIntVector(0, 0, Drop);
-            if (IsWalkable(DropCoord)) return true;
-            if (IsSolid(DropCoord)) break;
+            OutPathPoints.Add(Backward.Nodes[Index].WorldPosition());
         }
-    }
 
-    // If not dropping, enforce no corner cutting
-    return IsWalkable(Side1) && IsWalkable(Side2);
-}
+        OutStats.PathCost = Search.Nodes[MeetForward].GCost + Backward.Nodes[MeetBackward].GCost;
+        UE_LOG(LogTemp, Verbose, TEXT("Bidirectional path built with %d nodes."), OutPathPoints.Num());
+        return true;
+    }
 
+    const bool bAllowPartial = Params.bAllowPartial || Params.UnloadedChunks == EUnloadedChunkPolicy::Unknown;
+    if (bAllowPartial && BestIndex != StartIndex)
+    {
+        AppendPathTo(Search, BestIndex, OutPathPoints);
+        OutStats.PathCost = Search.Nodes[BestIndex].GCost;
+        OutStats.bPartial = true;
+        return false;
+    }
 
-void UPathfindingManager::TryStepUp(
-    TArray<FNeighborResult>& OutNeighbors,
-    const FIntVector& Coord,
-    float MoveCost,
-    float StepCost,
-    int MaxStep
-)
-{
-    for (int Step = 1; Step <= MaxStep; ++Step)
+    if (!OutStats.bBudgetExhausted)
     {
-        FIntVector StepCoord = Coord + FIntVector(0, 0, Step);
-        if (auto N = CreateNode(StepCoord))
-        {
-            OutNeighbors.Add(FNeighborResult(N, MoveCost + StepCost));
-            break;
-        }
+        UE_LOG(LogTemp, Warning, TEXT("Pathfinding failed."));
     }
+    return false;
 }
 
-
-void UPathfindingManager::TryFallDown(
-    TArray<FNeighborResult>& OutNeighbors,
-    const FIntVector& NodeCoord,
-    const FIntVector& Offset,
-    float MoveCost,
-    float FallCost,
-    int MaxFall
-)
+void UPathfindingManager::GetNeighbors(const FVoxelNavQuery& Nav, const FIntVector& Coord, TArray<FNeighborResult>& OutNeighbors)
 {
-    FIntVector Side1 = NodeCoord + FIntVector(Offset.X, 0, 0);
-    FIntVector Side2 = NodeCoord + FIntVector(0, Offset.Y, 0);
-    FIntVector Up(0, 0, 1);
+    // Step-up, fall and diagonal corner rules are baked into the voxel's links
+    OutNeighbors.Reset();
+    VoxelNav::AppendNeighbors(Coord, Nav.GetLinks(Coord), OutNeighbors);
+}
 
-    if (!(IsAir(Side1) && IsAir(Side1 + Up) && IsAir(Side2) && IsAir(Side2 + Up)))
-        return;
+float UPathfindingManager::Heuristic(const FIntVector& From, const FIntVector& To)
+{
+    const int32 DX = FMath::Abs(To.X - From.X);
+    const int32 DY = FMath::Abs(To.Y - From.Y);
+    return PathfindingCosts::StraightCost * FMath::Max(DX, DY) +
+        (PathfindingCosts::DiagonalCost - PathfindingCosts::StraightCost) * FMath::Min(DX, DY);
+}
 
-    FIntVector Start = NodeCoord + Offset;
+bool UPathfindingManager::FindWalkableInColumn(const int32 X, const int32 Y, const int32 MaxZ, const int32 MinZ, FIntVector& OutCoord) const
+{
+    const TSharedPtr<FVoxelNavGrid> NavGrid = VoxelWorld ? VoxelWorld->GetNavGrid() : nullptr;
+    if (!NavGrid) return false;
 
-    for (int Drop = 1; Drop <= MaxFall; ++Drop)
+    const FVoxelNavQuery Nav = NavGrid->MakeQuery();
+    for (int32 Z = MaxZ; Z >= MinZ; --Z)
     {
-        FIntVector FallCoord = Start - FIntVector(0, 0, Drop);
-        if (auto N = CreateNode(FallCoord))
+        if (Nav.IsWalkable(FIntVector(X, Y, Z)))
         {
-            OutNeighbors.Add(FNeighborResult(N, MoveCost + FallCost * Drop));
-            break;
+            OutCoord = FIntVector(X, Y, Z);
+            return true;
         }
-        if (IsSolid(FallCoord))
-            break;
     }
+    return false;
 }
 
-
-bool UPathfindingManager::IsSolid(const FIntVector& Coord) const
+void UPathfindingManager::SetVoxelWorld(AVoxelWorld* InWorld)
 {
-    if (!VoxelWorld) return false;
-    
-    uint16 Voxel = VoxelWorld->GetVoxelAtWorldCoordinates(Coord.X, Coord.Y, Coord.Z);
-    return VoxelWorld->GetVoxelRegistry()->GetVoxelByID(Voxel)->bIsSolid;
+    VoxelWorld = InWorld;
 }
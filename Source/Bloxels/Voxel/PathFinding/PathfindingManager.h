@@ -4,11 +4,24 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "PathfindingCosts.h"
+#include "PathfindingSearch.h"
 #include "Bloxels/Voxel/World/VoxelWorld.h"
 #include "PathfindingManager.generated.h"
 
-struct FPathfindingNode;
 struct FNeighborResult;
+class FVoxelNavQuery;
+
+struct FPathfindingStats
+{
+	int32 NodesExpanded = 0;   // Nodes popped from the open set
+	int32 NodesGenerated = 0;  // Nodes allocated in the pool
+	float PathCost = 0.f;
+	double Seconds = 0.0;
+	bool bCancelled = false;
+	bool bBudgetExhausted = false;  // Stopped by MaxExpansions or MaxMicroseconds
+	bool bPartial = false;          // The path ends short of the goal
+};
 
 UCLASS()
 class BLOXELS_API UPathfindingManager : public UObject
@@ -19,21 +32,34 @@ public:
 
 	UFUNCTION()
 	bool FindPath(const FIntVector& StartCoord, const FIntVector& EndCoord, TArray<FVector>& OutPathPoints);
+	bool FindPath(const FIntVector& StartCoord, const FIntVector& EndCoord, TArray<FVector>& OutPathPoints, FPathfindingStats& OutStats,
+		EPathSearchMode Mode = EPathSearchMode::AStar);
+	bool FindPath(const FPathSearchParams& Params, TArray<FVector>& OutPathPoints, FPathfindingStats& OutStats);
+
+	/**
+	 * The search core. Touches nothing but its arguments, so it runs on any thread against a nav snapshot
+	 * with its own search context. Hierarchical requests between nearby chunks, or that the portal graph
+	 * can't route, run as plain A*. Budgets and partial paths apply to the A* modes only.
+	 * Returns true only for a complete path; a partial path is written to OutPathPoints with false.
+	 */
+	static bool SearchPath(const FVoxelNavQuery& Nav, FPathSearchContext& Search, const FPathSearchParams& Params, TArray<FVector>& OutPathPoints, FPathfindingStats& OutStats);
+
+	// Scans a column from MaxZ down to MinZ for the first coordinate an agent can stand on
+	bool FindWalkableInColumn(int32 X, int32 Y, int32 MaxZ, int32 MinZ, FIntVector& OutCoord) const;
 	
 	void SetVoxelWorld(AVoxelWorld* InWorld);
 	bool HasVoxelWorld() const { return VoxelWorld != nullptr; }
+	AVoxelWorld* GetVoxelWorld() const { return VoxelWorld; }
+
+	// Octile distance on the horizontal plane; every move covers one horizontal step, so it never overestimates
+	static float Heuristic(const FIntVector& From, const FIntVector& To);
 	
 private:
 	UPROPERTY()
 	AVoxelWorld* VoxelWorld;
+
+	FPathSearchContext SearchContext;
 	
-	TArray<FNeighborResult> GetNeighbors(TSharedPtr<FPathfindingNode> Node);
-	TSharedPtr<FPathfindingNode> CreateNode(const FIntVector& Coord);
-
-	bool IsWalkable(const FIntVector& Coord) const;
-	bool IsSolid(const FIntVector& Coord) const;
-	bool IsAir(const FIntVector& Coord) const;
-	bool IsDiagonalAllowed(const FIntVector& Coord, const FIntVector& Offset, int MaxFallDistance) const;
-	void TryStepUp(TArray<FNeighborResult>& OutNeighbors, const FIntVector& Coord, float MoveCost, float StepCost, int MaxStep);
-	void TryFallDown(TArray<FNeighborResult>& OutNeighbors,const FIntVector& NodeCoord,const FIntVector& Offset,float MoveCost,float FallCost,int MaxFall);
+	static void GetNeighbors(const FVoxelNavQuery& Nav, const FIntVector& Coord, TArray<FNeighborResult>& OutNeighbors);
+	static bool SearchBidirectional(const FVoxelNavQuery& Nav, FPathSearchContext& Search, const FPathSearchParams& Params, TArray<FVector>& OutPathPoints, FPathfindingStats& OutStats);
 };
@@ -6,11 +6,12 @@
 
 struct FPathfindingNode
 {
-	TWeakPtr<FPathfindingNode> Parent;
-	
 	FIntVector Coord;
+	int32 Parent = INDEX_NONE;    // Index of the parent in the search's node pool
+	int32 HeapIndex = INDEX_NONE; // Position in the open set, INDEX_NONE when not queued
 	float GCost = 0.0f; // Cost of this path so far
 	float HCost = 0.0f; // Guess at remaining cost / heuristic
+	bool bClosed = false;
 	float FCost() const { return GCost + HCost; }
 
 	FPathfindingNode(FIntVector InCoord)
@@ -22,3 +23,16 @@ struct FPathfindingNode
 		return FVector(Coord) * 100.f; // Assuming 100 units = 1 block
 	}
 };
+
+namespace PathfindingCoord
+{
+	// 21 bits per axis, biased so negative coordinates pack too (+-1M voxels)
+	FORCEINLINE uint64 Pack(const FIntVector& Coord)
+	{
+		constexpr int32 Bias = 1 << 20;
+		constexpr uint64 Mask = (1ull << 21) - 1;
+		return (static_cast<uint64>(Coord.X + Bias) & Mask) |
+			((static_cast<uint64>(Coord.Y + Bias) & Mask) << 21) |
+			((static_cast<uint64>(Coord.Z + Bias) & Mask) << 42);
+	}
+}
@@ -0,0 +1,180 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#pragma once
+
+#include <atomic>
+
+#include "CoreMinimal.h"
+#include "NeighborResult.h"
+#include "PathfindingNode.h"
+#include "VoxelNavGrid.h"
+
+enum class EPathSearchMode : uint8
+{
+	AStar,         // Exact search over voxels
+	Hierarchical,  // Plans over chunk portals first, then refines per chunk. Near optimal, far cheaper across the world.
+	JumpPoint,     // Exact; skips the symmetric paths of open flat ground
+};
+
+struct FPathSearchParams
+{
+	FIntVector Start = FIntVector::ZeroValue;
+	FIntVector End = FIntVector::ZeroValue;
+	EPathSearchMode Mode = EPathSearchMode::AStar;
+	const std::atomic<bool>* CancelFlag = nullptr;  // Polled during the search; set it to abandon the query
+
+	// Effort budget for A* searches, zero for none. A search that runs out stops with bBudgetExhausted set.
+	int32 MaxExpansions = 0;
+	int32 MaxMicroseconds = 0;
+
+	// When the goal isn't reached, return the path to the expanded node nearest the goal and set bPartial
+	bool bAllowPartial = false;
+
+	// A* only: grow frontiers from both ends and join them. Fails faster when the goal is walled in.
+	bool bBidirectional = false;
+
+	EUnloadedChunkPolicy UnloadedChunks = EUnloadedChunkPolicy::Blocked;
+
+	bool HasBudget() const { return MaxExpansions > 0 || MaxMicroseconds > 0; }
+};
+
+/**
+ * Indexed binary min-heap over node pool indices, ordered by FCost.
+ * Each node stores its heap position, so decrease-key and membership checks are O(log n) and O(1).
+ */
+class FPathfindingOpenSet
+{
+public:
+	explicit FPathfindingOpenSet(TArray<FPathfindingNode>& InNodes)
+		: Nodes(InNodes)
+	{
+	}
+
+	bool IsEmpty() const { return Heap.Num() == 0; }
+	int32 Num() const { return Heap.Num(); }
+	bool Contains(const int32 NodeIndex) const { return Nodes[NodeIndex].HeapIndex != INDEX_NONE; }
+	int32 Top() const { return Heap[0]; }
+
+	void Reset()
+	{
+		for (const int32 NodeIndex : Heap)
+		{
+			Nodes[NodeIndex].HeapIndex = INDEX_NONE;
+		}
+		Heap.Reset();
+	}
+
+	void Push(const int32 NodeIndex)
+	{
+		Heap.Add(NodeIndex);
+		Nodes[NodeIndex].HeapIndex = Heap.Num() - 1;
+		SiftUp(Heap.Num() - 1);
+	}
+
+	int32 Pop()
+	{
+		const int32 Top = Heap[0];
+		const int32 Last = Heap.Pop(EAllowShrinking::No);
+		Nodes[Top].HeapIndex = INDEX_NONE;
+
+		if (Heap.Num() > 0)
+		{
+			Place(0, Last);
+			SiftDown(0);
+		}
+		return Top;
+	}
+
+	// Call after lowering a queued node's cost
+	void DecreaseKey(const int32 NodeIndex)
+	{
+		SiftUp(Nodes[NodeIndex].HeapIndex);
+	}
+
+private:
+	TArray<FPathfindingNode>& Nodes;
+	TArray<int32> Heap;
+
+	bool Less(const int32 A, const int32 B) const
+	{
+		const FPathfindingNode& NodeA = Nodes[A];
+		const FPathfindingNode& NodeB = Nodes[B];
+		const float FA = NodeA.FCost();
+		const float FB = NodeB.FCost();
+
+		// Break ties towards the goal so straight runs don't fan out
+		return FA < FB || (FA == FB && NodeA.HCost < NodeB.HCost);
+	}
+
+	void Place(const int32 Position, const int32 NodeIndex)
+	{
+		Heap[Position] = NodeIndex;
+		Nodes[NodeIndex].HeapIndex = Position;
+	}
+
+	void SiftUp(int32 Position)
+	{
+		const int32 NodeIndex = Heap[Position];
+		while (Position > 0)
+		{
+			const int32 ParentPosition = (Position - 1) / 2;
+			if (!Less(NodeIndex, Heap[ParentPosition])) break;
+
+			Place(Position, Heap[ParentPosition]);
+			Position = ParentPosition;
+		}
+		Place(Position, NodeIndex);
+	}
+
+	void SiftDown(int32 Position)
+	{
+		const int32 NodeIndex = Heap[Position];
+		const int32 Count = Heap.Num();
+		while (true)
+		{
+			int32 Child = Position * 2 + 1;
+			if (Child >= Count) break;
+			if (Child + 1 < Count && Less(Heap[Child + 1], Heap[Child])) ++Child;
+			if (!Less(Heap[Child], NodeIndex)) break;
+
+			Place(Position, Heap[Child]);
+			Position = Child;
+		}
+		Place(Position, NodeIndex);
+	}
+};
+
+/**
+ * Scratch state for one A* search. Nodes live in a flat pool addressed by index; the lookup maps packed
+ * coordinates to pool slots. Reset keeps every allocation, so repeated searches don't touch the allocator.
+ */
+struct FPathSearchContext
+{
+	TArray<FPathfindingNode> Nodes;
+	TMap<uint64, int32> NodeLookup;
+	FPathfindingOpenSet OpenSet{ Nodes };
+	TArray<FNeighborResult> Neighbors;
+
+	void Reset()
+	{
+		OpenSet.Reset();
+		Nodes.Reset();
+		NodeLookup.Reset();
+		Neighbors.Reset();
+	}
+
+	int32 FindOrAddNode(const FIntVector& Coord, bool& bOutAdded)
+	{
+		const uint64 Key = PathfindingCoord::Pack(Coord);
+		if (const int32* Existing = NodeLookup.Find(Key))
+		{
+			bOutAdded = false;
+			return *Existing;
+		}
+
+		bOutAdded = true;
+		const int32 Index = Nodes.Emplace(Coord);
+		NodeLookup.Add(Key, Index);
+		return Index;
+	}
+};
@@ -4,7 +4,21 @@
 #include "PathfindingSubsystem.h"
 
 #include "EngineUtils.h"
+#include "PathfindingCosts.h"
 #include "PathfindingManager.h"
+#include "VoxelFlowField.h"
+#include "VoxelNavGrid.h"
+#include "Async/Async.h"
+#include "Tasks/Task.h"
+
+namespace
+{
+    // The search has run and its result is waiting to be consumed
+    bool IsFinished(const EPathRequestStatus Status)
+    {
+        return Status == EPathRequestStatus::Succeeded || Status == EPathRequestStatus::Partial || Status == EPathRequestStatus::Failed;
+    }
+}
 
 void UPathfindingSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
@@ -14,6 +28,32 @@ void UPathfindingSubsystem::Initialize(FSubsystemCollectionBase& Collection)
     PathfindingManager = NewObject<UPathfindingManager>(this);
 }
 
+void UPathfindingSubsystem::Deinitialize()
+{
+    // Running searches notice the flag and finish early; their results land in a queue nobody reads
+    for (TPair<uint32, FPathRequest>& Pair : Requests)
+    {
+        Pair.Value.CancelFlag->store(true);
+    }
+    Requests.Reset();
+    QueuedIds.Reset();
+    FlowFields.Reset();
+
+    // Update tasks hold their own state and queue, so they can outlive this object; removed paths skip their work
+    for (TPair<uint32, FActivePath>& Pair : ActivePaths)
+    {
+        Pair.Value.State->bRemoved.store(true);
+    }
+    ActivePaths.Reset();
+
+    if (AVoxelWorld* World = EditSource.Get())
+    {
+        World->OnVoxelsEdited.Remove(EditHandle);
+    }
+
+    Super::Deinitialize();
+}
+
 UPathfindingManager* UPathfindingSubsystem::GetPathfindingManager()
 {
     if (PathfindingManager && !PathfindingManager->HasVoxelWorld())
@@ -27,3 +67,522 @@ UPathfindingManager* UPathfindingSubsystem::GetPathfindingManager()
     return PathfindingManager;
 }
 
+FPathRequestHandle UPathfindingSubsystem::RequestPath(const FIntVector& Start, const FIntVector& End, const EPathRequestPriority Priority, FOnPathRequestComplete OnComplete)
+{
+    FPathSearchParams Params;
+    Params.Start = Start;
+    Params.End = End;
+    return RequestPath(Params, Priority, MoveTemp(OnComplete));
+}
+
+FPathRequestHandle UPathfindingSubsystem::RequestPath(const FPathSearchParams& Params, const EPathRequestPriority Priority, FOnPathRequestComplete OnComplete)
+{
+    const uint32 Id = NextRequestId++;
+    if (NextRequestId == 0) NextRequestId = 1;
+
+    FPathRequest& Request = Requests.Add(Id);
+    Request.Params = Params;
+    Request.Params.CancelFlag = nullptr;  // Each request polls its own flag
+    Request.Priority = Priority;
+    Request.OnComplete = MoveTemp(OnComplete);
+    Request.RequestTime = FPlatformTime::Seconds();
+
+    QueuedIds.Add(Id);
+    DispatchQueued();
+
+    return FPathRequestHandle{ Id };
+}
+
+bool UPathfindingSubsystem::CancelPath(const FPathRequestHandle Handle)
+{
+    FPathRequest* Request = Requests.Find(Handle.Id);
+    if (!Request || Request->Status == EPathRequestStatus::Cancelled) return false;
+
+    switch (Request->Status)
+    {
+    case EPathRequestStatus::Queued:
+        QueuedIds.Remove(Handle.Id);
+        Requests.Remove(Handle.Id);
+        break;
+
+    case EPathRequestStatus::Running:
+        // Dropped when the search reports back
+        Request->CancelFlag->store(true);
+        Request->Status = EPathRequestStatus::Cancelled;
+        break;
+
+    default:
+        Requests.Remove(Handle.Id);
+        break;
+    }
+
+    CancelledCount++;
+    return true;
+}
+
+EPathRequestStatus UPathfindingSubsystem::GetPathStatus(const FPathRequestHandle Handle) const
+{
+    const FPathRequest* Request = Requests.Find(Handle.Id);
+    return Request ? Request->Status : EPathRequestStatus::Invalid;
+}
+
+bool UPathfindingSubsystem::ConsumePathResult(const FPathRequestHandle Handle, FPathResult& OutResult)
+{
+    FPathRequest* Request = Requests.Find(Handle.Id);
+    if (!Request || !IsFinished(Request->Status))
+    {
+        return false;
+    }
+
+    OutResult = MoveTemp(Request->Result);
+    Requests.Remove(Handle.Id);
+    return true;
+}
+
+void UPathfindingSubsystem::Tick(float DeltaTime)
+{
+    UpdateEditSubscription();
+    DeliverCompleted();
+    DispatchQueued();
+    BuildDirtyFlowFields();
+    DeliverActivePathUpdates();
+}
+
+TStatId UPathfindingSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UPathfindingSubsystem, STATGROUP_Tickables);
+}
+
+void UPathfindingSubsystem::DispatchQueued()
+{
+    if (QueuedIds.Num() == 0 || RunningCount >= MaxConcurrentSearches) return;
+
+    UPathfindingManager* Manager = GetPathfindingManager();
+    AVoxelWorld* VoxelWorld = Manager ? Manager->GetVoxelWorld() : nullptr;
+    const TSharedPtr<FVoxelNavGrid> NavGrid = VoxelWorld ? VoxelWorld->GetNavGrid() : nullptr;
+    if (!NavGrid) return;  // World not generated yet; requests wait in the queue
+
+    // Highest priority first, oldest first within a priority
+    QueuedIds.StableSort([this](const uint32 A, const uint32 B)
+    {
+        return Requests[A].Priority > Requests[B].Priority;
+    });
+
+    const TSharedRef<const FVoxelNavSnapshot> Snapshot = NavGrid->GetSnapshot();
+
+    int32 Launched = 0;
+    while (Launched < QueuedIds.Num() && RunningCount < MaxConcurrentSearches)
+    {
+        const uint32 Id = QueuedIds[Launched++];
+        FPathRequest& Request = Requests[Id];
+        Request.Status = EPathRequestStatus::Running;
+        RunningCount++;
+
+        const UE::Tasks::ETaskPriority TaskPriority =
+            Request.Priority == EPathRequestPriority::High ? UE::Tasks::ETaskPriority::High :
+            Request.Priority == EPathRequestPriority::Low ? UE::Tasks::ETaskPriority::BackgroundNormal :
+            UE::Tasks::ETaskPriority::Normal;
+
+        UE::Tasks::Launch(TEXT("PathSearch"),
+            [Id, Params = Request.Params, CancelFlag = Request.CancelFlag, Snapshot, Completions = Completions]()
+            {
+                // One pool per worker thread; it keeps its allocations between searches
+                static thread_local FPathSearchContext SearchContext;
+
+                FCompletedSearch Completed;
+                Completed.Id = Id;
+                Completed.StartTime = FPlatformTime::Seconds();
+
+                FPathSearchParams SearchParams = Params;
+                SearchParams.CancelFlag = &CancelFlag.Get();
+
+                Completed.bFound = UPathfindingManager::SearchPath(
+                    Snapshot->MakeQuery(), SearchContext, SearchParams, Completed.PathPoints, Completed.Stats);
+
+                Completions->Results.Enqueue(MoveTemp(Completed));
+            },
+            TaskPriority);
+    }
+
+    QueuedIds.RemoveAt(0, Launched, EAllowShrinking::No);
+}
+
+void UPathfindingSubsystem::DeliverCompleted()
+{
+    // Cap the work done per frame; anything left over is delivered next tick
+    int32 Delivered = 0;
+    FCompletedSearch Completed;
+    while (Delivered < MaxResultsPerFrame && Completions->Results.Dequeue(Completed))
+    {
+        RunningCount--;
+
+        FPathRequest* Request = Requests.Find(Completed.Id);
+        if (!Request) continue;
+
+        if (Request->Status == EPathRequestStatus::Cancelled)
+        {
+            Requests.Remove(Completed.Id);
+            continue;
+        }
+
+        const double Now = FPlatformTime::Seconds();
+        FPathResult& Result = Request->Result;
+        Result.Status = Completed.bFound ? EPathRequestStatus::Succeeded
+            : Completed.Stats.bPartial ? EPathRequestStatus::Partial : EPathRequestStatus::Failed;
+        Result.PathPoints = MoveTemp(Completed.PathPoints);
+        Result.Stats = Completed.Stats;
+        Result.QueueSeconds = Completed.StartTime - Request->RequestTime;
+        Result.TotalSeconds = Now - Request->RequestTime;
+
+        RecordLatency(Result.QueueSeconds, Result.TotalSeconds);
+        CompletedCount++;
+        Delivered++;
+
+        if (Request->OnComplete.IsBound())
+        {
+            // The callback may issue new requests, so detach everything from the map first
+            const FOnPathRequestComplete OnComplete = MoveTemp(Request->OnComplete);
+            const FPathResult DeliveredResult = MoveTemp(Result);
+            Requests.Remove(Completed.Id);
+            OnComplete.Execute(FPathRequestHandle{ Completed.Id }, DeliveredResult);
+        }
+        else
+        {
+            Request->Status = Result.Status;
+        }
+    }
+}
+
+void UPathfindingSubsystem::RecordLatency(const double QueueSeconds, const double TotalSeconds)
+{
+    if (QueueLatencyMs.Num() < LatencyHistorySize)
+    {
+        QueueLatencyMs.Add(QueueSeconds * 1000.0);
+        TotalLatencyMs.Add(TotalSeconds * 1000.0);
+        return;
+    }
+
+    QueueLatencyMs[LatencyCursor] = QueueSeconds * 1000.0;
+    TotalLatencyMs[LatencyCursor] = TotalSeconds * 1000.0;
+    LatencyCursor = (LatencyCursor + 1) % LatencyHistorySize;
+}
+
+FPathQueueStats UPathfindingSubsystem::GetQueueStats() const
+{
+    FPathQueueStats Stats;
+    Stats.Queued = QueuedIds.Num();
+    Stats.Running = RunningCount;
+    Stats.Completed = CompletedCount;
+    Stats.Cancelled = CancelledCount;
+
+    for (const TPair<uint32, FPathRequest>& Pair : Requests)
+    {
+        if (IsFinished(Pair.Value.Status))
+        {
+            Stats.AwaitingDelivery++;
+        }
+    }
+
+    auto Summarize = [](TArray<float> Samples, double& OutAvg, double& OutP95, double& OutMax)
+    {
+        if (Samples.Num() == 0) return;
+
+        Samples.Sort();
+        double Sum = 0.0;
+        for (const float Sample : Samples) Sum += Sample;
+
+        OutAvg = Sum / Samples.Num();
+        OutP95 = Samples[FMath::Min(Samples.Num() - 1, FMath::FloorToInt(Samples.Num() * 0.95f))];
+        OutMax = Samples.Last();
+    };
+
+    Summarize(QueueLatencyMs, Stats.AvgQueueMs, Stats.P95QueueMs, Stats.MaxQueueMs);
+    Summarize(TotalLatencyMs, Stats.AvgTotalMs, Stats.P95TotalMs, Stats.MaxTotalMs);
+    return Stats;
+}
+
+void UPathfindingSubsystem::UpdateEditSubscription()
+{
+    // Only worth looking the world up once something depends on its edits
+    if ((FlowFields.Num() == 0 && ActivePaths.Num() == 0) || !GetWorld()) return;
+
+    const UPathfindingManager* Manager = GetPathfindingManager();
+    AVoxelWorld* World = Manager ? Manager->GetVoxelWorld() : nullptr;
+    if (World == EditSource.Get()) return;
+
+    if (AVoxelWorld* Previous = EditSource.Get())
+    {
+        Previous->OnVoxelsEdited.Remove(EditHandle);
+    }
+
+    EditSource = World;
+    EditHandle = World ? World->OnVoxelsEdited.AddUObject(this, &UPathfindingSubsystem::OnVoxelsEdited) : FDelegateHandle();
+}
+
+void UPathfindingSubsystem::OnVoxelsEdited(const TArray<FIntVector>& Voxels)
+{
+    // Voxels whose links read an edited voxel: one step sideways, MaxStepUp + 1 below, MaxFallDistance + 1 above
+    const FIntVector ReachBelow(1, 1, PathfindingCosts::MaxStepUp + 1);
+    const FIntVector ReachAbove(1, 1, PathfindingCosts::MaxFallDistance + 1);
+
+    // Paths sort the edits against the box they searched when their next update starts
+    for (TPair<uint32, FActivePath>& Pair : ActivePaths)
+    {
+        FActivePath& Path = Pair.Value;
+        if (Path.bLastFailed)
+        {
+            Path.bPlanPending = true;
+        }
+        else
+        {
+            Path.PendingEdits.Append(Voxels);
+        }
+        PumpActivePath(Pair.Key, Path);
+    }
+
+    for (TPair<FIntVector, FFlowFieldEntry>& Pair : FlowFields)
+    {
+        FFlowFieldEntry& Entry = Pair.Value;
+        if (Entry.bDirty || !Entry.Field.IsValid()) continue;
+
+        for (const FIntVector& Voxel : Voxels)
+        {
+            if (Entry.Field->Intersects(Voxel - ReachBelow, Voxel + ReachAbove))
+            {
+                Entry.bDirty = true;
+                break;
+            }
+        }
+    }
+}
+
+TSharedPtr<const FVoxelFlowField> UPathfindingSubsystem::RequestFlowField(const FIntVector& Goal)
+{
+    const double Now = FPlatformTime::Seconds();
+    if (FFlowFieldEntry* Entry = FlowFields.Find(Goal))
+    {
+        Entry->LastRequestTime = Now;
+        return Entry->Field;
+    }
+
+    FlowFields.Add(Goal).LastRequestTime = Now;
+    EvictFlowFields();
+    return nullptr;
+}
+
+bool UPathfindingSubsystem::SampleFlowField(const FIntVector& Goal, const FIntVector& Coord, FIntVector& OutNext)
+{
+    const TSharedPtr<const FVoxelFlowField> Field = RequestFlowField(Goal);
+    return Field.IsValid() && Field->GetNext(Coord, OutNext);
+}
+
+void UPathfindingSubsystem::ReleaseFlowField(const FIntVector& Goal)
+{
+    // A build still in flight finds no entry and is dropped
+    FlowFields.Remove(Goal);
+}
+
+void UPathfindingSubsystem::BuildDirtyFlowFields()
+{
+    if (FlowFields.Num() == 0) return;
+
+    UPathfindingManager* Manager = GetPathfindingManager();
+    AVoxelWorld* VoxelWorld = Manager ? Manager->GetVoxelWorld() : nullptr;
+    const TSharedPtr<FVoxelNavGrid> NavGrid = VoxelWorld ? VoxelWorld->GetNavGrid() : nullptr;
+    if (!NavGrid) return;
+
+    TSharedPtr<const FVoxelNavSnapshot> Snapshot;
+    for (TPair<FIntVector, FFlowFieldEntry>& Pair : FlowFields)
+    {
+        FFlowFieldEntry& Entry = Pair.Value;
+        if (!Entry.bDirty || Entry.bBuilding) continue;
+
+        if (!Snapshot.IsValid())
+        {
+            Snapshot = NavGrid->GetSnapshot();
+        }
+
+        Entry.bDirty = false;
+        Entry.bBuilding = true;
+
+        UE::Tasks::Launch(TEXT("FlowFieldBuild"),
+            [WeakThis = TWeakObjectPtr<UPathfindingSubsystem>(this), Goal = Pair.Key, Extent = FlowFieldExtent, Snapshot]()
+            {
+                TSharedRef<FVoxelFlowField> Field = FVoxelFlowField::Build(Snapshot->MakeQuery(), Goal, Extent);
+
+                AsyncTask(ENamedThreads::GameThread, [WeakThis, Goal, Field]()
+                {
+                    if (UPathfindingSubsystem* Subsystem = WeakThis.Get())
+                    {
+                        Subsystem->OnFlowFieldBuilt(Goal, Field);
+                    }
+                });
+            },
+            UE::Tasks::ETaskPriority::BackgroundNormal);
+    }
+}
+
+void UPathfindingSubsystem::OnFlowFieldBuilt(const FIntVector& Goal, const TSharedRef<FVoxelFlowField>& Field)
+{
+    FFlowFieldEntry* Entry = FlowFields.Find(Goal);
+    if (!Entry) return;
+
+    // Kept even if an edit arrived meanwhile: it is still newer than what agents had, and bDirty queues the next build
+    Entry->Field = Field;
+    Entry->bBuilding = false;
+}
+
+void UPathfindingSubsystem::EvictFlowFields()
+{
+    while (FlowFields.Num() > MaxCachedFlowFields)
+    {
+        FIntVector Oldest;
+        double OldestTime = TNumericLimits<double>::Max();
+        for (const TPair<FIntVector, FFlowFieldEntry>& Pair : FlowFields)
+        {
+            if (Pair.Value.LastRequestTime < OldestTime)
+            {
+                OldestTime = Pair.Value.LastRequestTime;
+                Oldest = Pair.Key;
+            }
+        }
+        FlowFields.Remove(Oldest);
+    }
+}
+
+FActivePathHandle UPathfindingSubsystem::RegisterActivePath(const FIntVector& Start, const FIntVector& Goal, FOnActivePathUpdated OnUpdated)
+{
+    const uint32 Id = NextActivePathId++;
+    if (NextActivePathId == 0) NextActivePathId = 1;
+
+    FActivePath& Path = ActivePaths.Add(Id);
+    Path.OnUpdated = MoveTemp(OnUpdated);
+
+    // Nothing else can see the state until the first task is launched
+    Path.State->Planner.Reset(Start, Goal);
+
+    PumpActivePath(Id, Path);
+    return FActivePathHandle{ Id };
+}
+
+void UPathfindingSubsystem::MoveActivePathStart(const FActivePathHandle Handle, const FIntVector& NewStart)
+{
+    if (FActivePath* Path = ActivePaths.Find(Handle.Id))
+    {
+        Path->PendingStart = NewStart;
+        PumpActivePath(Handle.Id, *Path);
+    }
+}
+
+void UPathfindingSubsystem::UnregisterActivePath(const FActivePathHandle Handle)
+{
+    if (FActivePath* Path = ActivePaths.Find(Handle.Id))
+    {
+        // A running task sees the flag and returns without reporting
+        Path->State->bRemoved.store(true);
+        ActivePaths.Remove(Handle.Id);
+    }
+}
+
+void UPathfindingSubsystem::PumpActivePath(const uint32 Id, FActivePath& Path)
+{
+    if (Path.bUpdateInFlight || (!Path.bPlanPending && !Path.PendingStart.IsSet() && Path.PendingEdits.Num() == 0)) return;
+
+    UPathfindingManager* Manager = GetPathfindingManager();
+    AVoxelWorld* VoxelWorld = Manager ? Manager->GetVoxelWorld() : nullptr;
+    const TSharedPtr<FVoxelNavGrid> NavGrid = VoxelWorld ? VoxelWorld->GetNavGrid() : nullptr;
+    if (!NavGrid) return;  // World not generated yet; the work waits and Tick tries again
+
+    // No task is running, so the box is the one the planner has now. A fresh plan reads every voxel anyway.
+    TArray<FIntVector> Edits;
+    if (!Path.bPlanPending)
+    {
+        for (const FIntVector& Edited : Path.PendingEdits)
+        {
+            if (FVoxelDStarLite::CanAffectSearch(Path.SearchedMin, Path.SearchedMax, Edited))
+            {
+                Edits.Add(Edited);
+            }
+        }
+    }
+    Path.PendingEdits.Reset();
+
+    const bool bPlan = Path.bPlanPending;
+    const TOptional<FIntVector> NewStart = Path.PendingStart;
+    if (!bPlan && !NewStart.IsSet() && Edits.Num() == 0) return;
+
+    Path.bPlanPending = false;
+    Path.PendingStart.Reset();
+    Path.bUpdateInFlight = true;
+
+    UE::Tasks::Launch(TEXT("ActivePathUpdate"),
+        [Id, bPlan, NewStart, Edits = MoveTemp(Edits), State = Path.State, Snapshot = NavGrid->GetSnapshot(), Updates = ActivePathUpdates,
+            MaxExpansions = ActivePathMaxExpansions]()
+        {
+            if (State->bRemoved.load()) return;
+
+            const FVoxelNavQuery Nav = Snapshot->MakeQuery();
+            FVoxelDStarLite& Planner = State->Planner;
+
+            bool bReplan = bPlan;
+            if (NewStart.IsSet() && NewStart.GetValue() != Planner.GetStart())
+            {
+                Planner.SetStart(NewStart.GetValue());
+                bReplan = true;
+            }
+            if (Edits.Num() > 0 && Planner.UpdateVoxels(Nav, Edits))
+            {
+                bReplan = true;
+            }
+
+            FActivePathUpdate Result;
+            Result.Id = Id;
+            if (bReplan)
+            {
+                const bool bFound = Planner.ComputeShortestPath(Nav, Result.Result.Stats, &State->bRemoved, MaxExpansions) &&
+                    Planner.ExtractPath(Nav, Result.Result.PathPoints, Result.Result.Stats.PathCost);
+                if (Result.Result.Stats.bCancelled) return;
+
+                Result.bReplanned = true;
+                Result.Result.Status = bFound ? EPathRequestStatus::Succeeded : EPathRequestStatus::Failed;
+                Result.Result.TotalSeconds = Result.Result.Stats.Seconds;
+            }
+
+            // Reported even when nothing changed, so the path can start its next update
+            Result.SearchedMin = Planner.GetBoundsMin();
+            Result.SearchedMax = Planner.GetBoundsMax();
+            Updates->Updates.Enqueue(MoveTemp(Result));
+        },
+        UE::Tasks::ETaskPriority::BackgroundNormal);
+}
+
+void UPathfindingSubsystem::DeliverActivePathUpdates()
+{
+    // Paths whose work arrived before the nav grid existed
+    for (TPair<uint32, FActivePath>& Pair : ActivePaths)
+    {
+        PumpActivePath(Pair.Key, Pair.Value);
+    }
+
+    FActivePathUpdate Update;
+    while (ActivePathUpdates->Updates.Dequeue(Update))
+    {
+        FActivePath* Path = ActivePaths.Find(Update.Id);
+        if (!Path) continue;
+
+        Path->bUpdateInFlight = false;
+        Path->SearchedMin = Update.SearchedMin;
+        Path->SearchedMax = Update.SearchedMax;
+        if (Update.bReplanned)
+        {
+            Path->bLastFailed = Update.Result.Status == EPathRequestStatus::Failed;
+        }
+        PumpActivePath(Update.Id, *Path);
+
+        if (!Update.bReplanned) continue;
+
+        // Copy: the callback may unregister this path
+        const FOnActivePathUpdated OnUpdated = Path->OnUpdated;
+        OnUpdated.ExecuteIfBound(FActivePathHandle{ Update.Id }, Update.Result);
+    }
+}
@@ -2,23 +2,257 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "CoreMinimal.h"
+#include "Containers/Queue.h"
 #include "Subsystems/GameInstanceSubsystem.h"
+#include "Tickable.h"
 #include "PathfindingManager.h"
+#include "VoxelDStarLite.h"
 #include "PathfindingSubsystem.generated.h"
 
+class FVoxelFlowField;
+
+struct FPathRequestHandle
+{
+    uint32 Id = 0;
+
+    bool IsValid() const { return Id != 0; }
+    bool operator==(const FPathRequestHandle& Other) const { return Id == Other.Id; }
+};
+
+enum class EPathRequestPriority : uint8
+{
+    Low,
+    Normal,
+    High,
+};
+
+enum class EPathRequestStatus : uint8
+{
+    Invalid,    // Unknown handle, or a result that was already delivered
+    Queued,
+    Running,
+    Succeeded,
+    Partial,    // The goal wasn't reached; PathPoints end at the point nearest it (bAllowPartial or unknown chunks)
+    Failed,
+    Cancelled,
+};
+
+struct FPathResult
+{
+    EPathRequestStatus Status = EPathRequestStatus::Invalid;
+    TArray<FVector> PathPoints;
+    FPathfindingStats Stats;
+    double QueueSeconds = 0.0;  // Request to search start
+    double TotalSeconds = 0.0;  // Request to delivery on the game thread
+};
+
+DECLARE_DELEGATE_TwoParams(FOnPathRequestComplete, FPathRequestHandle, const FPathResult&);
+
+struct FActivePathHandle
+{
+    uint32 Id = 0;
+
+    bool IsValid() const { return Id != 0; }
+    bool operator==(const FActivePathHandle& Other) const { return Id == Other.Id; }
+};
+
+DECLARE_DELEGATE_TwoParams(FOnActivePathUpdated, FActivePathHandle, const FPathResult&);
+
+struct FPathQueueStats
+{
+    int32 Queued = 0;
+    int32 Running = 0;
+    int32 AwaitingDelivery = 0;
+    int64 Completed = 0;
+    int64 Cancelled = 0;
+
+    // Over the most recent completed requests
+    double AvgQueueMs = 0.0;
+    double P95QueueMs = 0.0;
+    double MaxQueueMs = 0.0;
+    double AvgTotalMs = 0.0;
+    double P95TotalMs = 0.0;
+    double MaxTotalMs = 0.0;
+};
+
 UCLASS()
-class BLOXELS_API UPathfindingSubsystem : public UGameInstanceSubsystem
+class BLOXELS_API UPathfindingSubsystem : public UGameInstanceSubsystem, public FTickableGameObject
 {
     GENERATED_BODY()
 
 public:
     virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
 
     UFUNCTION(BlueprintCallable, Category = "Pathfinding")
     UPathfindingManager* GetPathfindingManager();
 
+    // Async Requests
+    // Searches run on the task graph against a snapshot of the nav grid taken when the request starts.
+    // Results come back through OnComplete during Tick, or stay until ConsumePathResult when no callback is bound.
+    FPathRequestHandle RequestPath(const FIntVector& Start, const FIntVector& End,
+        EPathRequestPriority Priority = EPathRequestPriority::Normal,
+        FOnPathRequestComplete OnComplete = FOnPathRequestComplete());
+    FPathRequestHandle RequestPath(const FPathSearchParams& Params,
+        EPathRequestPriority Priority = EPathRequestPriority::Normal,
+        FOnPathRequestComplete OnComplete = FOnPathRequestComplete());
+    bool CancelPath(FPathRequestHandle Handle);
+    EPathRequestStatus GetPathStatus(FPathRequestHandle Handle) const;
+    bool ConsumePathResult(FPathRequestHandle Handle, FPathResult& OutResult);
+
+    FPathQueueStats GetQueueStats() const;
+    void SetMaxResultsPerFrame(int32 InMax) { MaxResultsPerFrame = FMath::Max(1, InMax); }
+    void SetMaxConcurrentSearches(int32 InMax) { MaxConcurrentSearches = FMath::Max(1, InMax); }
+
+    // Flow Fields
+    // Agents heading for the same goal share one field instead of searching separately. A field covers a box of
+    // FlowFieldExtent around its goal, is built on the task graph and stays cached. A committed edit inside the box
+    // marks only that field for a rebuild; the previous field keeps answering until the new one lands.
+    // Returns null until the first build for the goal has finished.
+    TSharedPtr<const FVoxelFlowField> RequestFlowField(const FIntVector& Goal);
+    // Next voxel towards Goal from Coord. Requests the field if needed; false while it builds or where the goal can't be reached.
+    bool SampleFlowField(const FIntVector& Goal, const FIntVector& Coord, FIntVector& OutNext);
+    void ReleaseFlowField(const FIntVector& Goal);
+    void SetFlowFieldExtent(const FIntVector& InExtent) { FlowFieldExtent = InExtent; }
+    void SetMaxCachedFlowFields(int32 InMax) { MaxCachedFlowFields = FMath::Max(1, InMax); }
+    int32 GetNumFlowFields() const { return FlowFields.Num(); }
+
+    // Active Paths
+    // Routes that follow the world as it changes. Each keeps a D* Lite search; committed edits near it are repaired
+    // incrementally from the previous search instead of replanning, and OnUpdated fires during Tick with the new route.
+    // The first result arrives the same way. A search that expands more than the budget fails, and so does one that
+    // can't reach the goal; either replans from scratch on the next edit.
+    FActivePathHandle RegisterActivePath(const FIntVector& Start, const FIntVector& Goal, FOnActivePathUpdated OnUpdated);
+    // The agent moved along its route; replans from the new position, reusing the search
+    void MoveActivePathStart(FActivePathHandle Handle, const FIntVector& NewStart);
+    void UnregisterActivePath(FActivePathHandle Handle);
+    int32 GetNumActivePaths() const { return ActivePaths.Num(); }
+    void SetActivePathMaxExpansions(int32 InMax) { ActivePathMaxExpansions = FMath::Max(0, InMax); }
+
+    // FTickableGameObject
+    virtual void Tick(float DeltaTime) override;
+    virtual TStatId GetStatId() const override;
+    virtual bool IsTickable() const override { return !IsTemplate(); }
+
 private:
     UPROPERTY()
     UPathfindingManager* PathfindingManager;
+
+    struct FPathRequest
+    {
+        FPathSearchParams Params;
+        EPathRequestPriority Priority = EPathRequestPriority::Normal;
+        EPathRequestStatus Status = EPathRequestStatus::Queued;
+        FOnPathRequestComplete OnComplete;
+        TSharedRef<std::atomic<bool>> CancelFlag = MakeShared<std::atomic<bool>>(false);
+        double RequestTime = 0.0;
+        FPathResult Result;
+    };
+
+    struct FCompletedSearch
+    {
+        uint32 Id = 0;
+        bool bFound = false;
+        double StartTime = 0.0;
+        TArray<FVector> PathPoints;
+        FPathfindingStats Stats;
+    };
+
+    // Shared with running tasks so they can finish safely after the subsystem is gone
+    struct FCompletionQueue
+    {
+        TQueue<FCompletedSearch, EQueueMode::Mpsc> Results;
+    };
+
+    TMap<uint32, FPathRequest> Requests;
+    TArray<uint32> QueuedIds;
+    TSharedRef<FCompletionQueue> Completions = MakeShared<FCompletionQueue>();
+    uint32 NextRequestId = 1;
+    int32 RunningCount = 0;
+    int32 MaxResultsPerFrame = 8;
+    int32 MaxConcurrentSearches = 4;
+
+    // Latency history
+    static constexpr int32 LatencyHistorySize = 256;
+    TArray<float> QueueLatencyMs;
+    TArray<float> TotalLatencyMs;
+    int32 LatencyCursor = 0;
+    int64 CompletedCount = 0;
+    int64 CancelledCount = 0;
+
+    // Flow fields
+    struct FFlowFieldEntry
+    {
+        TSharedPtr<const FVoxelFlowField> Field;
+        double LastRequestTime = 0.0;
+        bool bBuilding = false;
+        bool bDirty = true;  // Missing or out of date; rebuilt on the next tick
+    };
+
+    TMap<FIntVector, FFlowFieldEntry> FlowFields;
+    FIntVector FlowFieldExtent = FIntVector(64, 64, 32);
+    int32 MaxCachedFlowFields = 16;
+
+    // Active paths. Each path runs at most one update task at a time, so its planner is only touched by that task.
+    // Work arriving meanwhile waits on the game thread and goes out merged into the next update.
+    struct FActivePathState
+    {
+        FVoxelDStarLite Planner;
+        std::atomic<bool> bRemoved{ false };
+    };
+
+    struct FActivePath
+    {
+        TSharedRef<FActivePathState> State = MakeShared<FActivePathState>();
+        FOnActivePathUpdated OnUpdated;
+        bool bUpdateInFlight = false;
+        bool bPlanPending = true;  // First search, or a fresh one after the last search failed
+        bool bLastFailed = false;
+        TOptional<FIntVector> PendingStart;
+        TArray<FIntVector> PendingEdits;
+
+        // Box the planner had searched when its last update finished; edits that can't reach it need no repair
+        FIntVector SearchedMin = FIntVector(MAX_int32);
+        FIntVector SearchedMax = FIntVector(MIN_int32);
+    };
+
+    struct FActivePathUpdate
+    {
+        uint32 Id = 0;
+        bool bReplanned = false;  // Result holds a new route; otherwise nothing the route depends on changed
+        FPathResult Result;
+        FIntVector SearchedMin;
+        FIntVector SearchedMax;
+    };
+
+    struct FActivePathQueue
+    {
+        TQueue<FActivePathUpdate, EQueueMode::Mpsc> Updates;
+    };
+
+    TMap<uint32, FActivePath> ActivePaths;
+    TSharedRef<FActivePathQueue> ActivePathUpdates = MakeShared<FActivePathQueue>();
+    uint32 NextActivePathId = 1;
+    int32 ActivePathMaxExpansions = 200000;  // Zero for none
+
+    // World whose edit events invalidate cached navigation results
+    TWeakObjectPtr<AVoxelWorld> EditSource;
+    FDelegateHandle EditHandle;
+
+    void DispatchQueued();
+    void DeliverCompleted();
+    void RecordLatency(double QueueSeconds, double TotalSeconds);
+
+    void UpdateEditSubscription();
+    void OnVoxelsEdited(const TArray<FIntVector>& Voxels);
+    void BuildDirtyFlowFields();
+    void OnFlowFieldBuilt(const FIntVector& Goal, const TSharedRef<FVoxelFlowField>& Field);
+    void EvictFlowFields();
+
+    // Starts the path's pending work unless an update is already running for it
+    void PumpActivePath(uint32 Id, FActivePath& Path);
+    void DeliverActivePathUpdates();
 };
@@ -0,0 +1,285 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#include "VoxelDStarLite.h"
+
+#include "PathfindingCosts.h"
+#include "PathfindingManager.h"
+#include "PathfindingNode.h"
+#include "VoxelNavGrid.h"
+
+namespace
+{
+	constexpr float Infinity = TNumericLimits<float>::Max();
+
+	// Voxels whose links read an edited voxel: one step sideways, MaxStepUp + 1 below, MaxFallDistance + 1 above
+	const FIntVector ReachBelow(1, 1, PathfindingCosts::MaxStepUp + 1);
+	const FIntVector ReachAbove(1, 1, PathfindingCosts::MaxFallDistance + 1);
+}
+
+void FVoxelDStarLite::Reset(const FIntVector& InStart, const FIntVector& InGoal)
+{
+	Start = InStart;
+	Goal = InGoal;
+	LastStart = InStart;
+	KeyModifier = 0.f;
+
+	Nodes.Empty();
+	Queue.Empty();
+
+	BoundsMin = InGoal;
+	BoundsMax = InGoal;
+
+	FNode& GoalNode = Nodes.Add(Goal);
+	GoalNode.Rhs = 0.f;
+	Enqueue(Goal, GoalNode);
+}
+
+void FVoxelDStarLite::SetStart(const FIntVector& NewStart)
+{
+	KeyModifier += UPathfindingManager::Heuristic(LastStart, NewStart);
+	LastStart = NewStart;
+	Start = NewStart;
+}
+
+float FVoxelDStarLite::GetG(const FIntVector& Coord) const
+{
+	const FNode* Node = Nodes.Find(Coord);
+	return Node ? Node->G : Infinity;
+}
+
+FVoxelDStarLite::FKey FVoxelDStarLite::CalculateKey(const FIntVector& Coord, const FNode& Node) const
+{
+	const float Cost = FMath::Min(Node.G, Node.Rhs);
+	if (Cost >= Infinity)
+	{
+		return FKey{ Infinity, Infinity };
+	}
+	return FKey{ Cost + UPathfindingManager::Heuristic(Start, Coord) + KeyModifier, Cost };
+}
+
+void FVoxelDStarLite::Enqueue(const FIntVector& Coord, FNode& Node)
+{
+	Node.Key = CalculateKey(Coord, Node);
+	Node.bQueued = true;
+	Queue.HeapPush(FQueueEntry{ Node.Key, Coord }, [](const FQueueEntry& A, const FQueueEntry& B) { return A.Key < B.Key; });
+}
+
+bool FVoxelDStarLite::PeekTop(FQueueEntry& OutEntry)
+{
+	auto ByKey = [](const FQueueEntry& A, const FQueueEntry& B) { return A.Key < B.Key; };
+	while (Queue.Num() > 0)
+	{
+		const FQueueEntry& Top = Queue.HeapTop();
+		const FNode* Node = Nodes.Find(Top.Coord);
+		if (Node && Node->bQueued && Node->Key == Top.Key)
+		{
+			OutEntry = Top;
+			return true;
+		}
+		Queue.HeapPopDiscard(ByKey, EAllowShrinking::No);
+	}
+	return false;
+}
+
+void FVoxelDStarLite::UpdateVertex(const FVoxelNavQuery& Nav, const FIntVector& Coord)
+{
+	float Rhs = 0.f;
+	if (Coord != Goal)
+	{
+		Rhs = Infinity;
+		Successors.Reset();
+		VoxelNav::AppendNeighbors(Coord, Nav.GetLinks(Coord), Successors);
+		for (const FNeighborResult& Successor : Successors)
+		{
+			const float G = GetG(Successor.Coord);
+			if (G < Infinity)
+			{
+				Rhs = FMath::Min(Rhs, G + Successor.MoveCost);
+			}
+		}
+	}
+
+	FNode* Node = Nodes.Find(Coord);
+	if (!Node)
+	{
+		// Never reached and still can't reach anything: nothing to remember
+		if (Rhs >= Infinity) return;
+
+		Node = &Nodes.Add(Coord);
+		BoundsMin = FIntVector(FMath::Min(BoundsMin.X, Coord.X), FMath::Min(BoundsMin.Y, Coord.Y), FMath::Min(BoundsMin.Z, Coord.Z));
+		BoundsMax = FIntVector(FMath::Max(BoundsMax.X, Coord.X), FMath::Max(BoundsMax.Y, Coord.Y), FMath::Max(BoundsMax.Z, Coord.Z));
+	}
+
+	Node->Rhs = Rhs;
+	Node->bQueued = false;
+	if (Node->G != Node->Rhs)
+	{
+		Enqueue(Coord, *Node);
+	}
+}
+
+bool FVoxelDStarLite::CanAffectSearch(const FIntVector& SearchMin, const FIntVector& SearchMax, const FIntVector& Edited)
+{
+	using namespace PathfindingCosts;
+
+	// A relinked voxel matters only if one move can carry it into the searched box
+	const FIntVector SearchedMin = SearchMin - FIntVector(1, 1, MaxStepUp);
+	const FIntVector SearchedMax = SearchMax + FIntVector(1, 1, MaxFallDistance);
+
+	const FIntVector Min = Edited - ReachBelow;
+	const FIntVector Max = Edited + ReachAbove;
+	return Max.X >= SearchedMin.X && Min.X <= SearchedMax.X &&
+		Max.Y >= SearchedMin.Y && Min.Y <= SearchedMax.Y &&
+		Max.Z >= SearchedMin.Z && Min.Z <= SearchedMax.Z;
+}
+
+bool FVoxelDStarLite::UpdateVoxels(const FVoxelNavQuery& Nav, const TConstArrayView<FIntVector> EditedVoxels)
+{
+	TSet<FIntVector> Relink;
+	for (const FIntVector& Edited : EditedVoxels)
+	{
+		if (!CanAffectSearch(BoundsMin, BoundsMax, Edited))
+		{
+			continue;
+		}
+
+		const FIntVector Min = Edited - ReachBelow;
+		const FIntVector Max = Edited + ReachAbove;
+
+		for (int32 Z = Min.Z; Z <= Max.Z; ++Z)
+		{
+			for (int32 Y = Min.Y; Y <= Max.Y; ++Y)
+			{
+				for (int32 X = Min.X; X <= Max.X; ++X)
+				{
+					Relink.Add(FIntVector(X, Y, Z));
+				}
+			}
+		}
+	}
+
+	bool bChanged = false;
+	for (const FIntVector& Coord : Relink)
+	{
+		UpdateVertex(Nav, Coord);
+
+		const FNode* Node = Nodes.Find(Coord);
+		bChanged |= Node && Node->bQueued;
+	}
+	return bChanged;
+}
+
+bool FVoxelDStarLite::ComputeShortestPath(const FVoxelNavQuery& Nav, FPathfindingStats& OutStats, const std::atomic<bool>* CancelFlag,
+	const int32 MaxExpansions)
+{
+	OutStats = FPathfindingStats();
+	const double StartTime = FPlatformTime::Seconds();
+
+	FQueueEntry Top;
+	while (PeekTop(Top))
+	{
+		const FNode* StartNode = Nodes.Find(Start);
+		const FNode StartState = StartNode ? *StartNode : FNode();
+		if (!(Top.Key < CalculateKey(Start, StartState)) && StartState.Rhs == StartState.G)
+		{
+			break;
+		}
+
+		if (CancelFlag && (OutStats.NodesExpanded & 255) == 0 && CancelFlag->load(std::memory_order_relaxed))
+		{
+			OutStats.bCancelled = true;
+			break;
+		}
+
+		if (MaxExpansions > 0 && OutStats.NodesExpanded >= MaxExpansions)
+		{
+			OutStats.bBudgetExhausted = true;
+			break;
+		}
+
+		Queue.HeapPopDiscard([](const FQueueEntry& A, const FQueueEntry& B) { return A.Key < B.Key; }, EAllowShrinking::No);
+		FNode& Node = Nodes.FindChecked(Top.Coord);
+		Node.bQueued = false;
+		OutStats.NodesExpanded++;
+
+		// The start moved since this was queued
+		if (Top.Key < CalculateKey(Top.Coord, Node))
+		{
+			Enqueue(Top.Coord, Node);
+			continue;
+		}
+
+		// Node is not used past here: UpdateVertex can add nodes and move the map's storage
+		Predecessors.Reset();
+		VoxelNav::AppendPredecessors(Nav, Top.Coord, Predecessors);
+		if (Node.G > Node.Rhs)
+		{
+			Node.G = Node.Rhs;
+		}
+		else
+		{
+			Node.G = Infinity;
+			UpdateVertex(Nav, Top.Coord);
+		}
+
+		for (const FNeighborResult& Predecessor : Predecessors)
+		{
+			UpdateVertex(Nav, Predecessor.Coord);
+		}
+	}
+
+	OutStats.NodesGenerated = Nodes.Num();
+	OutStats.PathCost = GetG(Start);
+	OutStats.Seconds = FPlatformTime::Seconds() - StartTime;
+	if (OutStats.bCancelled) return false;
+
+	// An unreachable goal or a search cut short keeps nothing worth repairing, only a node store that would keep growing
+	if (OutStats.bBudgetExhausted || GetG(Start) >= Infinity)
+	{
+		OutStats.PathCost = 0.f;
+		Reset(Start, Goal);
+		return false;
+	}
+	return true;
+}
+
+bool FVoxelDStarLite::ExtractPath(const FVoxelNavQuery& Nav, TArray<FVector>& OutPathPoints, float& OutCost)
+{
+	OutPathPoints.Reset();
+	OutCost = 0.f;
+	if (GetG(Start) >= Infinity) return false;
+
+	FIntVector Current = Start;
+	OutPathPoints.Add(FPathfindingNode(Current).WorldPosition());
+
+	// Each step lowers g, so the walk can't loop; the cap only guards against a search that was cut short
+	for (int32 Step = 0; Step < Nodes.Num() && Current != Goal; ++Step)
+	{
+		Successors.Reset();
+		VoxelNav::AppendNeighbors(Current, Nav.GetLinks(Current), Successors);
+
+		float BestTotal = Infinity;
+		const FNeighborResult* Best = nullptr;
+		for (const FNeighborResult& Successor : Successors)
+		{
+			const float G = GetG(Successor.Coord);
+			if (G < Infinity && G + Successor.MoveCost < BestTotal)
+			{
+				BestTotal = G + Successor.MoveCost;
+				Best = &Successor;
+			}
+		}
+
+		if (!Best)
+		{
+			OutPathPoints.Reset();
+			return false;
+		}
+
+		OutCost += Best->MoveCost;
+		Current = Best->Coord;
+		OutPathPoints.Add(FPathfindingNode(Current).WorldPosition());
+	}
+
+	return Current == Goal;
+}
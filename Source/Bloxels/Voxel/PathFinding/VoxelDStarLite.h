@@ -0,0 +1,96 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#pragma once
+
+#include <atomic>
+
+#include "CoreMinimal.h"
+#include "NeighborResult.h"
+
+class FVoxelNavQuery;
+struct FPathfindingStats;
+
+/**
+ * D* Lite over the voxel nav grid. Searches backwards from the goal, so the start can move along the path
+ * and edits only reopen the voxels whose links changed; every other g-value from earlier searches is reused.
+ * Not thread safe; one thread at a time.
+ */
+class BLOXELS_API FVoxelDStarLite
+{
+public:
+	void Reset(const FIntVector& InStart, const FIntVector& InGoal);
+
+	// The agent moved; keys already queued stay valid through the key modifier
+	void SetStart(const FIntVector& NewStart);
+
+	// Call after committed edits, against a query that already reflects them. Returns true if any voxel the
+	// search depends on became inconsistent.
+	bool UpdateVoxels(const FVoxelNavQuery& Nav, TConstArrayView<FIntVector> EditedVoxels);
+
+	// Returns true if the start can reach the goal. MaxExpansions caps the work, zero for none; a search that runs
+	// out stops with bBudgetExhausted set and fails. A failed search drops its nodes and starts over from the goal.
+	bool ComputeShortestPath(const FVoxelNavQuery& Nav, FPathfindingStats& OutStats, const std::atomic<bool>* CancelFlag = nullptr,
+		int32 MaxExpansions = 0);
+
+	bool ExtractPath(const FVoxelNavQuery& Nav, TArray<FVector>& OutPathPoints, float& OutCost);
+
+	const FIntVector& GetStart() const { return Start; }
+	const FIntVector& GetGoal() const { return Goal; }
+	int32 NumNodes() const { return Nodes.Num(); }
+
+	// Box around every voxel the search has touched
+	const FIntVector& GetBoundsMin() const { return BoundsMin; }
+	const FIntVector& GetBoundsMax() const { return BoundsMax; }
+
+	// True when Edited can change the links of a voxel one move from the box SearchMin..SearchMax. UpdateVoxels skips
+	// every other edit, so callers holding a copy of the bounds can skip them too.
+	static bool CanAffectSearch(const FIntVector& SearchMin, const FIntVector& SearchMax, const FIntVector& Edited);
+
+private:
+	struct FKey
+	{
+		float Primary = 0.f;
+		float Secondary = 0.f;
+
+		bool operator<(const FKey& Other) const
+		{
+			return Primary < Other.Primary || (Primary == Other.Primary && Secondary < Other.Secondary);
+		}
+		bool operator==(const FKey& Other) const { return Primary == Other.Primary && Secondary == Other.Secondary; }
+	};
+
+	struct FNode
+	{
+		float G = TNumericLimits<float>::Max();
+		float Rhs = TNumericLimits<float>::Max();
+		FKey Key;
+		bool bQueued = false;
+	};
+
+	// Heap entries are dropped lazily: one is live only while its node is queued with the same key
+	struct FQueueEntry
+	{
+		FKey Key;
+		FIntVector Coord;
+	};
+
+	FIntVector Start = FIntVector::ZeroValue;
+	FIntVector Goal = FIntVector::ZeroValue;
+	FIntVector LastStart = FIntVector::ZeroValue;
+	float KeyModifier = 0.f;
+
+	TMap<FIntVector, FNode> Nodes;
+	TArray<FQueueEntry> Queue;
+	TArray<FNeighborResult> Successors;
+	TArray<FNeighborResult> Predecessors;
+
+	// Box around every voxel the search has touched
+	FIntVector BoundsMin = FIntVector(MAX_int32);
+	FIntVector BoundsMax = FIntVector(MIN_int32);
+
+	float GetG(const FIntVector& Coord) const;
+	FKey CalculateKey(const FIntVector& Coord, const FNode& Node) const;
+	void UpdateVertex(const FVoxelNavQuery& Nav, const FIntVector& Coord);
+	void Enqueue(const FIntVector& Coord, FNode& Node);
+	bool PeekTop(FQueueEntry& OutEntry);
+};
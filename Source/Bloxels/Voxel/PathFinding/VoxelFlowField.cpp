@@ -0,0 +1,97 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#include "VoxelFlowField.h"
+
+#include "NeighborResult.h"
+#include "PathfindingNode.h"
+#include "VoxelNavGrid.h"
+
+TSharedRef<FVoxelFlowField> FVoxelFlowField::Build(const FVoxelNavQuery& Nav, const FIntVector& Goal, const FIntVector& Extent,
+	const std::atomic<bool>* CancelFlag)
+{
+	TSharedRef<FVoxelFlowField> Field = MakeShared<FVoxelFlowField>();
+	Field->Goal = Goal;
+	Field->Min = Goal - Extent;
+	Field->Max = Goal + Extent;
+
+	if (!Nav.IsWalkable(Goal)) return Field;
+
+	struct FEntry
+	{
+		float Cost;
+		FIntVector Coord;
+	};
+	auto ByCost = [](const FEntry& A, const FEntry& B) { return A.Cost < B.Cost; };
+
+	TArray<FEntry> Heap;
+	TArray<FNeighborResult> Predecessors;
+
+	// Dijkstra outwards from the goal over reversed links
+	Field->Cells.Add(Goal, FCell{ Goal, 0.f });
+	Heap.HeapPush(FEntry{ 0.f, Goal }, ByCost);
+
+	int32 Expanded = 0;
+	while (Heap.Num() > 0)
+	{
+		if (CancelFlag && (++Expanded & 1023) == 0 && CancelFlag->load(std::memory_order_relaxed))
+		{
+			break;
+		}
+
+		FEntry Entry;
+		Heap.HeapPop(Entry, ByCost, EAllowShrinking::No);
+		if (Entry.Cost > Field->Cells.FindChecked(Entry.Coord).Cost) continue;  // Superseded by a cheaper push
+
+		Predecessors.Reset();
+		VoxelNav::AppendPredecessors(Nav, Entry.Coord, Predecessors);
+		for (const FNeighborResult& Predecessor : Predecessors)
+		{
+			if (!Field->Contains(Predecessor.Coord)) continue;
+
+			const float NewCost = Entry.Cost + Predecessor.MoveCost;
+			if (const FCell* Existing = Field->Cells.Find(Predecessor.Coord); Existing && Existing->Cost <= NewCost) continue;
+
+			Field->Cells.Add(Predecessor.Coord, FCell{ Entry.Coord, NewCost });
+			Heap.HeapPush(FEntry{ NewCost, Predecessor.Coord }, ByCost);
+		}
+	}
+
+	return Field;
+}
+
+bool FVoxelFlowField::Contains(const FIntVector& Coord) const
+{
+	return Coord.X >= Min.X && Coord.X <= Max.X &&
+		Coord.Y >= Min.Y && Coord.Y <= Max.Y &&
+		Coord.Z >= Min.Z && Coord.Z <= Max.Z;
+}
+
+bool FVoxelFlowField::Intersects(const FIntVector& BoxMin, const FIntVector& BoxMax) const
+{
+	return BoxMin.X <= Max.X && BoxMax.X >= Min.X &&
+		BoxMin.Y <= Max.Y && BoxMax.Y >= Min.Y &&
+		BoxMin.Z <= Max.Z && BoxMax.Z >= Min.Z;
+}
+
+bool FVoxelFlowField::GetNext(const FIntVector& Coord, FIntVector& OutNext) const
+{
+	const FCell* Cell = Cells.Find(Coord);
+	if (!Cell || Coord == Goal) return false;
+
+	OutNext = Cell->Next;
+	return true;
+}
+
+FVector FVoxelFlowField::GetDirection(const FIntVector& Coord) const
+{
+	FIntVector Next;
+	if (!GetNext(Coord, Next)) return FVector::ZeroVector;
+
+	return (FPathfindingNode(Next).WorldPosition() - FPathfindingNode(Coord).WorldPosition()).GetSafeNormal();
+}
+
+float FVoxelFlowField::GetCost(const FIntVector& Coord) const
+{
+	const FCell* Cell = Cells.Find(Coord);
+	return Cell ? Cell->Cost : TNumericLimits<float>::Max();
+}
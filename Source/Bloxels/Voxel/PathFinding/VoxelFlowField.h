@@ -0,0 +1,48 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#pragma once
+
+#include <atomic>
+
+#include "CoreMinimal.h"
+
+class FVoxelNavQuery;
+
+/**
+ * Integration field towards one goal over a box of the nav grid. Holds the cheapest cost to the goal from every
+ * voxel in the box that can reach it without leaving the box, and the voxel to step to next. Costs are the
+ * same as A*, so following the field walks an optimal path within the box.
+ */
+class BLOXELS_API FVoxelFlowField
+{
+public:
+	// Safe on any thread. Extent is the half size of the box around the goal.
+	static TSharedRef<FVoxelFlowField> Build(const FVoxelNavQuery& Nav, const FIntVector& Goal, const FIntVector& Extent,
+		const std::atomic<bool>* CancelFlag = nullptr);
+
+	const FIntVector& GetGoal() const { return Goal; }
+	bool Contains(const FIntVector& Coord) const;
+	bool Intersects(const FIntVector& BoxMin, const FIntVector& BoxMax) const;
+
+	// Next voxel on a cheapest route to the goal. False at the goal and where the goal can't be reached.
+	bool GetNext(const FIntVector& Coord, FIntVector& OutNext) const;
+	// World space unit direction towards the next voxel, zero where GetNext fails
+	FVector GetDirection(const FIntVector& Coord) const;
+	// Cost to the goal, or TNumericLimits<float>::Max() when unreachable
+	float GetCost(const FIntVector& Coord) const;
+
+	int32 Num() const { return Cells.Num(); }
+	SIZE_T GetAllocatedSize() const { return Cells.GetAllocatedSize(); }
+
+private:
+	struct FCell
+	{
+		FIntVector Next;
+		float Cost = 0.f;
+	};
+
+	FIntVector Goal = FIntVector::ZeroValue;
+	FIntVector Min = FIntVector::ZeroValue;
+	FIntVector Max = FIntVector::ZeroValue;
+	TMap<FIntVector, FCell> Cells;
+};
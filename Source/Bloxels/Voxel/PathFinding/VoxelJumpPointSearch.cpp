@@ -0,0 +1,245 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#include "VoxelJumpPointSearch.h"
+
+#include "NeighborResult.h"
+#include "PathfindingCosts.h"
+#include "PathfindingManager.h"
+#include "PathfindingSearch.h"
+#include "VoxelNavGrid.h"
+#include "Algo/Reverse.h"
+
+namespace
+{
+	using namespace PathfindingCosts;
+
+	// Step-up and fall bits of every direction
+	constexpr uint32 VerticalLinkMask = 0xEEEEEEEEu;
+
+	bool HasVerticalLink(const FVoxelNavQuery& Nav, const FIntVector& Coord)
+	{
+		return (Nav.GetLinks(Coord) & VerticalLinkMask) != 0;
+	}
+
+	// A level diagonal needs both sides standable, the same rule IsDiagonalAllowed applies on a flat plane
+	bool CanStep(const FVoxelNavQuery& Nav, const FIntVector& From, const FIntVector& Step)
+	{
+		if (!Nav.IsWalkable(From + Step)) return false;
+		if (Step.X == 0 || Step.Y == 0) return true;
+		return Nav.IsWalkable(From + FIntVector(Step.X, 0, 0)) && Nav.IsWalkable(From + FIntVector(0, Step.Y, 0));
+	}
+
+	bool HasForcedNeighbor(const FVoxelNavQuery& Nav, const FIntVector& Coord, const FIntVector& Step)
+	{
+		const FIntVector Side = Step.X != 0 ? FIntVector(0, 1, 0) : FIntVector(1, 0, 0);
+		return (Nav.IsWalkable(Coord + Side) && !Nav.IsWalkable(Coord - Step + Side)) ||
+			(Nav.IsWalkable(Coord - Side) && !Nav.IsWalkable(Coord - Step - Side));
+	}
+
+	bool JumpStraight(const FVoxelNavQuery& Nav, FIntVector Coord, const FIntVector& Step, const FIntVector& Goal, FIntVector& OutJumpPoint)
+	{
+		while (CanStep(Nav, Coord, Step))
+		{
+			Coord += Step;
+			if (Coord == Goal || HasVerticalLink(Nav, Coord) || HasForcedNeighbor(Nav, Coord, Step))
+			{
+				OutJumpPoint = Coord;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool JumpDiagonal(const FVoxelNavQuery& Nav, FIntVector Coord, const FIntVector& Step, const FIntVector& Goal, FIntVector& OutJumpPoint)
+	{
+		FIntVector Unused;
+		while (CanStep(Nav, Coord, Step))
+		{
+			Coord += Step;
+			if (Coord == Goal || HasVerticalLink(Nav, Coord) ||
+				JumpStraight(Nav, Coord, FIntVector(Step.X, 0, 0), Goal, Unused) ||
+				JumpStraight(Nav, Coord, FIntVector(0, Step.Y, 0), Goal, Unused))
+			{
+				OutJumpPoint = Coord;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool Jump(const FVoxelNavQuery& Nav, const FIntVector& Coord, const FIntVector& Step, const FIntVector& Goal, FIntVector& OutJumpPoint)
+	{
+		return Step.X != 0 && Step.Y != 0
+			? JumpDiagonal(Nav, Coord, Step, Goal, OutJumpPoint)
+			: JumpStraight(Nav, Coord, Step, Goal, OutJumpPoint);
+	}
+
+	float LineCost(const FIntVector& From, const FIntVector& To)
+	{
+		const int32 Steps = FMath::Max(FMath::Abs(To.X - From.X), FMath::Abs(To.Y - From.Y));
+		return Steps * (To.X != From.X && To.Y != From.Y ? DiagonalCost : StraightCost);
+	}
+
+	void AddSuccessor(const FVoxelNavQuery& Nav, const FIntVector& Coord, const FIntVector& Step, const FIntVector& Goal, TArray<FNeighborResult>& OutSuccessors)
+	{
+		FIntVector JumpPoint;
+		if (Jump(Nav, Coord, Step, Goal, JumpPoint))
+		{
+			OutSuccessors.Add(FNeighborResult(JumpPoint, LineCost(Coord, JumpPoint)));
+		}
+	}
+
+	void GetSuccessors(const FVoxelNavQuery& Nav, FPathSearchContext& Search, const int32 NodeIndex, const FIntVector& Goal, TArray<FNeighborResult>& OutSuccessors)
+	{
+		OutSuccessors.Reset();
+
+		const FPathfindingNode& Node = Search.Nodes[NodeIndex];
+		const FIntVector Coord = Node.Coord;
+		const int32 ParentIndex = Node.Parent;
+
+		// Start nodes, voxels with vertical links and voxels reached by one see every move they have
+		if (ParentIndex == INDEX_NONE || Search.Nodes[ParentIndex].Coord.Z != Coord.Z || HasVerticalLink(Nav, Coord))
+		{
+			Search.Neighbors.Reset();
+			VoxelNav::AppendNeighbors(Coord, Nav.GetLinks(Coord), Search.Neighbors);
+			for (const FNeighborResult& Neighbor : Search.Neighbors)
+			{
+				if (Neighbor.Coord.Z == Coord.Z)
+				{
+					AddSuccessor(Nav, Coord, Neighbor.Coord - Coord, Goal, OutSuccessors);
+				}
+				else
+				{
+					OutSuccessors.Add(Neighbor);
+				}
+			}
+			return;
+		}
+
+		const FIntVector Delta = Coord - Search.Nodes[ParentIndex].Coord;
+		const int32 DX = FMath::Sign(Delta.X);
+		const int32 DY = FMath::Sign(Delta.Y);
+
+		if (DX != 0 && DY != 0)
+		{
+			AddSuccessor(Nav, Coord, FIntVector(DX, 0, 0), Goal, OutSuccessors);
+			AddSuccessor(Nav, Coord, FIntVector(0, DY, 0), Goal, OutSuccessors);
+			AddSuccessor(Nav, Coord, FIntVector(DX, DY, 0), Goal, OutSuccessors);
+			return;
+		}
+
+		// Straight: ahead, both sides, and the diagonals ahead
+		const FIntVector Ahead(DX, DY, 0);
+		const FIntVector Side = DX != 0 ? FIntVector(0, 1, 0) : FIntVector(1, 0, 0);
+		AddSuccessor(Nav, Coord, Ahead, Goal, OutSuccessors);
+		AddSuccessor(Nav, Coord, Side, Goal, OutSuccessors);
+		AddSuccessor(Nav, Coord, -Side, Goal, OutSuccessors);
+		AddSuccessor(Nav, Coord, Ahead + Side, Goal, OutSuccessors);
+		AddSuccessor(Nav, Coord, Ahead - Side, Goal, OutSuccessors);
+	}
+}
+
+bool VoxelJumpPointSearch::FindPath(const FVoxelNavQuery& Nav, FPathSearchContext& Search, const FPathSearchParams& Params, TArray<FVector>& OutPathPoints, FPathfindingStats& OutStats)
+{
+	OutPathPoints.Reset();
+	OutStats = FPathfindingStats();
+
+	const FIntVector StartCoord = Params.Start;
+	const FIntVector EndCoord = Params.End;
+	if (!Nav.IsWalkable(StartCoord) || !Nav.IsWalkable(EndCoord)) return false;
+
+	const double StartTime = FPlatformTime::Seconds();
+	Search.Reset();
+
+	bool bAdded = false;
+	const int32 StartIndex = Search.FindOrAddNode(StartCoord, bAdded);
+	Search.Nodes[StartIndex].HCost = UPathfindingManager::Heuristic(StartCoord, EndCoord);
+	Search.OpenSet.Push(StartIndex);
+
+	TArray<FNeighborResult> Successors;
+	int32 EndIndex = INDEX_NONE;
+	while (!Search.OpenSet.IsEmpty())
+	{
+		if (Params.CancelFlag && (OutStats.NodesExpanded & 255) == 0 && Params.CancelFlag->load(std::memory_order_relaxed))
+		{
+			OutStats.bCancelled = true;
+			break;
+		}
+
+		const int32 CurrentIndex = Search.OpenSet.Pop();
+		Search.Nodes[CurrentIndex].bClosed = true;
+		OutStats.NodesExpanded++;
+
+		const FIntVector CurrentCoord = Search.Nodes[CurrentIndex].Coord;
+		const float CurrentGCost = Search.Nodes[CurrentIndex].GCost;
+		if (CurrentCoord == EndCoord)
+		{
+			EndIndex = CurrentIndex;
+			break;
+		}
+
+		GetSuccessors(Nav, Search, CurrentIndex, EndCoord, Successors);
+		for (const FNeighborResult& Successor : Successors)
+		{
+			const int32 SuccessorIndex = Search.FindOrAddNode(Successor.Coord, bAdded);
+			FPathfindingNode& Node = Search.Nodes[SuccessorIndex];
+			if (Node.bClosed) continue;
+
+			const float NewGCost = CurrentGCost + Successor.MoveCost;
+			if (!bAdded && NewGCost >= Node.GCost) continue;
+
+			Node.GCost = NewGCost;
+			Node.Parent = CurrentIndex;
+
+			if (bAdded)
+			{
+				Node.HCost = UPathfindingManager::Heuristic(Successor.Coord, EndCoord);
+				Search.OpenSet.Push(SuccessorIndex);
+			}
+			else if (Search.OpenSet.Contains(SuccessorIndex))
+			{
+				Search.OpenSet.DecreaseKey(SuccessorIndex);
+			}
+		}
+	}
+
+	OutStats.NodesGenerated = Search.Nodes.Num();
+	OutStats.Seconds = FPlatformTime::Seconds() - StartTime;
+	if (EndIndex == INDEX_NONE)
+	{
+		if (!OutStats.bCancelled)
+		{
+			UE_LOG(LogTemp, Warning, TEXT("Pathfinding failed."));
+		}
+		return false;
+	}
+
+	// Jump points are joined by straight or diagonal runs on one plane; fill in the voxels between them
+	TArray<FIntVector> JumpPoints;
+	for (int32 Index = EndIndex; Index != INDEX_NONE; Index = Search.Nodes[Index].Parent)
+	{
+		JumpPoints.Add(Search.Nodes[Index].Coord);
+	}
+	Algo::Reverse(JumpPoints);
+
+	OutPathPoints.Add(FPathfindingNode(JumpPoints[0]).WorldPosition());
+	for (int32 Index = 1; Index < JumpPoints.Num(); ++Index)
+	{
+		const FIntVector From = JumpPoints[Index - 1];
+		const FIntVector To = JumpPoints[Index];
+		const FIntVector Step(FMath::Sign(To.X - From.X), FMath::Sign(To.Y - From.Y), 0);
+
+		if (From.Z == To.Z)
+		{
+			for (FIntVector Coord = From + Step; Coord != To; Coord += Step)
+			{
+				OutPathPoints.Add(FPathfindingNode(Coord).WorldPosition());
+			}
+		}
+		OutPathPoints.Add(FPathfindingNode(To).WorldPosition());
+	}
+
+	OutStats.PathCost = Search.Nodes[EndIndex].GCost;
+	UE_LOG(LogTemp, Verbose, TEXT("Jump point path built with %d nodes."), OutPathPoints.Num());
+	return true;
+}
@@ -0,0 +1,21 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FVoxelNavQuery;
+struct FPathSearchContext;
+struct FPathSearchParams;
+struct FPathfindingStats;
+
+/**
+ * Jump point search over the voxel nav grid. Level moves on one Z plane form an 8-connected grid without
+ * corner cutting, so they are pruned and jumped over the usual way. Step-ups and falls leave the plane:
+ * voxels that have one are always jump points, and nodes reached through one are expanded in full.
+ * Paths cost the same as A* and come back with every voxel filled in.
+ */
+namespace VoxelJumpPointSearch
+{
+	bool FindPath(const FVoxelNavQuery& Nav, FPathSearchContext& Search, const FPathSearchParams& Params, TArray<FVector>& OutPathPoints, FPathfindingStats& OutStats);
+}
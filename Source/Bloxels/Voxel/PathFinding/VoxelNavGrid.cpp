@@ -0,0 +1,536 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#include "VoxelNavGrid.h"
+
+#include "NeighborResult.h"
+#include "PathfindingCosts.h"
+#include "Bloxels/Voxel/VoxelRegistry/VoxelRegistrySubsystem.h"
+#include "Async/Async.h"
+#include "Bloxels/Voxel/World/VoxelWorld.h"
+#include "Tasks/Task.h"
+
+namespace VoxelNav
+{
+	const FIntVector Directions[NumDirections] = {
+		FIntVector( 1,  0, 0),
+		FIntVector(-1,  0, 0),
+		FIntVector( 0,  1, 0),
+		FIntVector( 0, -1, 0),
+		FIntVector( 1,  1, 0),
+		FIntVector( 1, -1, 0),
+		FIntVector(-1,  1, 0),
+		FIntVector(-1, -1, 0),
+	};
+
+	static_assert(PathfindingCosts::MaxStepUp == 1, "Links encode a single step-up height");
+	static_assert(PathfindingCosts::MaxFallDistance <= 3, "Links encode falls of up to 3 voxels");
+
+	void AppendNeighbors(const FIntVector& From, const uint32 Links, TArray<FNeighborResult>& OutNeighbors)
+	{
+		using namespace PathfindingCosts;
+
+		for (int32 Direction = 0; Direction < NumDirections; ++Direction)
+		{
+			const uint8 Link = GetLink(Links, Direction);
+			if (Link == 0) continue;
+
+			const FIntVector Base = From + Directions[Direction];
+			const float MoveCost = Direction < 4 ? StraightCost : DiagonalCost;
+
+			if (Link & LinkLevel)
+			{
+				OutNeighbors.Add(FNeighborResult(Base, MoveCost));
+				continue;
+			}
+
+			if (Link & LinkStepUp)
+			{
+				OutNeighbors.Add(FNeighborResult(Base + FIntVector(0, 0, 1), MoveCost + StepUpCost));
+			}
+
+			if (const int32 Drop = Link >> LinkFallShift; Drop > 0)
+			{
+				OutNeighbors.Add(FNeighborResult(Base - FIntVector(0, 0, Drop), MoveCost + FallCost * Drop));
+			}
+		}
+	}
+}
+
+namespace
+{
+	// Same rules as the original per-query neighbour search, evaluated once per voxel
+
+	template <typename SamplerType>
+	bool AreSidesClear(const SamplerType& Sampler, const FIntVector& Coord, const FIntVector& Offset)
+	{
+		const FIntVector Side1 = Coord + FIntVector(Offset.X, 0, 0);
+		const FIntVector Side2 = Coord + FIntVector(0, Offset.Y, 0);
+		const FIntVector Up(0, 0, 1);
+		return Sampler.IsAir(Side1) && Sampler.IsAir(Side1 + Up) && Sampler.IsAir(Side2) && Sampler.IsAir(Side2 + Up);
+	}
+
+	template <typename SamplerType>
+	bool IsDiagonalAllowed(const SamplerType& Sampler, const FIntVector& Coord, const FIntVector& Offset)
+	{
+		if (AreSidesClear(Sampler, Coord, Offset))
+		{
+			const FIntVector Diagonal = Coord + Offset;
+			for (int Drop = 1; Drop <= PathfindingCosts::MaxFallDistance; ++Drop)
+			{
+				const FIntVector DropCoord = Diagonal - FIntVector(0, 0, Drop);
+				if (Sampler.IsWalkable(DropCoord)) return true;
+				if (Sampler.IsSolid(DropCoord)) break;
+			}
+		}
+
+		// If not dropping, enforce no corner cutting
+		return Sampler.IsWalkable(Coord + FIntVector(Offset.X, 0, 0)) && Sampler.IsWalkable(Coord + FIntVector(0, Offset.Y, 0));
+	}
+
+	template <typename SamplerType>
+	uint8 TryStepUp(const SamplerType& Sampler, const FIntVector& Base)
+	{
+		return Sampler.IsWalkable(Base + FIntVector(0, 0, 1)) ? VoxelNav::LinkStepUp : 0;
+	}
+
+	template <typename SamplerType>
+	uint8 TryFallDown(const SamplerType& Sampler, const FIntVector& Coord, const FIntVector& Offset)
+	{
+		if (!AreSidesClear(Sampler, Coord, Offset)) return 0;
+
+		const FIntVector Start = Coord + Offset;
+		for (int Drop = 1; Drop <= PathfindingCosts::MaxFallDistance; ++Drop)
+		{
+			const FIntVector FallCoord = Start - FIntVector(0, 0, Drop);
+			if (Sampler.IsWalkable(FallCoord)) return static_cast<uint8>(Drop << VoxelNav::LinkFallShift);
+			if (Sampler.IsSolid(FallCoord)) break;
+		}
+		return 0;
+	}
+
+	template <typename SamplerType>
+	uint32 ComputeLinks(const SamplerType& Sampler, const FIntVector& Coord)
+	{
+		if (!Sampler.IsWalkable(Coord)) return 0;
+
+		uint32 Links = 0;
+		for (int32 Direction = 0; Direction < VoxelNav::NumDirections; ++Direction)
+		{
+			const FIntVector Offset = VoxelNav::Directions[Direction];
+			if (Offset.X != 0 && Offset.Y != 0 && !IsDiagonalAllowed(Sampler, Coord, Offset))
+			{
+				continue;
+			}
+
+			uint8 Link;
+			if (Sampler.IsWalkable(Coord + Offset))
+			{
+				Link = VoxelNav::LinkLevel;
+			}
+			else
+			{
+				Link = TryStepUp(Sampler, Coord + Offset) | TryFallDown(Sampler, Coord, Offset);
+			}
+
+			Links |= static_cast<uint32>(Link) << (Direction * VoxelNav::LinkBits);
+		}
+		return Links;
+	}
+
+	// Links read voxels up to one step sideways, MaxFallDistance + 1 below and two above
+	constexpr int32 LinkReachBelow = PathfindingCosts::MaxFallDistance + 1;
+	constexpr int32 LinkReachAbove = PathfindingCosts::MaxStepUp + 1;
+
+	bool IsLinkInterior(const int32 X, const int32 Y, const int32 Z, const int32 ChunkSize)
+	{
+		return X >= 1 && X < ChunkSize - 1 &&
+			Y >= 1 && Y < ChunkSize - 1 &&
+			Z >= LinkReachBelow && Z < ChunkSize - LinkReachAbove;
+	}
+
+	// Reads a chunk that is still being built; only interior links are computed with it
+	struct FChunkSampler
+	{
+		const FVoxelNavChunk& Chunk;
+
+		bool Contains(const FIntVector& C) const
+		{
+			return C.X >= 0 && C.X < Chunk.ChunkSize && C.Y >= 0 && C.Y < Chunk.ChunkSize && C.Z >= 0 && C.Z < Chunk.ChunkSize;
+		}
+		bool IsAir(const FIntVector& C) const { return !Contains(C) || Chunk.Air[Chunk.GetIndex(C.X, C.Y, C.Z)]; }
+		bool IsSolid(const FIntVector& C) const { return Contains(C) && Chunk.Solid[Chunk.GetIndex(C.X, C.Y, C.Z)]; }
+		bool IsWalkable(const FIntVector& C) const { return IsAir(C) && IsAir(C + FIntVector(0, 0, 1)) && IsSolid(C - FIntVector(0, 0, 1)); }
+	};
+}
+
+// Query
+
+FVoxelNavQuery::FVoxelNavQuery(const FVoxelNavChunkMap& InChunks, const int32 InChunkSize, const FVoxelNavGraphMap* InGraphs)
+	: Chunks(InChunks), ChunkSize(InChunkSize), Graphs(InGraphs)
+{
+}
+
+const FVoxelNavChunkGraph* FVoxelNavQuery::FindGraph(const FIntVector& ChunkCoord) const
+{
+	const TSharedPtr<const FVoxelNavChunkGraph>* Found = Graphs ? Graphs->Find(ChunkCoord) : nullptr;
+	return Found ? Found->Get() : nullptr;
+}
+
+const FVoxelNavChunk* FVoxelNavQuery::Find(const FIntVector& Coord, int32& OutIndex) const
+{
+	const FIntVector ChunkCoord = AVoxelWorld::GetChunkCoord(Coord, ChunkSize);
+	if (ChunkCoord != CachedCoord)
+	{
+		const TSharedPtr<const FVoxelNavChunk>* Found = Chunks.Find(ChunkCoord);
+		CachedCoord = ChunkCoord;
+		CachedChunk = Found ? Found->Get() : nullptr;
+	}
+
+	if (CachedChunk)
+	{
+		const FIntVector Local = Coord - ChunkCoord * ChunkSize;
+		OutIndex = CachedChunk->GetIndex(Local.X, Local.Y, Local.Z);
+	}
+	return CachedChunk;
+}
+
+bool FVoxelNavQuery::IsAir(const FIntVector& Coord) const
+{
+	int32 Index;
+	const FVoxelNavChunk* Chunk = Find(Coord, Index);
+	return !Chunk || Chunk->Air[Index];
+}
+
+bool FVoxelNavQuery::IsSolid(const FIntVector& Coord) const
+{
+	int32 Index;
+	const FVoxelNavChunk* Chunk = Find(Coord, Index);
+	return Chunk && Chunk->Solid[Index];
+}
+
+bool FVoxelNavQuery::IsLoaded(const FIntVector& Coord) const
+{
+	int32 Index;
+	return Find(Coord, Index) != nullptr;
+}
+
+bool FVoxelNavQuery::IsWalkable(const FIntVector& Coord) const
+{
+	if (UnloadedPolicy != EUnloadedChunkPolicy::Air && !IsLoaded(Coord)) return false;
+
+	return IsAir(Coord) && IsAir(Coord + FIntVector(0, 0, 1)) && IsSolid(Coord - FIntVector(0, 0, 1));
+}
+
+uint32 FVoxelNavQuery::GetLinks(const FIntVector& Coord) const
+{
+	int32 Index;
+	if (const FVoxelNavChunk* Chunk = Find(Coord, Index); Chunk && Chunk->LinksValid[Index])
+	{
+		return Chunk->Links[Index];
+	}
+	return ComputeLinks(*this, Coord);
+}
+
+namespace VoxelNav
+{
+	void AppendPredecessors(const FVoxelNavQuery& Nav, const FIntVector& To, TArray<FNeighborResult>& OutNeighbors)
+	{
+		using namespace PathfindingCosts;
+
+		for (int32 Direction = 0; Direction < NumDirections; ++Direction)
+		{
+			const FIntVector Base = To - Directions[Direction];
+			const float MoveCost = Direction < 4 ? StraightCost : DiagonalCost;
+
+			// Level from the same height, a step up from one below, or a fall from up to MaxFallDistance above
+			for (int32 Rise = -MaxStepUp; Rise <= MaxFallDistance; ++Rise)
+			{
+				const FIntVector From = Base + FIntVector(0, 0, Rise);
+				const uint8 Link = GetLink(Nav.GetLinks(From), Direction);
+				if (Link == 0) continue;
+
+				if (Rise == 0 && (Link & LinkLevel))
+				{
+					OutNeighbors.Add(FNeighborResult(From, MoveCost));
+				}
+				else if (Rise < 0 && (Link & LinkStepUp))
+				{
+					OutNeighbors.Add(FNeighborResult(From, MoveCost + StepUpCost));
+				}
+				else if (Rise > 0 && (Link >> LinkFallShift) == Rise)
+				{
+					OutNeighbors.Add(FNeighborResult(From, MoveCost + FallCost * Rise));
+				}
+			}
+		}
+	}
+}
+
+// Grid
+
+void FVoxelNavGrid::Initialize(const int32 InChunkSize, const UVoxelRegistrySubsystem* Registry)
+{
+	ChunkSize = InChunkSize;
+
+	const int32 VoxelCount = Registry->GetVoxelCount();
+	AirTable.Init(false, VoxelCount);
+	SolidTable.Init(false, VoxelCount);
+
+	for (int32 ID = 0; ID < VoxelCount; ++ID)
+	{
+		if (const UVoxelData* Voxel = Registry->GetVoxelByID(ID))
+		{
+			AirTable[ID] = Voxel->VoxelID == FName("Air");
+			SolidTable[ID] = Voxel->bIsSolid;
+		}
+	}
+}
+
+TSharedRef<FVoxelNavChunk> FVoxelNavGrid::BuildChunk(const TArray<uint16>& VoxelData) const
+{
+	TSharedRef<FVoxelNavChunk> NavChunk = MakeShared<FVoxelNavChunk>();
+	const int32 NumVoxels = ChunkSize * ChunkSize * ChunkSize;
+
+	NavChunk->ChunkSize = ChunkSize;
+	NavChunk->Air.Init(false, NumVoxels);
+	NavChunk->Solid.Init(false, NumVoxels);
+	NavChunk->LinksValid.Init(false, NumVoxels);
+	NavChunk->Links.Init(0, NumVoxels);
+
+	for (int32 Index = 0; Index < NumVoxels && Index < VoxelData.Num(); ++Index)
+	{
+		const uint16 VoxelID = VoxelData[Index];
+		NavChunk->Air[Index] = AirTable.IsValidIndex(VoxelID) && AirTable[VoxelID];
+		NavChunk->Solid[Index] = SolidTable.IsValidIndex(VoxelID) && SolidTable[VoxelID];
+	}
+
+	// Precompute links that don't depend on neighbouring chunks; the rest are derived at query time
+	const FChunkSampler Sampler{ *NavChunk };
+	for (int32 Z = LinkReachBelow; Z < ChunkSize - LinkReachAbove; ++Z)
+	{
+		for (int32 Y = 1; Y < ChunkSize - 1; ++Y)
+		{
+			for (int32 X = 1; X < ChunkSize - 1; ++X)
+			{
+				const int32 Index = NavChunk->GetIndex(X, Y, Z);
+				NavChunk->Links[Index] = ComputeLinks(Sampler, FIntVector(X, Y, Z));
+				NavChunk->LinksValid[Index] = true;
+			}
+		}
+	}
+
+	return NavChunk;
+}
+
+void FVoxelNavGrid::AddChunk(const FIntVector& ChunkCoord, const TSharedPtr<FVoxelNavChunk>& NavChunk)
+{
+	if (NavChunk.IsValid())
+	{
+		GetWritableChunks().Add(ChunkCoord, NavChunk);
+
+		// Crossing links to every neighbour appear with this chunk
+		InvalidateGraphs(ChunkCoord - FIntVector(1), ChunkCoord + FIntVector(1));
+		BuildDirtyGraphs();
+	}
+}
+
+void FVoxelNavGrid::RemoveChunk(const FIntVector& ChunkCoord)
+{
+	if (Chunks->Contains(ChunkCoord))
+	{
+		GetWritableChunks().Remove(ChunkCoord);
+		if (Graphs->Contains(ChunkCoord))
+		{
+			GetWritableGraphs().Remove(ChunkCoord);
+		}
+		GraphVersions.Remove(ChunkCoord);
+		DirtyGraphs.Remove(ChunkCoord);
+		InvalidateGraphs(ChunkCoord - FIntVector(1), ChunkCoord + FIntVector(1));
+		BuildDirtyGraphs();
+	}
+}
+
+void FVoxelNavGrid::QueueVoxelChange(const FIntVector& Coord, const uint16 NewID)
+{
+	PendingChanges.Add(Coord, NewID);
+}
+
+void FVoxelNavGrid::Flush()
+{
+	if (PendingChanges.Num() == 0) return;
+
+	// Copy-on-write: touched chunks are cloned once per flush, everything else keeps its published pointer
+	FVoxelNavChunkMap& Working = GetWritableChunks();
+	TMap<FIntVector, FVoxelNavChunk*> Mutable;
+
+	auto GetMutable = [&](const FIntVector& ChunkCoord) -> FVoxelNavChunk*
+	{
+		if (FVoxelNavChunk** Existing = Mutable.Find(ChunkCoord))
+		{
+			return *Existing;
+		}
+
+		TSharedPtr<const FVoxelNavChunk>* Published = Working.Find(ChunkCoord);
+		if (!Published) return nullptr;
+
+		TSharedPtr<FVoxelNavChunk> Copy = MakeShared<FVoxelNavChunk>(**Published);
+		*Published = Copy;
+		return Mutable.Add(ChunkCoord, Copy.Get());
+	};
+
+	TSet<FIntVector> Relink;
+	for (const TPair<FIntVector, uint16>& Change : PendingChanges)
+	{
+		FIntVector MinChunk, MaxChunk;
+		VoxelNavHierarchy::GetAffectedChunks(Change.Key, ChunkSize, MinChunk, MaxChunk);
+		InvalidateGraphs(MinChunk, MaxChunk);
+
+		const FIntVector ChunkCoord = AVoxelWorld::GetChunkCoord(Change.Key, ChunkSize);
+		if (FVoxelNavChunk* NavChunk = GetMutable(ChunkCoord))
+		{
+			const FIntVector Local = Change.Key - ChunkCoord * ChunkSize;
+			const int32 Index = NavChunk->GetIndex(Local.X, Local.Y, Local.Z);
+			NavChunk->Air[Index] = AirTable.IsValidIndex(Change.Value) && AirTable[Change.Value];
+			NavChunk->Solid[Index] = SolidTable.IsValidIndex(Change.Value) && SolidTable[Change.Value];
+		}
+
+		// Every voxel whose links read the changed one
+		for (int32 Z = -LinkReachAbove; Z <= LinkReachBelow; ++Z)
+		{
+			for (int32 Y = -1; Y <= 1; ++Y)
+			{
+				for (int32 X = -1; X <= 1; ++X)
+				{
+					Relink.Add(Change.Key + FIntVector(X, Y, Z));
+				}
+			}
+		}
+	}
+	PendingChanges.Reset();
+
+	const FVoxelNavQuery Query(Working, ChunkSize);
+	for (const FIntVector& Coord : Relink)
+	{
+		const FIntVector ChunkCoord = AVoxelWorld::GetChunkCoord(Coord, ChunkSize);
+		const FIntVector Local = Coord - ChunkCoord * ChunkSize;
+		if (!IsLinkInterior(Local.X, Local.Y, Local.Z, ChunkSize)) continue;
+
+		if (FVoxelNavChunk* NavChunk = GetMutable(ChunkCoord))
+		{
+			NavChunk->Links[NavChunk->GetIndex(Local.X, Local.Y, Local.Z)] = ComputeLinks(Query, Coord);
+		}
+	}
+
+	BuildDirtyGraphs();
+}
+
+TSharedRef<const FVoxelNavSnapshot> FVoxelNavGrid::GetSnapshot() const
+{
+	// Chunks and graphs are never written after being published, and the maps are copied before the grid writes to
+	// one a snapshot holds, so sharing them is enough
+	if (!Snapshot.IsValid())
+	{
+		TSharedRef<FVoxelNavSnapshot> NewSnapshot = MakeShared<FVoxelNavSnapshot>();
+		NewSnapshot->Chunks = Chunks;
+		NewSnapshot->Graphs = Graphs;
+		NewSnapshot->ChunkSize = ChunkSize;
+		Snapshot = NewSnapshot;
+	}
+	return Snapshot.ToSharedRef();
+}
+
+FVoxelNavChunkMap& FVoxelNavGrid::GetWritableChunks()
+{
+	// The cached snapshot goes first so it doesn't force a copy. Only the game thread adds references, so a count of
+	// one can't grow while the map is written.
+	Snapshot.Reset();
+	if (!Chunks.IsUnique())
+	{
+		Chunks = MakeShared<FVoxelNavChunkMap>(*Chunks);
+	}
+	return *Chunks;
+}
+
+FVoxelNavGraphMap& FVoxelNavGrid::GetWritableGraphs()
+{
+	Snapshot.Reset();
+	if (!Graphs.IsUnique())
+	{
+		Graphs = MakeShared<FVoxelNavGraphMap>(*Graphs);
+	}
+	return *Graphs;
+}
+
+void FVoxelNavGrid::InvalidateGraphs(const FIntVector& MinChunk, const FIntVector& MaxChunk)
+{
+	for (int32 Z = MinChunk.Z; Z <= MaxChunk.Z; ++Z)
+	{
+		for (int32 Y = MinChunk.Y; Y <= MaxChunk.Y; ++Y)
+		{
+			for (int32 X = MinChunk.X; X <= MaxChunk.X; ++X)
+			{
+				const FIntVector ChunkCoord(X, Y, Z);
+				if (!Chunks->Contains(ChunkCoord)) continue;
+
+				if (Graphs->Contains(ChunkCoord))
+				{
+					GetWritableGraphs().Remove(ChunkCoord);
+				}
+				GraphVersions.Add(ChunkCoord, NextGraphVersion++);
+				DirtyGraphs.Add(ChunkCoord);
+			}
+		}
+	}
+	Snapshot.Reset();
+}
+
+void FVoxelNavGrid::BuildDirtyGraphs()
+{
+	// One batch at a time; chunks dirtied meanwhile wait for the next one, which also coalesces bursts of edits
+	if (bGraphBuildInFlight || DirtyGraphs.Num() == 0) return;
+	bGraphBuildInFlight = true;
+
+	TArray<FBuiltGraph> Batch;
+	Batch.Reserve(DirtyGraphs.Num());
+	for (const FIntVector& ChunkCoord : DirtyGraphs)
+	{
+		Batch.Add(FBuiltGraph{ ChunkCoord, GraphVersions.FindChecked(ChunkCoord) });
+	}
+	DirtyGraphs.Reset();
+
+	UE::Tasks::Launch(TEXT("NavGraphBuild"),
+		[WeakGrid = AsWeak(), NavSnapshot = GetSnapshot(), Batch = MoveTemp(Batch)]() mutable
+		{
+			const FVoxelNavQuery Query(*NavSnapshot->Chunks, NavSnapshot->ChunkSize);
+			for (FBuiltGraph& Entry : Batch)
+			{
+				Entry.Graph = VoxelNavHierarchy::BuildChunkGraph(Query, Entry.ChunkCoord);
+			}
+
+			AsyncTask(ENamedThreads::GameThread, [WeakGrid, Batch = MoveTemp(Batch)]() mutable
+			{
+				if (const TSharedPtr<FVoxelNavGrid> Grid = WeakGrid.Pin())
+				{
+					Grid->OnGraphsBuilt(MoveTemp(Batch));
+				}
+			});
+		},
+		UE::Tasks::ETaskPriority::BackgroundNormal);
+}
+
+void FVoxelNavGrid::OnGraphsBuilt(TArray<FBuiltGraph> Built)
+{
+	bGraphBuildInFlight = false;
+
+	for (FBuiltGraph& Entry : Built)
+	{
+		const uint32* Version = GraphVersions.Find(Entry.ChunkCoord);
+		if (Version && *Version == Entry.Version)
+		{
+			GetWritableGraphs().Add(Entry.ChunkCoord, MoveTemp(Entry.Graph));
+		}
+	}
+	Snapshot.Reset();
+
+	BuildDirtyGraphs();
+}
@@ -0,0 +1,165 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "VoxelNavHierarchy.h"
+
+class UVoxelRegistrySubsystem;
+struct FNeighborResult;
+
+namespace VoxelNav
+{
+	// Each walkable voxel stores one 4-bit link per horizontal direction:
+	// bit 0 same level, bit 1 step up, bits 2-3 fall distance (0 = no fall)
+	constexpr uint8 LinkLevel = 1 << 0;
+	constexpr uint8 LinkStepUp = 1 << 1;
+	constexpr int32 LinkFallShift = 2;
+	constexpr int32 LinkBits = 4;
+	constexpr int32 NumDirections = 8;
+
+	// Straight directions first, then diagonals (the order GetNeighbors has always used)
+	extern const FIntVector Directions[NumDirections];
+
+	FORCEINLINE uint8 GetLink(const uint32 Links, const int32 Direction) { return (Links >> (Direction * LinkBits)) & 0xF; }
+
+	/** Expands a voxel's links into neighbours with their move costs. */
+	void AppendNeighbors(const FIntVector& From, uint32 Links, TArray<FNeighborResult>& OutNeighbors);
+}
+
+/** Navigation bits for one chunk, indexed like AVoxelChunk::VoxelData. */
+struct FVoxelNavChunk
+{
+	int32 ChunkSize = 0;
+	TBitArray<> Air;
+	TBitArray<> Solid;
+	TBitArray<> LinksValid;  // Set where every voxel the links depend on lies inside this chunk
+	TArray<uint32> Links;
+
+	int32 GetIndex(const int32 X, const int32 Y, const int32 Z) const { return (Z * ChunkSize * ChunkSize) + (Y * ChunkSize) + X; }
+};
+
+using FVoxelNavChunkMap = TMap<FIntVector, TSharedPtr<const FVoxelNavChunk>>;
+
+// How a query treats voxels in chunks that aren't loaded
+enum class EUnloadedChunkPolicy : uint8
+{
+	Air,      // Air that is not solid, matching AVoxelWorld::GetVoxelAtWorldCoordinates; the bottom layer can be stood on
+	Blocked,  // Never walkable
+	Unknown,  // Never walkable; a search that is cut off by it returns the best partial path instead of failing
+};
+
+/**
+ * Reads navigation bits across chunks. Missing chunks read as air that is not solid, matching
+ * AVoxelWorld::GetVoxelAtWorldCoordinates, but nothing in them is walkable unless the unloaded policy is set
+ * to Air. Links near chunk borders are derived on the fly from the bits.
+ */
+class BLOXELS_API FVoxelNavQuery
+{
+public:
+	FVoxelNavQuery(const FVoxelNavChunkMap& InChunks, int32 InChunkSize, const FVoxelNavGraphMap* InGraphs = nullptr);
+
+	bool IsAir(const FIntVector& Coord) const;
+	bool IsSolid(const FIntVector& Coord) const;
+	bool IsWalkable(const FIntVector& Coord) const;
+	uint32 GetLinks(const FIntVector& Coord) const;
+	bool IsLoaded(const FIntVector& Coord) const;
+
+	int32 GetChunkSize() const { return ChunkSize; }
+
+	EUnloadedChunkPolicy GetUnloadedPolicy() const { return UnloadedPolicy; }
+	void SetUnloadedPolicy(const EUnloadedChunkPolicy InPolicy) { UnloadedPolicy = InPolicy; }
+
+	// Published portal graph of a chunk, null while it is missing or being rebuilt
+	const FVoxelNavChunkGraph* FindGraph(const FIntVector& ChunkCoord) const;
+
+private:
+	const FVoxelNavChunkMap& Chunks;
+	int32 ChunkSize;
+	const FVoxelNavGraphMap* Graphs;
+	EUnloadedChunkPolicy UnloadedPolicy = EUnloadedChunkPolicy::Blocked;
+
+	// Searches are spatially coherent, so remember the last chunk
+	mutable FIntVector CachedCoord = FIntVector(MAX_int32);
+	mutable const FVoxelNavChunk* CachedChunk = nullptr;
+
+	const FVoxelNavChunk* Find(const FIntVector& Coord, int32& OutIndex) const;
+};
+
+namespace VoxelNav
+{
+	/** Voxels with a link into To, with the cost of that move. Reverse of AppendNeighbors, for searches run from the goal. */
+	void AppendPredecessors(const FVoxelNavQuery& Nav, const FIntVector& To, TArray<FNeighborResult>& OutNeighbors);
+}
+
+/** Immutable view of the grid's tables, shared with searches off the game thread. Holds the grid's own maps, not copies. */
+struct FVoxelNavSnapshot
+{
+	TSharedRef<const FVoxelNavChunkMap> Chunks = MakeShared<const FVoxelNavChunkMap>();
+	TSharedRef<const FVoxelNavGraphMap> Graphs = MakeShared<const FVoxelNavGraphMap>();
+	int32 ChunkSize = 0;
+
+	FVoxelNavQuery MakeQuery() const { return FVoxelNavQuery(*Chunks, ChunkSize, &*Graphs); }
+};
+
+/**
+ * Per-chunk walkability data for pathfinding. Chunks are built on the data generation worker and
+ * patched on the game thread when voxels change. Patches copy the touched chunks, so a chunk that
+ * has been published is never written again. The maps of chunk and graph pointers are shared with
+ * snapshots and copied only when the grid writes to one a snapshot still holds.
+ *
+ * Each chunk also gets a portal graph for hierarchical search. Adding, removing or editing a chunk drops
+ * the graphs it can affect and rebuilds them on a background task.
+ */
+class BLOXELS_API FVoxelNavGrid : public TSharedFromThis<FVoxelNavGrid>
+{
+public:
+	void Initialize(int32 InChunkSize, const UVoxelRegistrySubsystem* Registry);
+
+	// Safe on any thread
+	TSharedRef<FVoxelNavChunk> BuildChunk(const TArray<uint16>& VoxelData) const;
+
+	// Game thread
+	void AddChunk(const FIntVector& ChunkCoord, const TSharedPtr<FVoxelNavChunk>& NavChunk);
+	void RemoveChunk(const FIntVector& ChunkCoord);
+	void QueueVoxelChange(const FIntVector& Coord, uint16 NewID);
+	void Flush();
+
+	FVoxelNavQuery MakeQuery() const { return FVoxelNavQuery(*Chunks, ChunkSize, &*Graphs); }
+
+	// Immutable view of the current tables for searches off the game thread. Shared until the next change.
+	TSharedRef<const FVoxelNavSnapshot> GetSnapshot() const;
+	int32 GetChunkSize() const { return ChunkSize; }
+
+private:
+	int32 ChunkSize = 0;
+	TBitArray<> AirTable;
+	TBitArray<> SolidTable;
+
+	TSharedRef<FVoxelNavChunkMap> Chunks = MakeShared<FVoxelNavChunkMap>();
+	TMap<FIntVector, uint16> PendingChanges;
+
+	// Portal graphs. A build result is kept only if its chunk's version hasn't moved since the build started.
+	struct FBuiltGraph
+	{
+		FIntVector ChunkCoord;
+		uint32 Version = 0;
+		TSharedPtr<const FVoxelNavChunkGraph> Graph;
+	};
+
+	TSharedRef<FVoxelNavGraphMap> Graphs = MakeShared<FVoxelNavGraphMap>();
+	TMap<FIntVector, uint32> GraphVersions;
+	TSet<FIntVector> DirtyGraphs;
+	uint32 NextGraphVersion = 1;
+	bool bGraphBuildInFlight = false;
+
+	mutable TSharedPtr<const FVoxelNavSnapshot> Snapshot;
+
+	// The maps to write to, copied first while a snapshot still shares them
+	FVoxelNavChunkMap& GetWritableChunks();
+	FVoxelNavGraphMap& GetWritableGraphs();
+
+	void InvalidateGraphs(const FIntVector& MinChunk, const FIntVector& MaxChunk);
+	void BuildDirtyGraphs();
+	void OnGraphsBuilt(TArray<FBuiltGraph> Built);
+};
@@ -0,0 +1,395 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#include "VoxelNavHierarchy.h"
+
+#include "NeighborResult.h"
+#include "PathfindingCosts.h"
+#include "PathfindingManager.h"
+#include "PathfindingSearch.h"
+#include "VoxelNavGrid.h"
+#include "Algo/Reverse.h"
+#include "Bloxels/Voxel/World/VoxelWorld.h"
+
+namespace
+{
+	struct FCrossing
+	{
+		FIntVector From;
+		FIntVector To;
+		float Cost = 0.f;
+	};
+
+	// Chunk the link leaves, chunk it enters, portal window of the source voxel
+	using FCrossingKey = TTuple<FIntVector, FIntVector, FIntVector>;
+
+	bool IsCoordLess(const FIntVector& A, const FIntVector& B)
+	{
+		if (A.X != B.X) return A.X < B.X;
+		if (A.Y != B.Y) return A.Y < B.Y;
+		return A.Z < B.Z;
+	}
+
+	// Total order, so the chunks on both sides of a face pick the same portal
+	bool IsPreferred(const FCrossing& A, const FCrossing& B)
+	{
+		if (A.Cost != B.Cost) return A.Cost < B.Cost;
+		if (A.From != B.From) return IsCoordLess(A.From, B.From);
+		return IsCoordLess(A.To, B.To);
+	}
+
+	// Dijkstra from Source over voxels of one chunk. With bReverse the costs are to Source instead of from it.
+	void SearchChunk(const FVoxelNavQuery& Nav, const FIntVector& Source, const FIntVector& ChunkCoord, const bool bReverse, TMap<FIntVector, float>& OutCosts)
+	{
+		struct FEntry
+		{
+			float Cost;
+			FIntVector Coord;
+		};
+		auto ByCost = [](const FEntry& A, const FEntry& B) { return A.Cost < B.Cost; };
+
+		const int32 ChunkSize = Nav.GetChunkSize();
+		TArray<FEntry> Heap;
+		TArray<FNeighborResult> Neighbors;
+
+		OutCosts.Reset();
+		OutCosts.Add(Source, 0.f);
+		Heap.HeapPush(FEntry{ 0.f, Source }, ByCost);
+
+		while (Heap.Num() > 0)
+		{
+			FEntry Entry;
+			Heap.HeapPop(Entry, ByCost, EAllowShrinking::No);
+			if (Entry.Cost > OutCosts.FindChecked(Entry.Coord)) continue;  // Superseded by a cheaper push
+
+			Neighbors.Reset();
+			if (bReverse)
+			{
+				VoxelNav::AppendPredecessors(Nav, Entry.Coord, Neighbors);
+			}
+			else
+			{
+				VoxelNav::AppendNeighbors(Entry.Coord, Nav.GetLinks(Entry.Coord), Neighbors);
+			}
+
+			for (const FNeighborResult& Neighbor : Neighbors)
+			{
+				if (AVoxelWorld::GetChunkCoord(Neighbor.Coord, ChunkSize) != ChunkCoord) continue;
+
+				const float NewCost = Entry.Cost + Neighbor.MoveCost;
+				if (const float* Existing = OutCosts.Find(Neighbor.Coord); Existing && *Existing <= NewCost) continue;
+
+				OutCosts.Add(Neighbor.Coord, NewCost);
+				Heap.HeapPush(FEntry{ NewCost, Neighbor.Coord }, ByCost);
+			}
+		}
+	}
+}
+
+TSharedRef<FVoxelNavChunkGraph> VoxelNavHierarchy::BuildChunkGraph(const FVoxelNavQuery& Nav, const FIntVector& ChunkCoord)
+{
+	const int32 ChunkSize = Nav.GetChunkSize();
+	const FIntVector Origin = ChunkCoord * ChunkSize;
+
+	auto IsInside = [ChunkSize](const FIntVector& Local)
+	{
+		return Local.X >= 0 && Local.X < ChunkSize && Local.Y >= 0 && Local.Y < ChunkSize && Local.Z >= 0 && Local.Z < ChunkSize;
+	};
+
+	// Every link between this chunk and a neighbour, in either direction. Sources outside the chunk sit in a
+	// shell one voxel wide, one below (stepping up) and MaxFallDistance above (falling in).
+	TMap<FCrossingKey, FCrossing> Crossings;
+	TArray<FNeighborResult> Neighbors;
+	for (int32 Z = -PathfindingCosts::MaxStepUp; Z < ChunkSize + PathfindingCosts::MaxFallDistance; ++Z)
+	{
+		for (int32 Y = -1; Y <= ChunkSize; ++Y)
+		{
+			for (int32 X = -1; X <= ChunkSize; ++X)
+			{
+				const FIntVector Local(X, Y, Z);
+				const bool bInside = IsInside(Local);
+
+				// One link can't carry a voxel this far from the faces out of the chunk
+				if (bInside && X > 0 && X < ChunkSize - 1 && Y > 0 && Y < ChunkSize - 1 &&
+					Z >= PathfindingCosts::MaxFallDistance && Z < ChunkSize - PathfindingCosts::MaxStepUp)
+				{
+					continue;
+				}
+
+				const FIntVector Coord = Origin + Local;
+				const uint32 Links = Nav.GetLinks(Coord);
+				if (Links == 0) continue;
+
+				Neighbors.Reset();
+				VoxelNav::AppendNeighbors(Coord, Links, Neighbors);
+				for (const FNeighborResult& Neighbor : Neighbors)
+				{
+					if (IsInside(Neighbor.Coord - Origin) == bInside) continue;
+
+					const FCrossing Crossing{ Coord, Neighbor.Coord, Neighbor.MoveCost };
+					const FCrossingKey Key(
+						AVoxelWorld::GetChunkCoord(Coord, ChunkSize),
+						AVoxelWorld::GetChunkCoord(Neighbor.Coord, ChunkSize),
+						AVoxelWorld::GetChunkCoord(Coord, PortalSpacing));
+
+					FCrossing* Existing = Crossings.Find(Key);
+					if (!Existing)
+					{
+						Crossings.Add(Key, Crossing);
+					}
+					else if (IsPreferred(Crossing, *Existing))
+					{
+						*Existing = Crossing;
+					}
+				}
+			}
+		}
+	}
+
+	TSharedRef<FVoxelNavChunkGraph> Graph = MakeShared<FVoxelNavChunkGraph>();
+	auto AddNode = [&Graph](const FIntVector& Coord)
+	{
+		if (const int32* Existing = Graph->NodeLookup.Find(Coord))
+		{
+			return *Existing;
+		}
+
+		const int32 Index = Graph->Nodes.Add(Coord);
+		Graph->Edges.AddDefaulted();
+		Graph->Exits.AddDefaulted();
+		Graph->NodeLookup.Add(Coord, Index);
+		return Index;
+	};
+
+	for (const TPair<FCrossingKey, FCrossing>& Pair : Crossings)
+	{
+		const FCrossing& Crossing = Pair.Value;
+		if (IsInside(Crossing.From - Origin))
+		{
+			Graph->Exits[AddNode(Crossing.From)].Add(FVoxelNavChunkGraph::FExit{ Crossing.To, Crossing.Cost });
+		}
+		else
+		{
+			AddNode(Crossing.To);
+		}
+	}
+
+	// Portal to portal costs without leaving the chunk
+	TMap<FIntVector, float> Costs;
+	for (int32 From = 0; From < Graph->Nodes.Num(); ++From)
+	{
+		SearchChunk(Nav, Graph->Nodes[From], ChunkCoord, false, Costs);
+		for (int32 To = 0; To < Graph->Nodes.Num(); ++To)
+		{
+			if (To == From) continue;
+
+			if (const float* Cost = Costs.Find(Graph->Nodes[To]))
+			{
+				Graph->Edges[From].Add(FVoxelNavChunkGraph::FEdge{ To, *Cost });
+			}
+		}
+	}
+
+	return Graph;
+}
+
+void VoxelNavHierarchy::GetAffectedChunks(const FIntVector& Coord, const int32 ChunkSize, FIntVector& OutMinChunk, FIntVector& OutMaxChunk)
+{
+	// A voxel changes the links of voxels one step sideways, MaxStepUp + 1 below and MaxFallDistance + 1 above it.
+	// Those links land one more step sideways, up to MaxFallDistance lower or MaxStepUp higher.
+	constexpr int32 Below = PathfindingCosts::MaxStepUp + 1 + PathfindingCosts::MaxFallDistance;
+	constexpr int32 Above = PathfindingCosts::MaxFallDistance + 1 + PathfindingCosts::MaxStepUp;
+
+	OutMinChunk = AVoxelWorld::GetChunkCoord(Coord - FIntVector(2, 2, Below), ChunkSize);
+	OutMaxChunk = AVoxelWorld::GetChunkCoord(Coord + FIntVector(2, 2, Above), ChunkSize);
+}
+
+bool VoxelNavHierarchy::IsWorthwhile(const FPathSearchParams& Params, const int32 ChunkSize)
+{
+	const FIntVector Delta = AVoxelWorld::GetChunkCoord(Params.End, ChunkSize) - AVoxelWorld::GetChunkCoord(Params.Start, ChunkSize);
+	return FMath::Max3(FMath::Abs(Delta.X), FMath::Abs(Delta.Y), FMath::Abs(Delta.Z)) >= MinChunkDistance;
+}
+
+bool VoxelNavHierarchy::FindPath(const FVoxelNavQuery& Nav, FPathSearchContext& Search, const FPathSearchParams& Params, TArray<FVector>& OutPathPoints, FPathfindingStats& OutStats)
+{
+	OutPathPoints.Reset();
+	OutStats = FPathfindingStats();
+
+	const FIntVector StartCoord = Params.Start;
+	const FIntVector EndCoord = Params.End;
+	if (!Nav.IsWalkable(StartCoord) || !Nav.IsWalkable(EndCoord)) return false;
+
+	const double StartTime = FPlatformTime::Seconds();
+	const int32 ChunkSize = Nav.GetChunkSize();
+	const FIntVector StartChunk = AVoxelWorld::GetChunkCoord(StartCoord, ChunkSize);
+	const FIntVector EndChunk = AVoxelWorld::GetChunkCoord(EndCoord, ChunkSize);
+
+	// Graphs that haven't been published yet are built for this search and dropped with it
+	TMap<FIntVector, TSharedPtr<const FVoxelNavChunkGraph>> LocalGraphs;
+	auto GetGraph = [&](const FIntVector& ChunkCoord) -> const FVoxelNavChunkGraph&
+	{
+		if (const FVoxelNavChunkGraph* Published = Nav.FindGraph(ChunkCoord))
+		{
+			return *Published;
+		}
+
+		TSharedPtr<const FVoxelNavChunkGraph>& Local = LocalGraphs.FindOrAdd(ChunkCoord);
+		if (!Local.IsValid())
+		{
+			Local = BuildChunkGraph(Nav, ChunkCoord);
+		}
+		return *Local;
+	};
+
+	// The endpoints join the abstract graph through searches inside their own chunks
+	TMap<FIntVector, float> StartCosts;
+	TMap<FIntVector, float> EndCosts;
+	SearchChunk(Nav, StartCoord, StartChunk, false, StartCosts);
+	SearchChunk(Nav, EndCoord, EndChunk, true, EndCosts);
+
+	Search.Reset();
+
+	bool bAdded = false;
+	const int32 StartIndex = Search.FindOrAddNode(StartCoord, bAdded);
+	Search.Nodes[StartIndex].HCost = UPathfindingManager::Heuristic(StartCoord, EndCoord);
+	Search.OpenSet.Push(StartIndex);
+
+	TArray<FVoxelNavChunkGraph::FExit> Edges;
+	int32 EndIndex = INDEX_NONE;
+	while (!Search.OpenSet.IsEmpty())
+	{
+		if (Params.CancelFlag && Params.CancelFlag->load(std::memory_order_relaxed))
+		{
+			OutStats.bCancelled = true;
+			break;
+		}
+
+		const int32 CurrentIndex = Search.OpenSet.Pop();
+		Search.Nodes[CurrentIndex].bClosed = true;
+		OutStats.NodesExpanded++;
+
+		const FIntVector CurrentCoord = Search.Nodes[CurrentIndex].Coord;
+		const float CurrentGCost = Search.Nodes[CurrentIndex].GCost;
+		if (CurrentCoord == EndCoord)
+		{
+			EndIndex = CurrentIndex;
+			break;
+		}
+
+		const FIntVector CurrentChunk = AVoxelWorld::GetChunkCoord(CurrentCoord, ChunkSize);
+		const FVoxelNavChunkGraph& Graph = GetGraph(CurrentChunk);
+		const int32 NodeIndex = Graph.FindNode(CurrentCoord);
+
+		Edges.Reset();
+		if (CurrentIndex == StartIndex)
+		{
+			for (const FIntVector& Node : Graph.Nodes)
+			{
+				if (const float* Cost = StartCosts.Find(Node); Cost && Node != CurrentCoord)
+				{
+					Edges.Add(FVoxelNavChunkGraph::FExit{ Node, *Cost });
+				}
+			}
+		}
+		else if (NodeIndex != INDEX_NONE)
+		{
+			for (const FVoxelNavChunkGraph::FEdge& Edge : Graph.Edges[NodeIndex])
+			{
+				Edges.Add(FVoxelNavChunkGraph::FExit{ Graph.Nodes[Edge.To], Edge.Cost });
+			}
+		}
+
+		if (NodeIndex != INDEX_NONE)
+		{
+			Edges.Append(Graph.Exits[NodeIndex]);
+		}
+
+		if (CurrentChunk == EndChunk)
+		{
+			if (const float* Cost = EndCosts.Find(CurrentCoord))
+			{
+				Edges.Add(FVoxelNavChunkGraph::FExit{ EndCoord, *Cost });
+			}
+		}
+
+		for (const FVoxelNavChunkGraph::FExit& Edge : Edges)
+		{
+			const int32 NeighborIndex = Search.FindOrAddNode(Edge.To, bAdded);
+			FPathfindingNode& Node = Search.Nodes[NeighborIndex];
+			if (Node.bClosed) continue;
+
+			const float NewGCost = CurrentGCost + Edge.Cost;
+			if (!bAdded && NewGCost >= Node.GCost) continue;
+
+			Node.GCost = NewGCost;
+			Node.Parent = CurrentIndex;
+
+			if (bAdded)
+			{
+				Node.HCost = UPathfindingManager::Heuristic(Edge.To, EndCoord);
+				Search.OpenSet.Push(NeighborIndex);
+			}
+			else if (Search.OpenSet.Contains(NeighborIndex))
+			{
+				Search.OpenSet.DecreaseKey(NeighborIndex);
+			}
+		}
+	}
+
+	OutStats.NodesGenerated = Search.Nodes.Num();
+	if (EndIndex == INDEX_NONE)
+	{
+		OutStats.Seconds = FPlatformTime::Seconds() - StartTime;
+		return false;
+	}
+
+	TArray<FIntVector> Waypoints;
+	TArray<float> WaypointCosts;
+	for (int32 Index = EndIndex; Index != INDEX_NONE; Index = Search.Nodes[Index].Parent)
+	{
+		Waypoints.Add(Search.Nodes[Index].Coord);
+		WaypointCosts.Add(Search.Nodes[Index].GCost);
+	}
+	Algo::Reverse(Waypoints);
+	Algo::Reverse(WaypointCosts);
+
+	// Crossing links are single moves; every other leg stays within one chunk and is refined with A*
+	OutPathPoints.Add(FPathfindingNode(StartCoord).WorldPosition());
+
+	FPathSearchParams LegParams = Params;
+	LegParams.Mode = EPathSearchMode::AStar;
+	TArray<FVector> LegPoints;
+	FPathfindingStats LegStats;
+
+	for (int32 Index = 1; Index < Waypoints.Num(); ++Index)
+	{
+		const FIntVector& From = Waypoints[Index - 1];
+		const FIntVector& To = Waypoints[Index];
+
+		if (AVoxelWorld::GetChunkCoord(From, ChunkSize) != AVoxelWorld::GetChunkCoord(To, ChunkSize))
+		{
+			OutPathPoints.Add(FPathfindingNode(To).WorldPosition());
+			OutStats.PathCost += WaypointCosts[Index] - WaypointCosts[Index - 1];
+			continue;
+		}
+
+		LegParams.Start = From;
+		LegParams.End = To;
+		const bool bLegFound = UPathfindingManager::SearchPath(Nav, Search, LegParams, LegPoints, LegStats);
+
+		OutStats.NodesExpanded += LegStats.NodesExpanded;
+		OutStats.NodesGenerated += LegStats.NodesGenerated;
+		if (!bLegFound)
+		{
+			OutStats.bCancelled = LegStats.bCancelled;
+			OutStats.Seconds = FPlatformTime::Seconds() - StartTime;
+			OutPathPoints.Reset();
+			return false;
+		}
+
+		OutPathPoints.Append(LegPoints.GetData() + 1, LegPoints.Num() - 1);
+		OutStats.PathCost += LegStats.PathCost;
+	}
+
+	OutStats.Seconds = FPlatformTime::Seconds() - StartTime;
+	return true;
+}
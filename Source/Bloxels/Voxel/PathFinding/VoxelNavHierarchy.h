@@ -0,0 +1,66 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FVoxelNavQuery;
+struct FPathSearchContext;
+struct FPathSearchParams;
+struct FPathfindingStats;
+
+/**
+ * Abstract graph of one chunk for hierarchical search. Nodes are portal voxels, the in-chunk ends of the
+ * links that cross the chunk's faces. Edges hold the cheapest in-chunk cost between two portals, exits the
+ * crossing links themselves.
+ */
+struct FVoxelNavChunkGraph
+{
+	struct FEdge
+	{
+		int32 To = INDEX_NONE;
+		float Cost = 0.f;
+	};
+
+	struct FExit
+	{
+		FIntVector To;
+		float Cost = 0.f;
+	};
+
+	TArray<FIntVector> Nodes;
+	TArray<TArray<FEdge>> Edges;
+	TArray<TArray<FExit>> Exits;
+	TMap<FIntVector, int32> NodeLookup;
+
+	int32 FindNode(const FIntVector& Coord) const
+	{
+		const int32* Found = NodeLookup.Find(Coord);
+		return Found ? *Found : INDEX_NONE;
+	}
+};
+
+using FVoxelNavGraphMap = TMap<FIntVector, TSharedPtr<const FVoxelNavChunkGraph>>;
+
+namespace VoxelNavHierarchy
+{
+	// Crossing links are grouped into windows this many voxels wide; each window keeps its cheapest link as the portal
+	constexpr int32 PortalSpacing = 8;
+
+	// Endpoints closer than this many chunks apart skip the abstract graph
+	constexpr int32 MinChunkDistance = 2;
+
+	// Safe on any thread
+	TSharedRef<FVoxelNavChunkGraph> BuildChunkGraph(const FVoxelNavQuery& Nav, const FIntVector& ChunkCoord);
+
+	// Range of chunks whose graphs can change when the voxel at Coord does
+	void GetAffectedChunks(const FIntVector& Coord, int32 ChunkSize, FIntVector& OutMinChunk, FIntVector& OutMaxChunk);
+
+	bool IsWorthwhile(const FPathSearchParams& Params, int32 ChunkSize);
+
+	/**
+	 * Plans over the portal graphs, then refines each leg inside its chunk with A*. Chunks without a published
+	 * graph get one built for this search only. Returns false when the abstract search finds no route.
+	 */
+	bool FindPath(const FVoxelNavQuery& Nav, FPathSearchContext& Search, const FPathSearchParams& Params, TArray<FVector>& OutPathPoints, FPathfindingStats& OutStats);
+}
@@ -0,0 +1,423 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#include "VoxelStructureFile.h"
+
+#include "Dom/JsonObject.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+
+namespace
+{
+    constexpr int32 MaxStructureExtent = 4096;
+
+    FIntVector GetBlockCounts(const FIntVector& Size, int32 BlockSize)
+    {
+        return FIntVector(
+            FMath::DivideAndRoundUp(Size.X, BlockSize),
+            FMath::DivideAndRoundUp(Size.Y, BlockSize),
+            FMath::DivideAndRoundUp(Size.Z, BlockSize));
+    }
+
+    void GetBlockBounds(int32 BlockIndex, const FIntVector& BlockCounts, int32 BlockSize, const FIntVector& Size,
+        FIntVector& OutLocalMin, FIntVector& OutBlockSize)
+    {
+        const int32 BX = BlockIndex % BlockCounts.X;
+        const int32 BY = (BlockIndex / BlockCounts.X) % BlockCounts.Y;
+        const int32 BZ = BlockIndex / (BlockCounts.X * BlockCounts.Y);
+
+        OutLocalMin = FIntVector(BX * BlockSize, BY * BlockSize, BZ * BlockSize);
+        OutBlockSize = FIntVector(
+            FMath::Min(BlockSize, Size.X - OutLocalMin.X),
+            FMath::Min(BlockSize, Size.Y - OutLocalMin.Y),
+            FMath::Min(BlockSize, Size.Z - OutLocalMin.Z));
+    }
+}
+
+FVoxelStructureReader::~FVoxelStructureReader()
+{
+    Close();
+}
+
+bool FVoxelStructureReader::Open(const FString& Path)
+{
+    Close();
+    bError = false;
+
+    Reader.Reset(IFileManager::Get().CreateFileReader(*Path));
+    if (!Reader)
+    {
+        UE_LOG(LogTemp, Error, TEXT("VoxelStructureReader: Could not open %s"), *Path);
+        return false;
+    }
+
+    FArchive& Ar = *Reader;
+    uint32 FileMagic = 0;
+    uint16 Version = 0;
+    uint16 FileBlockSize = 0;
+    Ar << FileMagic;
+
+    if (FileMagic != VoxelStructureFile::Magic)
+    {
+        Close();
+        return false;
+    }
+
+    Ar << Version << FileBlockSize << Min << Size << NonEmptyCount;
+    if (Ar.IsError() || Version == 0 || Version > VoxelStructureFile::CurrentVersion)
+    {
+        UE_LOG(LogTemp, Error, TEXT("VoxelStructureReader: Unsupported version %d in %s"), Version, *Path);
+        bError = true;
+        Close();
+        return false;
+    }
+
+    if (FileBlockSize == 0 ||
+        Size.X <= 0 || Size.Y <= 0 || Size.Z <= 0 ||
+        Size.X > MaxStructureExtent || Size.Y > MaxStructureExtent || Size.Z > MaxStructureExtent)
+    {
+        UE_LOG(LogTemp, Error, TEXT("VoxelStructureReader: Invalid bounds %s in %s"), *Size.ToString(), *Path);
+        bError = true;
+        Close();
+        return false;
+    }
+
+    uint16 PaletteCount = 0;
+    Ar << PaletteCount;
+
+    Palette.Reset(PaletteCount + 1);
+    Palette.Add(NAME_None);
+    for (int32 i = 0; i < PaletteCount && !Ar.IsError(); ++i)
+    {
+        FString Name;
+        Ar << Name;
+        Palette.Add(FName(*Name));
+    }
+
+    uint32 FileBlockCount = 0;
+    Ar << FileBlockCount;
+
+    BlockSize = FileBlockSize;
+    BlockCounts = GetBlockCounts(Size, BlockSize);
+    NumBlocks = BlockCounts.X * BlockCounts.Y * BlockCounts.Z;
+    NextBlock = 0;
+
+    if (Ar.IsError() || static_cast<int32>(FileBlockCount) != NumBlocks)
+    {
+        UE_LOG(LogTemp, Error, TEXT("VoxelStructureReader: Corrupt header in %s"), *Path);
+        bError = true;
+        Close();
+        return false;
+    }
+
+    return true;
+}
+
+void FVoxelStructureReader::Close()
+{
+    if (Reader)
+    {
+        Reader->Close();
+        Reader.Reset();
+    }
+}
+
+bool FVoxelStructureReader::ReadNextBlock(FVoxelStructureBlock& OutBlock)
+{
+    if (!Reader || bError || NextBlock >= NumBlocks) return false;
+
+    FIntVector LocalMin;
+    GetBlockBounds(NextBlock++, BlockCounts, BlockSize, Size, LocalMin, OutBlock.Size);
+    OutBlock.Min = Min + LocalMin;
+    OutBlock.NonEmptyCount = 0;
+
+    const int32 CellCount = OutBlock.Size.X * OutBlock.Size.Y * OutBlock.Size.Z;
+
+    uint32 PayloadBytes = 0;
+    *Reader << PayloadBytes;
+
+    if (PayloadBytes == 0)
+    {
+        OutBlock.Cells.Reset();
+        return !Reader->IsError();
+    }
+
+    // A run is 4 bytes and covers at least one cell, so anything larger is corrupt
+    if (PayloadBytes % 4 != 0 || PayloadBytes > static_cast<uint32>(CellCount) * 4)
+    {
+        UE_LOG(LogTemp, Error, TEXT("VoxelStructureReader: Corrupt block payload (%u bytes)"), PayloadBytes);
+        bError = true;
+        return false;
+    }
+
+    PayloadBuffer.SetNumUninitialized(PayloadBytes, EAllowShrinking::No);
+    Reader->Serialize(PayloadBuffer.GetData(), PayloadBytes);
+    if (Reader->IsError())
+    {
+        bError = true;
+        return false;
+    }
+
+    OutBlock.Cells.Init(0, CellCount);
+
+    FMemoryReader Payload(PayloadBuffer);
+    int32 Cursor = 0;
+    while (Payload.Tell() < PayloadBytes)
+    {
+        uint16 PaletteIndex = 0;
+        uint16 Length = 0;
+        Payload << PaletteIndex << Length;
+
+        if (PaletteIndex >= Palette.Num() || Cursor + Length > CellCount)
+        {
+            UE_LOG(LogTemp, Error, TEXT("VoxelStructureReader: Corrupt run (palette %d, length %d)"), PaletteIndex, Length);
+            bError = true;
+            return false;
+        }
+
+        if (PaletteIndex != 0)
+        {
+            for (int32 i = 0; i < Length; ++i)
+            {
+                OutBlock.Cells[Cursor + i] = PaletteIndex;
+            }
+            OutBlock.NonEmptyCount += Length;
+        }
+        Cursor += Length;
+    }
+
+    return true;
+}
+
+namespace VoxelStructureFile
+{
+    bool IsBinaryFile(const FString& Path)
+    {
+        TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*Path));
+        if (!Reader || Reader->TotalSize() < static_cast<int64>(sizeof(uint32))) return false;
+
+        uint32 FileMagic = 0;
+        *Reader << FileMagic;
+        return FileMagic == Magic;
+    }
+
+    bool Save(const FString& Path, const FVoxelStructure& Structure)
+    {
+        if (Structure.GetNumCells() <= 0 || Structure.Cells.Num() != Structure.GetNumCells() || Structure.Palette.Num() > MAX_uint16)
+        {
+            UE_LOG(LogTemp, Error, TEXT("VoxelStructureFile: Refusing to save malformed structure to %s"), *Path);
+            return false;
+        }
+
+        TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*Path));
+        if (!Writer)
+        {
+            UE_LOG(LogTemp, Error, TEXT("VoxelStructureFile: Could not open %s for writing"), *Path);
+            return false;
+        }
+
+        FArchive& Ar = *Writer;
+
+        uint32 FileMagic = Magic;
+        uint16 Version = CurrentVersion;
+        uint16 BlockSize = DefaultBlockSize;
+        FIntVector Min = Structure.Min;
+        FIntVector Size = Structure.Size;
+        int32 NonEmptyCount = 0;
+        for (const uint16 Cell : Structure.Cells)
+        {
+            NonEmptyCount += Cell != 0 ? 1 : 0;
+        }
+
+        Ar << FileMagic << Version << BlockSize << Min << Size << NonEmptyCount;
+
+        // Palette entry 0 is the implicit empty cell and is not written
+        uint16 PaletteCount = static_cast<uint16>(FMath::Max(0, Structure.Palette.Num() - 1));
+        Ar << PaletteCount;
+        for (int32 i = 1; i < Structure.Palette.Num(); ++i)
+        {
+            FString Name = Structure.Palette[i].ToString();
+            Ar << Name;
+        }
+
+        const FIntVector BlockCounts = GetBlockCounts(Size, BlockSize);
+        uint32 BlockCount = BlockCounts.X * BlockCounts.Y * BlockCounts.Z;
+        Ar << BlockCount;
+
+        TArray<uint8> Payload;
+        for (uint32 BlockIndex = 0; BlockIndex < BlockCount; ++BlockIndex)
+        {
+            FIntVector LocalMin, LocalSize;
+            GetBlockBounds(BlockIndex, BlockCounts, BlockSize, Size, LocalMin, LocalSize);
+
+            Payload.Reset();
+            FMemoryWriter PayloadWriter(Payload);
+
+            bool bAnySolid = false;
+            uint16 RunIndex = 0;
+            uint16 RunLength = 0;
+
+            for (int32 Z = 0; Z < LocalSize.Z; ++Z)
+            {
+                for (int32 Y = 0; Y < LocalSize.Y; ++Y)
+                {
+                    for (int32 X = 0; X < LocalSize.X; ++X)
+                    {
+                        const uint16 Cell = Structure.Cells[Structure.GetIndex(LocalMin.X + X, LocalMin.Y + Y, LocalMin.Z + Z)];
+                        bAnySolid |= Cell != 0;
+
+                        if (RunLength > 0 && (Cell != RunIndex || RunLength == MAX_uint16))
+                        {
+                            PayloadWriter << RunIndex << RunLength;
+                            RunLength = 0;
+                        }
+                        RunIndex = Cell;
+                        ++RunLength;
+                    }
+                }
+            }
+
+            if (RunLength > 0)
+            {
+                PayloadWriter << RunIndex << RunLength;
+            }
+
+            uint32 PayloadBytes = bAnySolid ? Payload.Num() : 0;
+            Ar << PayloadBytes;
+            if (PayloadBytes > 0)
+            {
+                Ar.Serialize(Payload.GetData(), PayloadBytes);
+            }
+        }
+
+        const bool bSucceeded = !Ar.IsError();
+        Writer->Close();
+        return bSucceeded;
+    }
+
+    bool Load(const FString& Path, FVoxelStructure& OutStructure)
+    {
+        if (!IsBinaryFile(Path))
+        {
+            return LoadLegacyJson(Path, OutStructure);
+        }
+
+        FVoxelStructureReader Reader;
+        if (!Reader.Open(Path)) return false;
+
+        OutStructure.Min = Reader.GetMin();
+        OutStructure.Size = Reader.GetSize();
+        OutStructure.Palette = Reader.GetPalette();
+        OutStructure.Cells.Init(0, OutStructure.GetNumCells());
+
+        FVoxelStructureBlock Block;
+        while (Reader.ReadNextBlock(Block))
+        {
+            if (Block.NonEmptyCount == 0) continue;
+
+            const FIntVector LocalMin = Block.Min - OutStructure.Min;
+            for (int32 Z = 0; Z < Block.Size.Z; ++Z)
+            {
+                for (int32 Y = 0; Y < Block.Size.Y; ++Y)
+                {
+                    for (int32 X = 0; X < Block.Size.X; ++X)
+                    {
+                        OutStructure.Cells[OutStructure.GetIndex(LocalMin.X + X, LocalMin.Y + Y, LocalMin.Z + Z)] =
+                            Block.Cells[(Z * Block.Size.Y * Block.Size.X) + (Y * Block.Size.X) + X];
+                    }
+                }
+            }
+        }
+
+        return !Reader.HasError();
+    }
+
+    bool LoadLegacyJson(const FString& Path, FVoxelStructure& OutStructure)
+    {
+        FString Input;
+        if (!FFileHelper::LoadFileToString(Input, *Path))
+        {
+            UE_LOG(LogTemp, Error, TEXT("VoxelStructureFile: Failed to load %s"), *Path);
+            return false;
+        }
+
+        TSharedPtr<FJsonObject> Root;
+        const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(Input);
+        if (!FJsonSerializer::Deserialize(Reader, Root) || !Root.IsValid())
+        {
+            UE_LOG(LogTemp, Error, TEXT("VoxelStructureFile: Failed to deserialize JSON structure %s"), *Path);
+            return false;
+        }
+
+        const TArray<TSharedPtr<FJsonValue>>* Voxels = nullptr;
+        if (!Root->TryGetArrayField(TEXT("Voxels"), Voxels) || !Voxels)
+        {
+            UE_LOG(LogTemp, Error, TEXT("VoxelStructureFile: %s has no Voxels array"), *Path);
+            return false;
+        }
+
+        // First pass resolves bounds and the palette, second pass fills the grid
+        TArray<TPair<FIntVector, uint16>> Entries;
+        Entries.Reserve(Voxels->Num());
+
+        TMap<FString, uint16> PaletteLookup;
+        OutStructure.Palette.Reset();
+        OutStructure.Palette.Add(NAME_None);
+
+        FIntVector Min(MAX_int32);
+        FIntVector Max(MIN_int32);
+
+        for (const TSharedPtr<FJsonValue>& VoxelVal : *Voxels)
+        {
+            const TSharedPtr<FJsonObject> VoxelObj = VoxelVal.IsValid() ? VoxelVal->AsObject() : nullptr;
+            const TArray<TSharedPtr<FJsonValue>>* OffsetArr = nullptr;
+            FString ID;
+
+            if (!VoxelObj || !VoxelObj->TryGetArrayField(TEXT("Offset"), OffsetArr) || OffsetArr->Num() != 3 ||
+                !VoxelObj->TryGetStringField(TEXT("ID"), ID))
+            {
+                UE_LOG(LogTemp, Warning, TEXT("VoxelStructureFile: Skipping malformed voxel entry."));
+                continue;
+            }
+
+            const FIntVector Offset(
+                static_cast<int32>((*OffsetArr)[0]->AsNumber()),
+                static_cast<int32>((*OffsetArr)[1]->AsNumber()),
+                static_cast<int32>((*OffsetArr)[2]->AsNumber()));
+
+            uint16* PaletteIndex = PaletteLookup.Find(ID);
+            if (!PaletteIndex)
+            {
+                PaletteIndex = &PaletteLookup.Add(ID, static_cast<uint16>(OutStructure.Palette.Num()));
+                OutStructure.Palette.Add(FName(*ID));
+            }
+
+            Entries.Emplace(Offset, *PaletteIndex);
+            Min = FIntVector(FMath::Min(Min.X, Offset.X), FMath::Min(Min.Y, Offset.Y), FMath::Min(Min.Z, Offset.Z));
+            Max = FIntVector(FMath::Max(Max.X, Offset.X), FMath::Max(Max.Y, Offset.Y), FMath::Max(Max.Z, Offset.Z));
+        }
+
+        if (Entries.Num() == 0)
+        {
+            OutStructure.Min = FIntVector::ZeroValue;
+            OutStructure.Size = FIntVector::ZeroValue;
+            OutStructure.Cells.Reset();
+            return true;
+        }
+
+        OutStructure.Min = Min;
+        OutStructure.Size = Max - Min + FIntVector(1);
+        OutStructure.Cells.Init(0, OutStructure.GetNumCells());
+
+        for (const TPair<FIntVector, uint16>& Entry : Entries)
+        {
+            const FIntVector Local = Entry.Key - Min;
+            OutStructure.Cells[OutStructure.GetIndex(Local.X, Local.Y, Local.Z)] = Entry.Value;
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,88 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * In-memory structure: a dense grid of palette indices positioned relative to the structure origin.
+ * Palette index 0 is always the empty cell (leave the world untouched).
+ */
+struct FVoxelStructure
+{
+    FIntVector Min = FIntVector::ZeroValue;  // Offset of the first grid cell from the structure origin
+    FIntVector Size = FIntVector::ZeroValue;
+    TArray<FName> Palette;
+    TArray<uint16> Cells;                    // X fastest, then Y, then Z
+
+    int32 GetIndex(int X, int Y, int Z) const { return (Z * Size.Y * Size.X) + (Y * Size.X) + X; }
+    int32 GetNumCells() const { return Size.X * Size.Y * Size.Z; }
+    bool IsEmpty() const { return Cells.Num() == 0; }
+};
+
+/** A cubic slice of a structure, produced one at a time while streaming a .blxl file. */
+struct FVoxelStructureBlock
+{
+    FIntVector Min = FIntVector::ZeroValue;  // Offset from the structure origin
+    FIntVector Size = FIntVector::ZeroValue;
+    TArray<uint16> Cells;                    // Palette indices, X fastest
+    int32 NonEmptyCount = 0;
+};
+
+/**
+ * Binary .blxl layout (version 1, little endian):
+ *   uint32 Magic 'BLXL', uint16 Version, uint16 BlockSize
+ *   FIntVector Min, FIntVector Size, int32 NonEmptyCount
+ *   uint16 PaletteCount, FString Palette[PaletteCount]   (index 0 is implicit and empty)
+ *   uint32 BlockCount, then per block: uint32 PayloadBytes, RLE runs of (uint16 PaletteIndex, uint16 Length)
+ * Blocks are BlockSize^3 cells clipped to the structure bounds, ordered X fastest.
+ */
+class BLOXELS_API FVoxelStructureReader
+{
+public:
+    ~FVoxelStructureReader();
+
+    /** Opens a file and reads its header and palette. Returns false for missing, legacy or malformed files. */
+    bool Open(const FString& Path);
+    void Close();
+
+    /** Decodes the next block. Returns false once every block has been read or the payload is corrupt. */
+    bool ReadNextBlock(FVoxelStructureBlock& OutBlock);
+
+    const TArray<FName>& GetPalette() const { return Palette; }
+    FIntVector GetMin() const { return Min; }
+    FIntVector GetSize() const { return Size; }
+    int32 GetNonEmptyCount() const { return NonEmptyCount; }
+    bool HasError() const { return bError; }
+
+private:
+    TUniquePtr<FArchive> Reader;
+    TArray<FName> Palette;
+    TArray<uint8> PayloadBuffer;
+    FIntVector Min = FIntVector::ZeroValue;
+    FIntVector Size = FIntVector::ZeroValue;
+    FIntVector BlockCounts = FIntVector::ZeroValue;
+    int32 BlockSize = 0;
+    int32 NonEmptyCount = 0;
+    int32 NextBlock = 0;
+    int32 NumBlocks = 0;
+    bool bError = false;
+};
+
+namespace VoxelStructureFile
+{
+    constexpr uint32 Magic = 0x4C584C42; // "BLXL"
+    constexpr uint16 CurrentVersion = 1;
+    constexpr uint16 DefaultBlockSize = 16;
+
+    /** Returns true when the file starts with the binary magic. Anything else is treated as legacy JSON. */
+    bool IsBinaryFile(const FString& Path);
+
+    bool Save(const FString& Path, const FVoxelStructure& Structure);
+
+    /** Loads a whole structure into memory, from either the binary format or legacy JSON. */
+    bool Load(const FString& Path, FVoxelStructure& OutStructure);
+
+    /** Legacy { "Voxels": [ { "Offset": [x,y,z], "ID": "Name" } ] } documents. */
+    bool LoadLegacyJson(const FString& Path, FVoxelStructure& OutStructure);
+}
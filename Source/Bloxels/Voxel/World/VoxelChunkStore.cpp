@@ -0,0 +1,66 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#include "VoxelChunkStore.h"
+
+int32 FVoxelChunkStore::GetShardIndex(const FChunkKey& Key)
+{
+	// Top bits, since each shard's map buckets on the low ones
+	return static_cast<int32>(GetTypeHash(Key) >> 27) % NumShards;
+}
+
+TSharedPtr<FVoxelChunkRecord> FVoxelChunkStore::Find(const FIntVector& ChunkCoords) const
+{
+	const FChunkKey Key(ChunkCoords);
+	const FShard& Shard = Shards[GetShardIndex(Key)];
+
+	FReadScopeLock ReadLock(Shard.Lock);
+	const TSharedRef<FVoxelChunkRecord>* Record = Shard.Records.Find(Key);
+	return Record ? TSharedPtr<FVoxelChunkRecord>(*Record) : nullptr;
+}
+
+bool FVoxelChunkStore::Contains(const FIntVector& ChunkCoords) const
+{
+	const FChunkKey Key(ChunkCoords);
+	const FShard& Shard = Shards[GetShardIndex(Key)];
+
+	FReadScopeLock ReadLock(Shard.Lock);
+	return Shard.Records.Contains(Key);
+}
+
+int32 FVoxelChunkStore::Num() const
+{
+	int32 Count = 0;
+	for (const FShard& Shard : Shards)
+	{
+		FReadScopeLock ReadLock(Shard.Lock);
+		Count += Shard.Records.Num();
+	}
+	return Count;
+}
+
+void FVoxelChunkStore::Add(TSharedRef<FVoxelChunkRecord> Record)
+{
+	const FChunkKey Key(Record->ChunkCoords);
+	FShard& Shard = Shards[GetShardIndex(Key)];
+
+	FWriteScopeLock WriteLock(Shard.Lock);
+	Shard.Records.Add(Key, MoveTemp(Record));
+}
+
+void FVoxelChunkStore::Remove(const FIntVector& ChunkCoords)
+{
+	const FChunkKey Key(ChunkCoords);
+	FShard& Shard = Shards[GetShardIndex(Key)];
+
+	FWriteScopeLock WriteLock(Shard.Lock);
+	Shard.Records.Remove(Key);
+}
+
+void FVoxelChunkStore::Reset()
+{
+	for (FShard& Shard : Shards)
+	{
+		FWriteScopeLock WriteLock(Shard.Lock);
+		Shard.Records.Reset();
+	}
+}
@@ -0,0 +1,50 @@
+// Copyright 2025 Bloxels. All rights reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Bloxels/Voxel/Chunk/VoxelChunkData.h"
+#include "Bloxels/Voxel/Core/ChunkKey.h"
+
+// What the store keeps per chunk. Outlives the actor for as long as a reader holds it; the actor itself is only
+// reachable on the game thread, through AVoxelWorld::FindChunk.
+struct FVoxelChunkRecord
+{
+	FIntVector ChunkCoords;
+	TSharedRef<FVoxelChunkDataSlot> Data;  // Published voxels and light, readable from any thread
+
+	FVoxelChunkRecord(const FIntVector& InChunkCoords, TSharedRef<FVoxelChunkDataSlot> InData)
+		: ChunkCoords(InChunkCoords), Data(MoveTemp(InData))
+	{
+	}
+};
+
+/**
+ * Every chunk the world knows about, keyed on FChunkKey. Split into shards with a lock each, so
+ * workers looking up different chunks rarely meet on a lock and never wait behind the game thread for long.
+ * Written on the game thread only; Find and Contains are safe anywhere.
+ */
+class BLOXELS_API FVoxelChunkStore
+{
+public:
+	TSharedPtr<FVoxelChunkRecord> Find(const FIntVector& ChunkCoords) const;
+	bool Contains(const FIntVector& ChunkCoords) const;
+	int32 Num() const;
+
+	void Add(TSharedRef<FVoxelChunkRecord> Record);
+	void Remove(const FIntVector& ChunkCoords);
+	void Reset();
+
+private:
+	static constexpr int32 NumShards = 32;
+
+	struct alignas(PLATFORM_CACHE_LINE_SIZE) FShard
+	{
+		mutable FRWLock Lock;
+		TMap<FChunkKey, TSharedRef<FVoxelChunkRecord>> Records;
+	};
+
+	FShard Shards[NumShards];
+
+	static int32 GetShardIndex(const FChunkKey& Key);
+};
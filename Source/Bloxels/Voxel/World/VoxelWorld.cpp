@@ -5,9 +5,15 @@
 #include "WorldGenerationConfig.h"
 #include "WorldGenerationSubsystem.h"
 #include "Bloxels/Voxel/Chunk/VoxelChunk.h"
+#include "Bloxels/Voxel/Chunk/VoxelJobScheduler.h"
+#include "Bloxels/Voxel/Core/VoxelStats.h"
+#include "Bloxels/Voxel/Lighting/VoxelLightEngine.h"
+#include "Bloxels/Voxel/PathFinding/VoxelNavGrid.h"
 #include "Bloxels/Voxel/VoxelRegistry/VoxelRegistrySubsystem.h"
+#include "Async/TaskGraphInterfaces.h"
 #include "Components/BrushComponent.h"
 #include "Kismet/GameplayStatics.h"
+#include "Misc/FileHelper.h"
 
 AVoxelWorld::AVoxelWorld(): VoxelWorldConfig(nullptr),
                             TemperatureNoise(nullptr),
@@ -28,9 +34,18 @@ void AVoxelWorld::BeginPlay()
         return;
     }
 
+    // -Seed= reseeds a copy of the config, for reproducible benchmark worlds
+    int32 Seed = 0;
+    if (FParse::Value(FCommandLine::Get(), TEXT("Seed="), Seed))
+    {
+        VoxelWorldConfig = VoxelWorldConfig->CopyWithSeed(Seed, this);
+        UE_LOG(LogTemp, Log, TEXT("VoxelWorld: noise seeds from %d"), Seed);
+    }
+
     if (UWorldGenerationSubsystem* WorldGenSubsystem = GetGameInstance()->GetSubsystem<UWorldGenerationSubsystem>())
     {
         WorldGenSubsystem->InitializeConfig(VoxelWorldConfig);
+        StructurePlacedHandle = WorldGenSubsystem->OnStructurePlaced.AddUObject(this, &AVoxelWorld::OnStructurePlaced);
     }
 
     FTimerHandle DelayWorldGenTimer;
@@ -40,6 +55,36 @@ void AVoxelWorld::BeginPlay()
     InitializeTriggerVolume();
 }
 
+void AVoxelWorld::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+    if (JobScheduler)
+    {
+        JobScheduler->Shutdown();
+    }
+    PendingChunkRequests.Reset();
+    DeferredRemeshes.Reset();
+    ChunkStore.Reset();
+
+    if (UWorldGenerationSubsystem* WorldGenSubsystem = GetWorldGenerationSubsystem())
+    {
+        WorldGenSubsystem->OnStructurePlaced.Remove(StructurePlacedHandle);
+    }
+
+    Super::EndPlay(EndPlayReason);
+}
+
+void AVoxelWorld::Tick(const float DeltaTime)
+{
+    Super::Tick(DeltaTime);
+
+    if (JobScheduler)
+    {
+        JobScheduler->SetFocus(CurrentChunk);
+    }
+    SpawnDeferredRemeshes();
+    SpawnPendingChunks();
+}
+
 void AVoxelWorld::DelayedGenerateWorld()
 {
     // Ensure voxel registry is ready
@@ -52,6 +97,27 @@ void AVoxelWorld::DelayedGenerateWorld()
         return;
     }
 
+    if (!LightEngine)
+    {
+        LightEngine = MakeShared<FVoxelLightEngine>();
+        LightEngine->Initialize(this, Registry);
+    }
+
+    if (!NavGrid)
+    {
+        NavGrid = MakeShared<FVoxelNavGrid>();
+        NavGrid->Initialize(VoxelWorldConfig->ChunkSize, Registry);
+    }
+
+    if (!JobScheduler)
+    {
+        const int32 MaxInFlight = VoxelWorldConfig->MaxVoxelJobsInFlight > 0
+            ? VoxelWorldConfig->MaxVoxelJobsInFlight
+            : FMath::Max(1, static_cast<int32>(FTaskGraphInterface::Get().GetNumWorkerThreads()) / 2);
+        JobScheduler = MakeShared<FVoxelJobScheduler>();
+        JobScheduler->Initialize(MaxInFlight, VoxelWorldConfig->MaxQueuedVoxelJobs);
+    }
+
     //UE_LOG(LogTemp, Warning, TEXT("VoxelRegistry ready. Generating initial world."));
     GenerateInitialWorld();
 }
@@ -61,6 +127,9 @@ void AVoxelWorld::GenerateInitialWorld()
     //UE_LOG(LogTemp, Error, TEXT("GENERATE INITIAL WORLD"));
     CurrentChunk = FIntVector(0, 0, 10);
     UE_LOG(LogTemp, Error, TEXT("CURRENT CHUNK: %d, %d, %d"), CurrentChunk.X, CurrentChunk.Y, CurrentChunk.Z);
+
+    // The new view replaces whatever the last one still had waiting
+    PendingChunkRequests.Reset();
     for (int X = CurrentChunk.X - WorldSize; X <= CurrentChunk.X + WorldSize; X++)
     {
         for (int Y = CurrentChunk.Y - WorldSize; Y <= CurrentChunk.Y + WorldSize; Y++)
@@ -68,10 +137,56 @@ void AVoxelWorld::GenerateInitialWorld()
             for (int Z = CurrentChunk.Z - WorldSize; Z <= CurrentChunk.Z + WorldSize; Z++)
             {
                 //UE_LOG(LogTemp, Warning, TEXT("Creating chunk at: %d %d %d"), X, Y, Z);
-                TryCreateNewChunk(X, Y, Z, true);
+                PendingChunkRequests.Add(FIntVector(X, Y, Z));
             }
         }
     }
+    if (JobScheduler)
+    {
+        JobScheduler->SetFocus(CurrentChunk);
+    }
+    SpawnPendingChunks();
+}
+
+void AVoxelWorld::SpawnPendingChunks()
+{
+    if (PendingChunkRequests.Num() == 0 || (JobScheduler && JobScheduler->IsSaturated())) return;
+
+    // Nearest first, until the job queue pushes back; sorted once per call instead of searched per chunk
+    TArray<TPair<int64, FIntVector>> Ordered;
+    Ordered.Reserve(PendingChunkRequests.Num());
+    for (const FChunkKey& Key : PendingChunkRequests)
+    {
+        const FIntVector Coord = Key.ToCoords();
+        const FIntVector Delta = Coord - CurrentChunk;
+        Ordered.Emplace(static_cast<int64>(Delta.X) * Delta.X + static_cast<int64>(Delta.Y) * Delta.Y + static_cast<int64>(Delta.Z) * Delta.Z, Coord);
+    }
+    Ordered.Sort([](const TPair<int64, FIntVector>& A, const TPair<int64, FIntVector>& B) { return A.Key < B.Key; });
+
+    for (const TPair<int64, FIntVector>& Entry : Ordered)
+    {
+        if (JobScheduler && JobScheduler->IsSaturated()) break;
+
+        const FIntVector& Coord = Entry.Value;
+        PendingChunkRequests.Remove(Coord);
+        TryCreateNewChunk(Coord.X, Coord.Y, Coord.Z, true);
+    }
+}
+
+void AVoxelWorld::SpawnDeferredRemeshes()
+{
+    if (DeferredRemeshes.Num() == 0) return;
+
+    // A chunk that still finds the lane full defers itself again
+    const TSet<FChunkKey> Deferred = MoveTemp(DeferredRemeshes);
+    DeferredRemeshes.Reset();
+    for (const FChunkKey& Key : Deferred)
+    {
+        if (AVoxelChunk* Chunk = FindChunk(Key.ToCoords()))
+        {
+            Chunk->RequestMesh();
+        }
+    }
 }
 
 void AVoxelWorld::InitializePlayer()
@@ -134,13 +249,7 @@ void AVoxelWorld::TryCreateNewChunk(int32 ChunkX, int32 ChunkY, int32 ChunkZ, bo
             AVoxelChunk* Chunk = *Chunks.Find(ChunkCoords);
             if (Chunk && bShouldGenMesh)
             {
-                Chunk->bGenerateMesh = true;
-
-                if (Chunk->bHasData)
-                {
-                    // Call Generate chunk Mesh Async
-                    Chunk->TryGenerateChunkMesh();
-                }
+                Chunk->RequestMesh();
             }
         }
         else
@@ -172,9 +281,8 @@ void AVoxelWorld::TryCreateNewChunk(int32 ChunkX, int32 ChunkY, int32 ChunkZ, bo
             #endif
                         NewChunk->InitializeChunk(this, ChunkX, ChunkY, ChunkZ, bShouldGenMesh);
 
-            ChunksLock.WriteLock();
-            Chunks.Add(FIntVector(ChunkX, ChunkY, ChunkZ), NewChunk);
-            ChunksLock.WriteUnlock();
+            Chunks.Add(ChunkCoords, NewChunk);
+            ChunkStore.Add(MakeShared<FVoxelChunkRecord>(ChunkCoords, NewChunk->GetDataSlot()));
 
             //UE_LOG(LogTemp, Warning, TEXT("Chunk (%d, %d) spawned and added to Chunks"), ChunkX, ChunkY);
         }
@@ -212,6 +320,9 @@ void AVoxelWorld::OnChunkExit(AActor* OverlappedActor, AActor* OtherActor)
 
 void AVoxelWorld::UpdateChunks()  
 {  
+    SCOPE_CYCLE_COUNTER(STAT_BloxelsUpdateChunks);
+    TRACE_CPUPROFILER_EVENT_SCOPE(AVoxelWorld::UpdateChunks);
+
     UE_LOG(LogTemp, Warning, TEXT("UPDATE CHUNKS"));
 
     TArray<AVoxelChunk*> ChunksToUnload;
@@ -236,81 +347,351 @@ void AVoxelWorld::UpdateChunks()
 }
 
 int AVoxelWorld::PlaceBlock(const int X, const int Y, const int Z, const int BlockToPlace)
+{
+    uint16 OriginalBlock = 0;
+
+    BeginEditBatch();
+    const bool bPlaced = SetVoxel(FIntVector(X, Y, Z), static_cast<uint16>(BlockToPlace), &OriginalBlock);
+    CommitEditBatch();
+
+    if (!bPlaced)
+    {
+        const FIntVector ChunkCoord = GetChunkCoord(FIntVector(X, Y, Z), VoxelWorldConfig->ChunkSize);
+        UE_LOG(LogTemp, Warning, TEXT("Chunk (%d, %d) not found for voxel placement at (%d, %d, %d)!"), ChunkCoord.X, ChunkCoord.Y, X, Y, Z);
+        return GetVoxelRegistry()->GetIDFromName("Air");
+    }
+    return OriginalBlock;
+}
+
+void AVoxelWorld::BeginEditBatch()
+{
+    EditBatchDepth++;
+}
+
+bool AVoxelWorld::SetVoxel(const FIntVector& Coord, const uint16 VoxelID, uint16* OutOriginal)
 {
     const int ChunkSize = VoxelWorldConfig->ChunkSize;
-    
-	// Find the chunk that contains this voxel
-	const int ChunkX = FMath::FloorToInt(static_cast<float>(X) / (ChunkSize));
-	const int ChunkY = FMath::FloorToInt(static_cast<float>(Y) / (ChunkSize));
-	const int ChunkZ = FMath::FloorToInt(static_cast<float>(Z) / (ChunkSize));
-    
-	const int LocalX = (X % ChunkSize + ChunkSize) % ChunkSize;
-	const int LocalY = (Y % ChunkSize + ChunkSize) % ChunkSize;
-	const int LocalZ = (Z % ChunkSize + ChunkSize) % ChunkSize;
-    
-    if (const FIntVector ChunkCoord(ChunkX, ChunkY, ChunkZ); Chunks.Contains(ChunkCoord))
-	{
-        if (AVoxelChunk* Chunk = Chunks[ChunkCoord])
-		{
-			const int OriginalBlock = Chunk->VoxelData[(LocalZ * ChunkSize * ChunkSize) + (LocalY * ChunkSize) + LocalX];
-			Chunk->VoxelData[(LocalZ * ChunkSize * ChunkSize) + (LocalY * ChunkSize) + LocalX] = BlockToPlace;
- 
-			// Optionally trigger mesh regeneration here
-			Chunk->TryGenerateChunkMesh();
- 
-            // if block is on a block border, regenerate the adjacent chunk to that block
-            if (LocalX == 0) 
-            {
-                if (AVoxelChunk* AdjacentChunk = Chunks[FIntVector(ChunkX - 1, ChunkY, ChunkZ)])
-                {
-                    AdjacentChunk->TryGenerateChunkMesh();
-                }
-            }
-            else if (LocalX == ChunkSize - 1)
-            {
-                if (AVoxelChunk* AdjacentChunk = Chunks[FIntVector(ChunkX + 1, ChunkY, ChunkZ)])
-                {
-                    AdjacentChunk->TryGenerateChunkMesh();
-                }
-            }
- 
-            if (LocalY == 0)
+    const FIntVector ChunkCoord = GetChunkCoord(Coord, ChunkSize);
+
+    AVoxelChunk* const* Chunk = Chunks.Find(ChunkCoord);
+    if (!Chunk || !*Chunk || !(*Chunk)->bHasData)
+    {
+        return false;
+    }
+
+    const bool bImplicitBatch = EditBatchDepth == 0;
+    if (bImplicitBatch) BeginEditBatch();
+
+    WriteVoxel(*Chunk, ChunkCoord, GetLocalCoord(Coord, ChunkSize), VoxelID, OutOriginal);
+
+    if (bImplicitBatch) CommitEditBatch();
+    return true;
+}
+
+int32 AVoxelWorld::SetVoxels(TConstArrayView<FVoxelEdit> Edits)
+{
+    if (Edits.Num() == 0) return 0;
+
+    const bool bImplicitBatch = EditBatchDepth == 0;
+    if (bImplicitBatch) BeginEditBatch();
+
+    const int ChunkSize = VoxelWorldConfig->ChunkSize;
+
+    // Edits are usually spatially coherent, so remember the last chunk instead of probing the map per voxel
+    FIntVector CachedCoord(MAX_int32);
+    AVoxelChunk* CachedChunk = nullptr;
+    int32 AppliedCount = 0;
+    int32 SkippedCount = 0;
+
+    for (const FVoxelEdit& Edit : Edits)
+    {
+        const FIntVector ChunkCoord = GetChunkCoord(Edit.Coord, ChunkSize);
+        if (ChunkCoord != CachedCoord)
+        {
+            CachedCoord = ChunkCoord;
+            AVoxelChunk* const* Found = Chunks.Find(ChunkCoord);
+            CachedChunk = Found && *Found && (*Found)->bHasData ? *Found : nullptr;
+        }
+
+        if (!CachedChunk)
+        {
+            SkippedCount++;
+            continue;
+        }
+
+        if (WriteVoxel(CachedChunk, ChunkCoord, GetLocalCoord(Edit.Coord, ChunkSize), Edit.VoxelID, nullptr))
+        {
+            AppliedCount++;
+        }
+    }
+
+    if (SkippedCount > 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("SetVoxels: %d edits skipped because their chunks are not loaded."), SkippedCount);
+    }
+
+    if (bImplicitBatch) CommitEditBatch();
+    return AppliedCount;
+}
+
+int32 AVoxelWorld::CommitEditBatch()
+{
+    if (EditBatchDepth == 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("CommitEditBatch called without a matching BeginEditBatch"));
+        return 0;
+    }
+
+    if (--EditBatchDepth > 0)
+    {
+        return 0;
+    }
+
+    if (LightEngine)
+    {
+        LightEngine->Flush();
+    }
+
+    if (NavGrid)
+    {
+        NavGrid->Flush();
+    }
+
+    // Exactly one remesh per touched chunk, including neighbours whose border faces changed
+    TSet<FChunkKey> ChunksToRemesh = MoveTemp(DirtyChunks);
+    DirtyChunks.Reset();
+
+    // Everything publishes before anything remeshes, so a remesh job never reads a neighbour from before the batch
+    TArray<AVoxelChunk*> Touched;
+    for (const FChunkKey& Coord : ChunksToRemesh)
+    {
+        AVoxelChunk* const* Chunk = Chunks.Find(Coord);
+        if (!Chunk || !*Chunk || !(*Chunk)->bHasData) continue;
+
+        (*Chunk)->PublishData();
+        Touched.Add(*Chunk);
+    }
+
+    int32 RemeshedCount = 0;
+    for (AVoxelChunk* Chunk : Touched)
+    {
+        if (Chunk->bGenerateMesh)
+        {
+            Chunk->RequestMesh();
+            RemeshedCount++;
+        }
+    }
+
+    if (EditedVoxels.Num() > 0)
+    {
+        // Listeners may start another batch
+        const TArray<FIntVector> Edited = MoveTemp(EditedVoxels);
+        EditedVoxels.Reset();
+        OnVoxelsEdited.Broadcast(Edited);
+    }
+    return RemeshedCount;
+}
+
+bool AVoxelWorld::WriteVoxel(AVoxelChunk* Chunk, const FIntVector& ChunkCoord, const FIntVector& LocalCoord, const uint16 VoxelID, uint16* OutOriginal)
+{
+    const int ChunkSize = VoxelWorldConfig->ChunkSize;
+    uint16& Voxel = Chunk->VoxelData[(LocalCoord.Z * ChunkSize * ChunkSize) + (LocalCoord.Y * ChunkSize) + LocalCoord.X];
+
+    if (OutOriginal)
+    {
+        *OutOriginal = Voxel;
+    }
+
+    if (Voxel == VoxelID)
+    {
+        return false;
+    }
+    const uint16 OldVoxelID = Voxel;
+    Voxel = VoxelID;
+    Chunk->MarkDataChanged();
+
+    if (LightEngine)
+    {
+        LightEngine->QueueVoxelChange(ChunkCoord * ChunkSize + LocalCoord, OldVoxelID, VoxelID);
+    }
+
+    if (NavGrid)
+    {
+        NavGrid->QueueVoxelChange(ChunkCoord * ChunkSize + LocalCoord, VoxelID);
+    }
+
+    EditedVoxels.Add(ChunkCoord * ChunkSize + LocalCoord);
+
+    MarkVoxelAndBordersDirty(ChunkCoord, LocalCoord);
+    return true;
+}
+
+int32 AVoxelWorld::ApplyPlacedStructures(const FIntVector& ChunkCoord, const uint32 AfterVersion)
+{
+    AVoxelChunk* const* Found = Chunks.Find(ChunkCoord);
+    AVoxelChunk* Chunk = Found && *Found && (*Found)->bHasData ? *Found : nullptr;
+    if (!Chunk) return 0;
+
+    // Stamp a copy and write back only what differs, so lighting, navigation and remeshing see ordinary edits
+    const int ChunkSize = VoxelWorldConfig->ChunkSize;
+    TArray<uint16> Stamped = Chunk->VoxelData;
+    if (GetWorldGenerationSubsystem()->StampStructures(ChunkCoord, ChunkSize, Stamped, nullptr, AfterVersion) == 0)
+    {
+        return 0;
+    }
+
+    const bool bImplicitBatch = EditBatchDepth == 0;
+    if (bImplicitBatch) BeginEditBatch();
+
+    int32 AppliedCount = 0;
+    for (int32 Index = 0; Index < Stamped.Num(); ++Index)
+    {
+        if (Stamped[Index] == Chunk->VoxelData[Index]) continue;
+
+        const FIntVector LocalCoord(Index % ChunkSize, (Index / ChunkSize) % ChunkSize, Index / (ChunkSize * ChunkSize));
+        if (WriteVoxel(Chunk, ChunkCoord, LocalCoord, Stamped[Index], nullptr))
+        {
+            AppliedCount++;
+        }
+    }
+
+    if (bImplicitBatch) CommitEditBatch();
+    return AppliedCount;
+}
+
+void AVoxelWorld::OnStructurePlaced(const FIntVector& MinChunk, const FIntVector& MaxChunk, const uint32 Version)
+{
+    // Chunks generated from now on stamp the structure themselves. Those still generating catch up when their data
+    // is applied, so only chunks that already have data are patched here.
+    BeginEditBatch();
+
+    int32 AppliedCount = 0;
+    for (int32 Z = MinChunk.Z; Z <= MaxChunk.Z; ++Z)
+    {
+        for (int32 Y = MinChunk.Y; Y <= MaxChunk.Y; ++Y)
+        {
+            for (int32 X = MinChunk.X; X <= MaxChunk.X; ++X)
             {
-                if (AVoxelChunk* AdjacentChunk = Chunks[FIntVector(ChunkX, ChunkY - 1, ChunkZ)])
-                {
-                    AdjacentChunk->TryGenerateChunkMesh();
-                }
+                AppliedCount += ApplyPlacedStructures(FIntVector(X, Y, Z), Version - 1);
             }
-            else if (LocalY == ChunkSize - 1)
+        }
+    }
+
+    const int32 RemeshedCount = CommitEditBatch();
+    UE_LOG(LogTemp, Log, TEXT("Structure placed: %d voxels written to loaded chunks, %d chunks remeshed."), AppliedCount, RemeshedCount);
+}
+
+void AVoxelWorld::MarkVoxelAndBordersDirty(const FIntVector& ChunkCoord, const FIntVector& LocalCoord)
+{
+    const int ChunkSize = VoxelWorldConfig->ChunkSize;
+
+    MarkVoxelDirty(ChunkCoord, LocalCoord);
+
+    // if block is on a block border, the adjacent chunk's faces need regenerating too
+    if (LocalCoord.X == 0) MarkVoxelDirty(ChunkCoord - FIntVector(1, 0, 0), FIntVector(ChunkSize - 1, LocalCoord.Y, LocalCoord.Z));
+    else if (LocalCoord.X == ChunkSize - 1) MarkVoxelDirty(ChunkCoord + FIntVector(1, 0, 0), FIntVector(0, LocalCoord.Y, LocalCoord.Z));
+
+    if (LocalCoord.Y == 0) MarkVoxelDirty(ChunkCoord - FIntVector(0, 1, 0), FIntVector(LocalCoord.X, ChunkSize - 1, LocalCoord.Z));
+    else if (LocalCoord.Y == ChunkSize - 1) MarkVoxelDirty(ChunkCoord + FIntVector(0, 1, 0), FIntVector(LocalCoord.X, 0, LocalCoord.Z));
+
+    if (LocalCoord.Z == 0) MarkVoxelDirty(ChunkCoord - FIntVector(0, 0, 1), FIntVector(LocalCoord.X, LocalCoord.Y, ChunkSize - 1));
+    else if (LocalCoord.Z == ChunkSize - 1) MarkVoxelDirty(ChunkCoord + FIntVector(0, 0, 1), FIntVector(LocalCoord.X, LocalCoord.Y, 0));
+}
+
+void AVoxelWorld::OnLightChanged(const TArray<FIntVector>& Voxels)
+{
+    const int ChunkSize = VoxelWorldConfig->ChunkSize;
+
+    // A voxel's light shows on the faces of its neighbours, which the border marking already covers
+    BeginEditBatch();
+    for (const FIntVector& Voxel : Voxels)
+    {
+        MarkVoxelAndBordersDirty(GetChunkCoord(Voxel, ChunkSize), GetLocalCoord(Voxel, ChunkSize));
+    }
+    CommitEditBatch();
+}
+
+void AVoxelWorld::MarkVoxelDirty(const FIntVector& ChunkCoord, const FIntVector& LocalCoord)
+{
+    if (AVoxelChunk* const* Chunk = Chunks.Find(ChunkCoord); Chunk && *Chunk)
+    {
+        (*Chunk)->MarkVoxelDirty(LocalCoord);
+        DirtyChunks.Add(ChunkCoord);
+    }
+}
+
+int32 AVoxelWorld::FillBox(const FIntVector& Min, const FIntVector& Max, const uint16 VoxelID)
+{
+    BeginEditBatch();
+
+    int32 AppliedCount = 0;
+    TArray<FVoxelEdit> Edits;
+    for (int Z = Min.Z; Z <= Max.Z; Z++)
+    {
+        // Submit one Z slice at a time to keep the edit buffer small for large boxes
+        Edits.Reset();
+        for (int Y = Min.Y; Y <= Max.Y; Y++)
+        {
+            for (int X = Min.X; X <= Max.X; X++)
             {
-                if (AVoxelChunk* AdjacentChunk = Chunks[FIntVector(ChunkX, ChunkY + 1, ChunkZ)])
-                {
-                    AdjacentChunk->TryGenerateChunkMesh();
-                }
+                Edits.Emplace(FIntVector(X, Y, Z), VoxelID);
             }
- 
-            if (LocalZ == 0)
+        }
+        AppliedCount += SetVoxels(Edits);
+    }
+
+    CommitEditBatch();
+    return AppliedCount;
+}
+
+int32 AVoxelWorld::ReplaceInBox(const FIntVector& Min, const FIntVector& Max, const uint16 FromVoxelID, const uint16 ToVoxelID)
+{
+    BeginEditBatch();
+
+    int32 AppliedCount = 0;
+    TArray<FVoxelEdit> Edits;
+    for (int Z = Min.Z; Z <= Max.Z; Z++)
+    {
+        Edits.Reset();
+        for (int Y = Min.Y; Y <= Max.Y; Y++)
+        {
+            for (int X = Min.X; X <= Max.X; X++)
             {
-                if (AVoxelChunk* AdjacentChunk = Chunks[FIntVector(ChunkX, ChunkY, ChunkZ - 1)])
+                if (GetVoxelAtWorldCoordinates(X, Y, Z) == FromVoxelID)
                 {
-                    AdjacentChunk->TryGenerateChunkMesh();
+                    Edits.Emplace(FIntVector(X, Y, Z), ToVoxelID);
                 }
             }
-            else if (LocalZ == ChunkSize - 1)
+        }
+        AppliedCount += SetVoxels(Edits);
+    }
+
+    CommitEditBatch();
+    return AppliedCount;
+}
+
+int32 AVoxelWorld::FillSphere(const FIntVector& Center, const int32 Radius, const uint16 VoxelID)
+{
+    if (Radius < 0) return 0;
+
+    const int32 RadiusSq = Radius * Radius;
+    TArray<FVoxelEdit> Edits;
+
+    for (int Z = -Radius; Z <= Radius; Z++)
+    {
+        for (int Y = -Radius; Y <= Radius; Y++)
+        {
+            for (int X = -Radius; X <= Radius; X++)
             {
-                if (AVoxelChunk* AdjacentChunk = Chunks[FIntVector(ChunkX, ChunkY, ChunkZ + 1)])
+                if (X * X + Y * Y + Z * Z <= RadiusSq)
                 {
-                    AdjacentChunk->TryGenerateChunkMesh();
+                    Edits.Emplace(Center + FIntVector(X, Y, Z), VoxelID);
                 }
             }
-            return OriginalBlock;
-		}
-	}
-	else
-	{
-		UE_LOG(LogTemp, Warning, TEXT("Chunk (%d, %d) not found for voxel placement at (%d, %d, %d)!"), ChunkX, ChunkY, X, Y, Z);
-	}
-    return GetVoxelRegistry()->GetIDFromName("Air");
+        }
+    }
+
+    return SetVoxels(Edits);
 }
 
 void AVoxelWorld::UpdateTriggerVolume(FVector PlayerPosition) const
@@ -340,29 +721,88 @@ void AVoxelWorld::UpdateTriggerVolume(FVector PlayerPosition) const
 int16 AVoxelWorld::GetVoxelAtWorldCoordinates(int X, int Y, int Z)
 {
     const int ChunkSize = VoxelWorldConfig->ChunkSize;
+    const FIntVector Coord(X, Y, Z);
+    const FIntVector ChunkCoord = GetChunkCoord(Coord, ChunkSize);
+    const FIntVector Local = GetLocalCoord(Coord, ChunkSize);
+    const int32 Index = (Local.Z * ChunkSize * ChunkSize) + (Local.Y * ChunkSize) + Local.X;
 
-    const int ChunkX = FMath::FloorToInt(static_cast<float>(X) / ChunkSize);
-    const int ChunkY = FMath::FloorToInt(static_cast<float>(Y) / ChunkSize);
-    const int ChunkZ = FMath::FloorToInt(static_cast<float>(Z) / ChunkSize);
+    // Edits only reach the store when their batch commits
+    if (IsInGameThread())
+    {
+        AVoxelChunk* const* Chunk = Chunks.Find(ChunkCoord);
+        if (Chunk && *Chunk && (*Chunk)->VoxelData.IsValidIndex(Index))
+        {
+            return (*Chunk)->VoxelData[Index];
+        }
+    }
+    else if (const TSharedPtr<FVoxelChunkRecord> Record = ChunkStore.Find(ChunkCoord))
+    {
+        const TSharedPtr<const FVoxelChunkData> Data = Record->Data->Get();
+        if (Data && Data->VoxelData.IsValidIndex(Index))
+        {
+            return Data->VoxelData[Index];
+        }
+    }
+
+    return GetVoxelRegistry()->GetIDFromName(FName("Air")); // Air
+}
 
-    const int LocalX = (X % ChunkSize + ChunkSize) % ChunkSize;
-    const int LocalY = (Y % ChunkSize + ChunkSize) % ChunkSize;
-    const int LocalZ = (Z % ChunkSize + ChunkSize) % ChunkSize;
+uint8 AVoxelWorld::GetLightAtWorldCoordinates(int X, int Y, int Z) const
+{
+    const int ChunkSize = VoxelWorldConfig->ChunkSize;
+    const FIntVector Coord(X, Y, Z);
+    const FIntVector ChunkCoord = GetChunkCoord(Coord, ChunkSize);
+    const FIntVector Local = GetLocalCoord(Coord, ChunkSize);
+    const int32 Index = (Local.Z * ChunkSize * ChunkSize) + (Local.Y * ChunkSize) + Local.X;
 
-    ChunksLock.ReadLock(); 
-    TWeakObjectPtr<AVoxelChunk> Chunk;
-    if (Chunks.Contains(FIntVector(ChunkX, ChunkY, ChunkZ)))
+    if (IsInGameThread())
     {
-        Chunk = Chunks[FIntVector(ChunkX, ChunkY, ChunkZ)];
+        AVoxelChunk* const* Chunk = Chunks.Find(ChunkCoord);
+        if (Chunk && *Chunk && (*Chunk)->bHasData && (*Chunk)->LightData.Num() == (*Chunk)->VoxelData.Num())
+        {
+            return (*Chunk)->LightData[Index];
+        }
     }
-    ChunksLock.ReadUnlock();
-
-    if (Chunk.IsValid() && Chunk->IsVoxelInChunk(LocalX, LocalY, LocalZ))
+    else if (const TSharedPtr<FVoxelChunkRecord> Record = ChunkStore.Find(ChunkCoord))
     {
-        return Chunk->VoxelData[(LocalZ * ChunkSize * ChunkSize) + (LocalY * ChunkSize) + LocalX];
+        const TSharedPtr<const FVoxelChunkData> Data = Record->Data->Get();
+        if (Data && Data->LightData.IsValidIndex(Index))
+        {
+            return Data->LightData[Index];
+        }
     }
 
-    return GetVoxelRegistry()->GetIDFromName(FName("Air")); // Air
+    return VoxelLight::UnloadedLight;
+}
+
+AVoxelChunk* AVoxelWorld::FindChunk(const FIntVector& ChunkCoord) const
+{
+    check(IsInGameThread());
+    AVoxelChunk* const* Chunk = Chunks.Find(ChunkCoord);
+    return Chunk ? *Chunk : nullptr;
+}
+
+void AVoxelWorld::RemoveChunk(const FIntVector& ChunkCoord)
+{
+    Chunks.Remove(ChunkCoord);
+    ChunkStore.Remove(ChunkCoord);
+}
+
+FIntVector AVoxelWorld::GetChunkCoord(const FIntVector& VoxelCoord, const int32 ChunkSize)
+{
+    // Integer floor division, valid for negative coordinates
+    return FIntVector(
+        (VoxelCoord.X >= 0 ? VoxelCoord.X : VoxelCoord.X - ChunkSize + 1) / ChunkSize,
+        (VoxelCoord.Y >= 0 ? VoxelCoord.Y : VoxelCoord.Y - ChunkSize + 1) / ChunkSize,
+        (VoxelCoord.Z >= 0 ? VoxelCoord.Z : VoxelCoord.Z - ChunkSize + 1) / ChunkSize);
+}
+
+FIntVector AVoxelWorld::GetLocalCoord(const FIntVector& VoxelCoord, const int32 ChunkSize)
+{
+    return FIntVector(
+        (VoxelCoord.X % ChunkSize + ChunkSize) % ChunkSize,
+        (VoxelCoord.Y % ChunkSize + ChunkSize) % ChunkSize,
+        (VoxelCoord.Z % ChunkSize + ChunkSize) % ChunkSize);
 }
 
 UVoxelRegistrySubsystem* AVoxelWorld::GetVoxelRegistry() const
@@ -379,3 +819,114 @@ UWorldGenerationConfig* AVoxelWorld::GetWorldGenerationConfig() const
 {
     return VoxelWorldConfig;
 }
+
+void AVoxelWorld::RecordChunkLifecycle(const FIntVector& ChunkCoord, const FChunkLifecycle& Lifecycle)
+{
+    ++StreamingCounters.ChunksStreamed;
+
+    if (Lifecycles.Num() < ChunkLifecycleHistorySize)
+    {
+        LifecycleCoords.Add(ChunkCoord);
+        Lifecycles.Add(Lifecycle);
+        return;
+    }
+    LifecycleCoords[LifecycleCursor] = ChunkCoord;
+    Lifecycles[LifecycleCursor] = Lifecycle;
+    LifecycleCursor = (LifecycleCursor + 1) % ChunkLifecycleHistorySize;
+}
+
+void AVoxelWorld::LogChunkLatency() const
+{
+    if (Lifecycles.Num() == 0)
+    {
+        UE_LOG(LogTemp, Log, TEXT("ChunkLatency: no chunks displayed yet"));
+        return;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("ChunkLatency: %d chunks"), Lifecycles.Num());
+    for (int32 Stage = 0; Stage < ChunkLifecycle::NumStages; ++Stage)
+    {
+        TArray<double> Samples;
+        Samples.Reserve(Lifecycles.Num());
+        for (const FChunkLifecycle& Lifecycle : Lifecycles)
+        {
+            Samples.Add(ChunkLifecycle::GetStageMs(Lifecycle, Stage));
+        }
+        Samples.Sort();
+
+        auto Percentile = [&Samples](const double P)
+        {
+            return Samples[FMath::Clamp(FMath::CeilToInt32(P * Samples.Num()) - 1, 0, Samples.Num() - 1)];
+        };
+        UE_LOG(LogTemp, Log, TEXT("ChunkLatency: %-10s p50 %8.2f ms, p95 %8.2f ms, p99 %8.2f ms, max %8.2f ms"),
+            ChunkLifecycle::GetStageName(Stage), Percentile(0.5), Percentile(0.95), Percentile(0.99), Samples.Last());
+    }
+}
+
+bool AVoxelWorld::ExportChunkLatencyCsv(const FString& Path) const
+{
+    FString Csv = TEXT("x,y,z");
+    for (int32 Stage = 0; Stage < ChunkLifecycle::NumStages; ++Stage)
+    {
+        Csv += FString::Printf(TEXT(",%s_ms"), ChunkLifecycle::GetStageName(Stage));
+    }
+    Csv += TEXT("\n");
+
+    for (int32 Index = 0; Index < Lifecycles.Num(); ++Index)
+    {
+        const FIntVector& Coord = LifecycleCoords[Index];
+        Csv += FString::Printf(TEXT("%d,%d,%d"), Coord.X, Coord.Y, Coord.Z);
+        for (int32 Stage = 0; Stage < ChunkLifecycle::NumStages; ++Stage)
+        {
+            Csv += FString::Printf(TEXT(",%.3f"), ChunkLifecycle::GetStageMs(Lifecycles[Index], Stage));
+        }
+        Csv += TEXT("\n");
+    }
+    return FFileHelper::SaveStringToFile(Csv, *Path);
+}
+
+void AVoxelWorld::ResetChunkLatency()
+{
+    LifecycleCoords.Reset();
+    Lifecycles.Reset();
+    LifecycleCursor = 0;
+}
+
+void AVoxelWorld::LogChunkMemory(const int32 TopN) const
+{
+    constexpr double BytesPerMB = 1024.0 * 1024.0;
+
+    TArray<TPair<FIntVector, FVoxelChunkMemory>> PerChunk;
+    PerChunk.Reserve(Chunks.Num());
+    for (const TPair<FChunkKey, AVoxelChunk*>& Pair : Chunks)
+    {
+        if (Pair.Value)
+        {
+            PerChunk.Emplace(Pair.Key.ToCoords(), Pair.Value->GetMemoryUsage());
+        }
+    }
+
+    FVoxelChunkMemory Total;
+    for (const TPair<FIntVector, FVoxelChunkMemory>& Entry : PerChunk)
+    {
+        Total.VoxelData += Entry.Value.VoxelData;
+        Total.LightData += Entry.Value.LightData;
+        Total.ProcMesh += Entry.Value.ProcMesh;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("ChunkMemory: %d chunks, %.2f MB total"), PerChunk.Num(), Total.GetTotal() / BytesPerMB);
+    UE_LOG(LogTemp, Log, TEXT("ChunkMemory: voxels %.2f MB, light %.2f MB, mesh components %.2f MB"),
+        Total.VoxelData / BytesPerMB, Total.LightData / BytesPerMB, Total.ProcMesh / BytesPerMB);
+
+    PerChunk.Sort([](const TPair<FIntVector, FVoxelChunkMemory>& A, const TPair<FIntVector, FVoxelChunkMemory>& B)
+    {
+        return A.Value.GetTotal() > B.Value.GetTotal();
+    });
+    for (int32 Index = 0; Index < FMath::Min(TopN, PerChunk.Num()); ++Index)
+    {
+        const FIntVector& Coord = PerChunk[Index].Key;
+        const FVoxelChunkMemory& Memory = PerChunk[Index].Value;
+        UE_LOG(LogTemp, Log, TEXT("ChunkMemory: %2d. (%d, %d, %d) %.1f KB: voxels+light %.1f KB, meshes %.1f KB"),
+            Index + 1, Coord.X, Coord.Y, Coord.Z, Memory.GetTotal() / 1024.0, Memory.GetVoxelTotal() / 1024.0, Memory.GetMeshTotal() / 1024.0);
+    }
+}
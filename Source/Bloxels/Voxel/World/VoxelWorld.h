@@ -4,16 +4,31 @@
 
 #include "CoreMinimal.h"
 #include "FastNoiseWrapper.h"
+#include "VoxelChunkStore.h"
 #include "WorldGenerationSubsystem.h"
+#include "Bloxels/Voxel/Chunk/ChunkLifecycle.h"
+#include "Bloxels/Voxel/Core/ChunkKey.h"
+#include "Bloxels/Voxel/Core/VoxelEdit.h"
 #include "Bloxels/Voxel/VoxelRegistry/VoxelRegistrySubsystem.h"
 #include "Engine/TriggerVolume.h"
 #include "GameFramework/Actor.h"
 #include "VoxelWorld.generated.h"
 
 class AVoxelChunk;
+class FVoxelJobScheduler;
+class FVoxelLightEngine;
+class FVoxelNavGrid;
 struct FBiomeProperties;
 class UWorldGenerationConfig;
 
+struct FVoxelStreamingCounters
+{
+    int32 ChunksStreamed = 0;           // Chunks displayed for the first time
+    double ChunkCallbackSeconds = 0.0;  // Game thread time applying generated chunk data and meshes
+};
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnVoxelsEdited, const TArray<FIntVector>& /* Voxels */);
+
 UCLASS()
 class BLOXELS_API AVoxelWorld : public AActor
 {
@@ -23,6 +38,8 @@ public:
     AVoxelWorld();
 
     virtual void BeginPlay() override;
+    virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+    virtual void Tick(float DeltaTime) override;
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Voxel|Config")
     UWorldGenerationConfig* VoxelWorldConfig;
@@ -36,22 +53,80 @@ public:
     UFUNCTION(BlueprintCallable, Category = "Voxel|Player")
     int PlaceBlock(int X, int Y, int Z, int BlockToPlace);
 
+    // Bulk Editing
+    // Edits made between Begin/Commit write straight into chunk storage; each touched chunk is remeshed once on commit.
+    void BeginEditBatch();
+    int32 SetVoxels(TConstArrayView<FVoxelEdit> Edits);
+    bool SetVoxel(const FIntVector& Coord, uint16 VoxelID, uint16* OutOriginal = nullptr);
+    int32 CommitEditBatch();
+    bool IsEditBatchOpen() const { return EditBatchDepth > 0; }
+
+    // Brushes (inclusive bounds, world voxel coordinates)
+    int32 FillBox(const FIntVector& Min, const FIntVector& Max, uint16 VoxelID);
+    int32 ReplaceInBox(const FIntVector& Min, const FIntVector& Max, uint16 FromVoxelID, uint16 ToVoxelID);
+    int32 FillSphere(const FIntVector& Center, int32 Radius, uint16 VoxelID);
+
     
+    // Game thread only; other threads look chunks up through FindChunkRecord
     UPROPERTY()
-    TMap<FIntVector, AVoxelChunk*> Chunks;
+    TMap<FChunkKey, AVoxelChunk*> Chunks;
 
     UPROPERTY()
-    TMap<FIntVector, AVoxelChunk*> ActiveChunks;
+    TMap<FChunkKey, AVoxelChunk*> ActiveChunks;
 
     
-    mutable FRWLock ChunksLock;
     mutable FRWLock ActiveChunksLock;
     
+    // On the game thread these read the live chunk; elsewhere the data last published to the chunk store
     int16 GetVoxelAtWorldCoordinates(int X, int Y, int Z);
+    uint8 GetLightAtWorldCoordinates(int X, int Y, int Z) const;
+    // Game thread only. Other threads use FindChunkRecord and read its published data.
+    AVoxelChunk* FindChunk(const FIntVector& ChunkCoord) const;
+    TSharedPtr<FVoxelChunkRecord> FindChunkRecord(const FIntVector& ChunkCoord) const { return ChunkStore.Find(ChunkCoord); }
+    // Forgets an unloaded chunk; readers holding its record keep its data
+    void RemoveChunk(const FIntVector& ChunkCoord);
     UVoxelRegistrySubsystem* GetVoxelRegistry() const;
     UWorldGenerationSubsystem* GetWorldGenerationSubsystem() const;
     UWorldGenerationConfig* GetWorldGenerationConfig() const;
     void TryCreateNewChunk(int32 ChunkX, int32 ChunkY, int32 ChunkZ, bool bShouldGenMesh);
+    // Writes the cells of structures placed after AfterVersion over a chunk that already has data, as ordinary edits.
+    // Older placements are left alone, so what players dug out of them stays dug out. Returns voxels changed.
+    int32 ApplyPlacedStructures(const FIntVector& ChunkCoord, uint32 AfterVersion);
+
+    // Lighting
+    TSharedPtr<FVoxelLightEngine> GetLightEngine() const { return LightEngine; }
+    // Called on the game thread with every voxel whose light changed; remeshes only the sections showing them
+    void OnLightChanged(const TArray<FIntVector>& Voxels);
+
+    // Navigation
+    TSharedPtr<FVoxelNavGrid> GetNavGrid() const { return NavGrid; }
+
+    // Generation and meshing jobs
+    TSharedPtr<FVoxelJobScheduler> GetJobScheduler() const { return JobScheduler; }
+    // Remeshes the chunk once the meshing lane has room again
+    void DeferRemesh(const FIntVector& ChunkCoord) { DeferredRemeshes.Add(ChunkCoord); }
+
+    // Streaming telemetry. Chunks report their lifecycle the first time they are displayed; the newest
+    // ChunkLifecycleHistorySize are kept.
+    void RecordChunkLifecycle(const FIntVector& ChunkCoord, const FChunkLifecycle& Lifecycle);
+    // Logs p50/p95/p99 per ChunkLifecycle stage
+    void LogChunkLatency() const;
+    // One row per recorded chunk with its stage times in milliseconds
+    bool ExportChunkLatencyCsv(const FString& Path) const;
+    void ResetChunkLatency();
+
+    // Logs memory held by all chunks by category, then the TopN heaviest chunks
+    void LogChunkMemory(int32 TopN) const;
+
+    const FVoxelStreamingCounters& GetStreamingCounters() const { return StreamingCounters; }
+    void AddChunkCallbackTime(const double Seconds) { StreamingCounters.ChunkCallbackSeconds += Seconds; }
+
+    // Broadcast on the game thread once per committed batch with every voxel that changed, after lighting and
+    // navigation have been updated for it
+    FOnVoxelsEdited OnVoxelsEdited;
+
+    static FIntVector GetChunkCoord(const FIntVector& VoxelCoord, int32 ChunkSize);
+    static FIntVector GetLocalCoord(const FIntVector& VoxelCoord, int32 ChunkSize);
 
 private:
     UPROPERTY()
@@ -66,11 +141,44 @@ private:
 
     UFUNCTION()
     void OnChunkExit(AActor* OverlappedActor, AActor* OtherActor);
+
+    void OnStructurePlaced(const FIntVector& MinChunk, const FIntVector& MaxChunk, uint32 Version);
+    FDelegateHandle StructurePlacedHandle;
     
     FIntVector CurrentChunk = FIntVector(0, 0, 0);
     FIntVector PreviousChunk = FIntVector(0, 0, 0);
     bool bIsShuttingDown = false;
 
+    int32 EditBatchDepth = 0;
+    TSet<FChunkKey> DirtyChunks;
+    TArray<FIntVector> EditedVoxels;
+
+    TSharedPtr<FVoxelLightEngine> LightEngine;
+    TSharedPtr<FVoxelNavGrid> NavGrid;
+    TSharedPtr<FVoxelJobScheduler> JobScheduler;
+
+    FVoxelChunkStore ChunkStore;
+
+    // Chunks in view still to be spawned, held back while the job queue is full
+    TSet<FChunkKey> PendingChunkRequests;
+    void SpawnPendingChunks();
+
+    // Chunks whose remesh waits for room in the meshing lane
+    TSet<FChunkKey> DeferredRemeshes;
+    void SpawnDeferredRemeshes();
+
+    // Lifecycle history
+    static constexpr int32 ChunkLifecycleHistorySize = 4096;
+    TArray<FIntVector> LifecycleCoords;
+    TArray<FChunkLifecycle> Lifecycles;
+    int32 LifecycleCursor = 0;
+
+    FVoxelStreamingCounters StreamingCounters;
+
+    void MarkVoxelDirty(const FIntVector& ChunkCoord, const FIntVector& LocalCoord);
+    void MarkVoxelAndBordersDirty(const FIntVector& ChunkCoord, const FIntVector& LocalCoord);
+    bool WriteVoxel(AVoxelChunk* Chunk, const FIntVector& ChunkCoord, const FIntVector& LocalCoord, uint16 VoxelID, uint16* OutOriginal);
+
     void InitializeTriggerVolume();
     void DelayedGenerateWorld();
     void GenerateInitialWorld();
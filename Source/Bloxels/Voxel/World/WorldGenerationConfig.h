@@ -18,6 +18,19 @@ public:
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Voxel|World")
     int32 ChunkSize = 16;
 
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Voxel|World",
+        meta = (ToolTip = "Edge length of the cubic mesh sections a chunk is split into. Edits only remesh the sections they touch. Must divide ChunkSize, otherwise the whole chunk is one section"))
+    int32 MeshSectionSize = 16;
+
+    // Job scheduling
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Voxel|Jobs",
+        meta = (ToolTip = "Generation and meshing jobs allowed to run at once. 0 uses half the task graph's worker threads"))
+    int32 MaxVoxelJobsInFlight = 0;
+
+    UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Voxel|Jobs",
+        meta = (ToolTip = "Once this many jobs are waiting, the world stops adding chunks until the queue drains. 0 for no limit"))
+    int32 MaxQueuedVoxelJobs = 64;
+
     UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Voxel|World",
         meta = (ToolTip = "The minimum Z coordinate for surface generation in blocks"))
     int32 SurfaceMinHeight = 0;
@@ -42,4 +55,19 @@ public:
 
     UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Voxel|Biome|Noise Settings")
     FNoiseInfo Underground;
+
+    // Terrain is generated this many chunks high at most; everything above is air
+    static constexpr int32 GenerationHeightInChunks = 20;
+    int32 GetGenerationHeight() const { return ChunkSize * GenerationHeightInChunks; }
+
+    // Copy whose noise seeds are Seed, Seed + 1, ... so the asset itself stays untouched
+    UWorldGenerationConfig* CopyWithSeed(const int32 Seed, UObject* Outer) const
+    {
+        UWorldGenerationConfig* Copy = DuplicateObject<UWorldGenerationConfig>(this, Outer);
+        Copy->Temperature.NoiseSeed = Seed;
+        Copy->Habitability.NoiseSeed = Seed + 1;
+        Copy->Elevation.NoiseSeed = Seed + 2;
+        Copy->Underground.NoiseSeed = Seed + 3;
+        return Copy;
+    }
 };
\ No newline at end of file
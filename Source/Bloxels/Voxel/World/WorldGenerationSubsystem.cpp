@@ -3,6 +3,10 @@
 
 #include "WorldGenerationSubsystem.h"
 
+#include "VoxelWorld.h"
+#include "Bloxels/Voxel/Core/VoxelData.h"
+#include "Bloxels/Voxel/VoxelRegistry/VoxelRegistrySubsystem.h"
+
 void UWorldGenerationSubsystem::InitializeConfig(UWorldGenerationConfig* InConfig)
 {
     Config = InConfig;
@@ -13,6 +17,13 @@ void UWorldGenerationSubsystem::InitializeConfig(UWorldGenerationConfig* InConfi
         return;
     }
 
+    // Placements belong to the previous world; parsed files stay cached
+    {
+        FWriteScopeLock WriteLock(StructureLock);
+        StructurePlacements.Reset();
+        PlacementsByColumn.Reset();
+    }
+
     InitNoiseGenerators();
 }
 
@@ -89,13 +100,24 @@ FName UWorldGenerationSubsystem::GetVoxelAtPosition(int X, int Y, int Z) const
     if (!Config) return TEXT("Air");
 
     // Always return air for anything above generation height
-    if (Z > Config->ChunkSize * 20) return TEXT("Air");
+    if (Z > Config->GetGenerationHeight()) return TEXT("Air");
     if (Z < 0) return TEXT("Stone");
 
     const EBiome Biome = GetBiome(X, Y);
     const int TerrainHeight = GetTerrainHeight(X, Y, Biome);
     const FBiomeProperties* BiomeData = GetBiomeData(Biome);
 
+    return GetVoxelInColumn(X, Y, Z, TerrainHeight, BiomeData);
+}
+
+FName UWorldGenerationSubsystem::GetVoxelInColumn(int X, int Y, int Z, const int TerrainHeight, const FBiomeProperties* BiomeData) const
+{
+    if (!Config) return TEXT("Air");
+
+    // Always return air for anything above generation height
+    if (Z > Config->GetGenerationHeight()) return TEXT("Air");
+    if (Z < 0) return TEXT("Stone");
+
     if (Z > TerrainHeight)
     {
         return TEXT("Air");
@@ -149,6 +171,173 @@ const FBiomeProperties* UWorldGenerationSubsystem::GetBiomeData(const EBiome Bio
     return nullptr;
 }
 
+void UWorldGenerationSubsystem::LoadStructureAt(const FString& FileName, const FIntVector& OriginWorldCoords)
+{
+    if (!Config)
+    {
+        UE_LOG(LogTemp, Error, TEXT("LoadStructureAt: Config is null!"));
+        return;
+    }
+
+    const TSharedPtr<const FLoadedStructure> Loaded = FindOrLoadStructure(FileName);
+    if (!Loaded) return;
+
+    const int32 ChunkSize = Config->ChunkSize;
+    const FIntVector WorldMin = OriginWorldCoords + Loaded->Structure.Min;
+    const FIntVector MinChunk = AVoxelWorld::GetChunkCoord(WorldMin, ChunkSize);
+    const FIntVector MaxChunk = AVoxelWorld::GetChunkCoord(WorldMin + Loaded->Structure.Size - FIntVector(1, 1, 1), ChunkSize);
+
+    uint32 Version;
+    {
+        FWriteScopeLock WriteLock(StructureLock);
+        Version = ++StructureVersion;
+        const int32 PlacementIndex = StructurePlacements.Add({ Loaded.ToSharedRef(), WorldMin, Version });
+        for (int32 Y = MinChunk.Y; Y <= MaxChunk.Y; ++Y)
+        {
+            for (int32 X = MinChunk.X; X <= MaxChunk.X; ++X)
+            {
+                PlacementsByColumn.FindOrAdd(FIntPoint(X, Y)).Add(PlacementIndex);
+            }
+        }
+    }
+
+    const FIntVector ChunkCount = MaxChunk - MinChunk + FIntVector(1, 1, 1);
+    UE_LOG(LogTemp, Log, TEXT("LoadStructureAt: %s placed at %s across %d chunks"),
+        *FileName, *OriginWorldCoords.ToString(), ChunkCount.X * ChunkCount.Y * ChunkCount.Z);
+
+    OnStructurePlaced.Broadcast(MinChunk, MaxChunk, Version);
+}
+
+int32 UWorldGenerationSubsystem::StampStructures(const FIntVector& ChunkCoords, const int32 ChunkSize, TArray<uint16>& VoxelData,
+    TArray<int32>* InOutSkyStart, const uint32 AfterVersion) const
+{
+    FReadScopeLock ReadLock(StructureLock);
+
+    const TArray<int32>* Placements = PlacementsByColumn.Find(FIntPoint(ChunkCoords.X, ChunkCoords.Y));
+    if (!Placements) return 0;
+
+    const FIntVector ChunkMin = ChunkCoords * ChunkSize;
+    int32 WrittenCount = 0;
+
+    for (const int32 PlacementIndex : *Placements)
+    {
+        const FStructurePlacement& Placement = StructurePlacements[PlacementIndex];
+        if (Placement.Version <= AfterVersion) continue;
+
+        const FVoxelStructure& Structure = Placement.Loaded->Structure;
+        const TArray<uint16>& PaletteToVoxel = Placement.Loaded->PaletteToVoxel;
+
+        // Structure grid origin in chunk-local coordinates, and the part of the grid over this chunk's columns
+        const FIntVector Offset = Placement.WorldMin - ChunkMin;
+        const FIntVector Begin(FMath::Max(Offset.X, 0), FMath::Max(Offset.Y, 0), FMath::Max(Offset.Z, 0));
+        const FIntVector End(
+            FMath::Min(Offset.X + Structure.Size.X, ChunkSize),
+            FMath::Min(Offset.Y + Structure.Size.Y, ChunkSize),
+            FMath::Min(Offset.Z + Structure.Size.Z, ChunkSize));
+
+        // A roof in a chunk above still shades this one, so sky start looks at the whole placement
+        if (InOutSkyStart)
+        {
+            for (int32 Y = Begin.Y; Y < End.Y; ++Y)
+            {
+                for (int32 X = Begin.X; X < End.X; ++X)
+                {
+                    if (const int32 Top = Placement.Loaded->OpaqueTops[((Y - Offset.Y) * Structure.Size.X) + (X - Offset.X)]; Top > 0)
+                    {
+                        int32& SkyStart = (*InOutSkyStart)[(Y * ChunkSize) + X];
+                        SkyStart = FMath::Max(SkyStart, Placement.WorldMin.Z + Top);
+                    }
+                }
+            }
+        }
+
+        for (int32 Z = Begin.Z; Z < End.Z; ++Z)
+        {
+            for (int32 Y = Begin.Y; Y < End.Y; ++Y)
+            {
+                for (int32 X = Begin.X; X < End.X; ++X)
+                {
+                    const uint16 Cell = Structure.Cells[Structure.GetIndex(X - Offset.X, Y - Offset.Y, Z - Offset.Z)];
+                    if (Cell == 0 || !PaletteToVoxel.IsValidIndex(Cell)) continue;
+
+                    VoxelData[(Z * ChunkSize * ChunkSize) + (Y * ChunkSize) + X] = PaletteToVoxel[Cell];
+                    WrittenCount++;
+                }
+            }
+        }
+    }
+
+    return WrittenCount;
+}
+
+uint32 UWorldGenerationSubsystem::GetStructureVersion() const
+{
+    FReadScopeLock ReadLock(StructureLock);
+    return StructureVersion;
+}
+
+TSharedPtr<const UWorldGenerationSubsystem::FLoadedStructure> UWorldGenerationSubsystem::FindOrLoadStructure(const FString& FileName)
+{
+    if (const TSharedRef<const FLoadedStructure>* Cached = StructureCache.Find(FileName))
+    {
+        return *Cached;
+    }
+
+    const UVoxelRegistrySubsystem* Registry = GetGameInstance()->GetSubsystem<UVoxelRegistrySubsystem>();
+    if (!Registry || Registry->GetVoxelCount() == 0)
+    {
+        UE_LOG(LogTemp, Error, TEXT("LoadStructureAt: VoxelRegistry not ready"));
+        return nullptr;
+    }
+
+    const FString FullPath = FPaths::ProjectSavedDir() + FileName + ".blxl";
+    const TSharedRef<FLoadedStructure> Loaded = MakeShared<FLoadedStructure>();
+    FVoxelStructure& Structure = Loaded->Structure;
+    if (!VoxelStructureFile::Load(FullPath, Structure))
+    {
+        UE_LOG(LogTemp, Error, TEXT("LoadStructureAt: Failed to load %s"), *FullPath);
+        return nullptr;
+    }
+
+    if (Structure.IsEmpty())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("LoadStructureAt: %s has no voxels"), *FullPath);
+        return nullptr;
+    }
+
+    // Forced air carves out whatever the terrain put there
+    TArray<bool> PaletteOpaque;
+    Loaded->PaletteToVoxel.SetNumZeroed(Structure.Palette.Num());
+    PaletteOpaque.SetNumZeroed(Structure.Palette.Num());
+    for (int32 i = 1; i < Structure.Palette.Num(); ++i)
+    {
+        const FName Name = Structure.Palette[i] == TEXT("AirForced") ? FName(TEXT("Air")) : Structure.Palette[i];
+        Loaded->PaletteToVoxel[i] = Registry->GetIDFromName(Name);
+        const UVoxelData* Voxel = Registry->GetVoxelByID(Loaded->PaletteToVoxel[i]);
+        PaletteOpaque[i] = Voxel && !Voxel->bIsTransparent && !Voxel->bIsInvisible;
+    }
+
+    Loaded->OpaqueTops.SetNumZeroed(Structure.Size.X * Structure.Size.Y);
+    for (int32 Y = 0; Y < Structure.Size.Y; ++Y)
+    {
+        for (int32 X = 0; X < Structure.Size.X; ++X)
+        {
+            for (int32 Z = Structure.Size.Z - 1; Z >= 0; --Z)
+            {
+                const uint16 Cell = Structure.Cells[Structure.GetIndex(X, Y, Z)];
+                if (PaletteOpaque.IsValidIndex(Cell) && PaletteOpaque[Cell])
+                {
+                    Loaded->OpaqueTops[(Y * Structure.Size.X) + X] = Z + 1;
+                    break;
+                }
+            }
+        }
+    }
+
+    StructureCache.Add(FileName, Loaded);
+    return Loaded;
+}
+
 void UWorldGenerationSubsystem::InitNoiseGenerators()
 {
     if (!Config) return;
@@ -5,8 +5,11 @@
 #include "Subsystems/GameInstanceSubsystem.h"
 #include "WorldGenerationConfig.h"
 #include "Biome/BiomeProperties.h"
+#include "Bloxels/Voxel/Structure/VoxelStructureFile.h"
 #include "WorldGenerationSubsystem.generated.h"
 
+DECLARE_MULTICAST_DELEGATE_ThreeParams(FOnStructurePlaced, const FIntVector& /* MinChunk */, const FIntVector& /* MaxChunk */, uint32 /* Version */);
+
 UCLASS()
 class BLOXELS_API UWorldGenerationSubsystem : public UGameInstanceSubsystem
 {
@@ -14,14 +17,31 @@ class BLOXELS_API UWorldGenerationSubsystem : public UGameInstanceSubsystem
 
 public:
     void InitializeConfig(UWorldGenerationConfig* InConfig);
+    const UWorldGenerationConfig* GetConfig() const { return Config; }
 
     EBiome GetBiome(int X, int Y) const;
     int GetTerrainHeight(int X, int Y, EBiome Biome) const;
     FName GetVoxelTypeForPosition(int Z, int TerrainHeight, const FBiomeProperties* BiomeData) const;
     FName GetVoxelAtPosition(int X, int Y, int Z) const;
+    // GetVoxelAtPosition with the column's biome and height already worked out
+    FName GetVoxelInColumn(int X, int Y, int Z, int TerrainHeight, const FBiomeProperties* BiomeData) const;
     const FBiomeProperties* GetBiomeData(EBiome Biome) const;
+
+    // Structures
+    // Places Saved/FileName.blxl with its origin at OriginWorldCoords. Each file is parsed and resolved against the
+    // voxel registry once, then cached. Chunks generated afterwards stamp the part of it inside their bounds; chunks
+    // that already have data are left to OnStructurePlaced listeners.
     void LoadStructureAt(const FString& FileName, const FIntVector& OriginWorldCoords);
+    // Any thread. Writes the cells of placements newer than AfterVersion that fall inside the chunk into VoxelData,
+    // later placements winning. InOutSkyStart is raised to the top of every such placement's opaque cells over each
+    // column, including cells in the chunks above. Returns the number of voxels written.
+    int32 StampStructures(const FIntVector& ChunkCoords, int32 ChunkSize, TArray<uint16>& VoxelData,
+        TArray<int32>* InOutSkyStart = nullptr, uint32 AfterVersion = 0) const;
+    // Any thread. Version of the newest placement, so a chunk can stamp only what landed after it was generated.
+    uint32 GetStructureVersion() const;
 
+    // Broadcast on the game thread after a placement, with the range of chunks it overlaps and its version
+    FOnStructurePlaced OnStructurePlaced;
 
 private:
     UPROPERTY()
@@ -46,4 +66,30 @@ private:
     UFastNoiseWrapper* WarpNoise;
 
     void InitNoiseGenerators();
+
+    // A structure file with its palette resolved to voxel IDs
+    struct FLoadedStructure
+    {
+        FVoxelStructure Structure;
+        TArray<uint16> PaletteToVoxel;
+        TArray<int32> OpaqueTops;  // Per grid column (X fastest): one past the highest opaque cell, 0 when there is none
+    };
+
+    struct FStructurePlacement
+    {
+        TSharedRef<const FLoadedStructure> Loaded;
+        FIntVector WorldMin;  // Placement origin plus Structure.Min
+        uint32 Version;
+    };
+
+    // Loaded files by name; game thread only
+    TMap<FString, TSharedRef<const FLoadedStructure>> StructureCache;
+
+    // Placements are read by generation workers
+    mutable FRWLock StructureLock;
+    TArray<FStructurePlacement> StructurePlacements;
+    TMap<FIntPoint, TArray<int32>> PlacementsByColumn;  // Chunk X/Y to indices into StructurePlacements, in placement order
+    uint32 StructureVersion = 0;
+
+    TSharedPtr<const FLoadedStructure> FindOrLoadStructure(const FString& FileName);
 };
\ No newline at end of file